@@ -1,5 +1,6 @@
 // Allocator
 // Handles typed memory allocation for 1D and 2D arrays.
+// Each viewer allocates from its own arena of heap chunks which are returned to the heap when the arena is reset.
 
 /*
 This file is part of LifeViewer
@@ -124,22 +125,293 @@ This file is part of LifeViewer
 
 		// wasm top of memory pointer
 		/** @type {number} */ this.wasmMemTop = 0;
+
+		// maximum size of the wasm heap in bytes (must match MAXIMUM_MEMORY in wasm/Makefile)
+		/** @type {number} */ this.wasmMaxBytes = 1792 * 1024 * 1024;
+
+		// number of times the wasm heap has grown
+		/** @type {number} */ this.numGrows = 0;
+
+		// number of times the allocations at the top of the heap have been freed
+		/** @type {number} */ this.numTopResets = 0;
+
+		// objects whose wasm typed views are rebased when the heap grows
+		/** @type {Array} */ this.owners = [];
+
+		// most recently created pattern (its typed views are also rebased)
+		/** @type {Object} */ this.transientOwner = null;
+
+		// wasm matrices by name (latest and previous) since they may only be referenced by local variables
+		/** @type {Object} */ this.wasmMatrices = {};
+
+		// wasm buffer that views were last created on or rebased to
+		/** @type {ArrayBuffer} */ this.wasmBuffer = null;
+
+		// heap this arena takes its chunks from (null if this is the heap)
+		/** @type {Allocator} */ this.heap = null;
+
+		// arena name
+		/** @type {string} */ this.arenaName = "Heap";
+
+		// arena chunks for bottom and top allocations (start offset and size in bytes)
+		/** @type {Array<Array<number>>} */ this.chunks = [];
+		/** @type {Array<Array<number>>} */ this.topChunks = [];
+
+		// end of the current bottom chunk
+		/** @type {number} */ this.chunkEnd = 0;
+
+		// allocation pointer and end of the current top chunk
+		/** @type {number} */ this.topPointer = 0;
+		/** @type {number} */ this.topEnd = 0;
+
+		// minimum arena chunk size in bytes
+		/** @const {number} */ this.arenaChunkBytes = 1024 * 1024;
+
+		// arenas created from this heap
+		/** @type {Array<Allocator>} */ this.arenas = [];
+
+		// free heap blocks sorted by offset (start offset and size in bytes)
+		/** @type {Array<Array<number>>} */ this.freeBlocks = [];
+
+		// number of chunks taken from free blocks rather than the top of the heap
+		/** @type {number} */ this.numReused = 0;
 	}
 
+	// create an arena that allocates wasm memory in chunks from this heap
+	/** @returns {Allocator} */
+	Allocator.prototype.createArena = function(/** @type {string} */ name) {
+		var	/** @type {Allocator} */ result = new Allocator();
+
+		result.heap = this;
+		result.arenaName = name;
+		result.wasmPointer = 0;
+		this.arenas[this.arenas.length] = result;
+
+		return result;
+	};
+
+	// release an arena created from this heap returning all of its chunks to the free list
+	Allocator.prototype.releaseArena = function(/** @type {Allocator} */ arena) {
+		var	/** @type {number} */ i = this.arenas.indexOf(arena);
+
+		// ignore arenas that are not from this heap or were already released
+		if (i === -1) {
+			return;
+		}
+
+		// return the bottom and top chunks
+		for (i = 0; i < arena.chunks.length; i += 1) {
+			this.releaseBlock(arena.chunks[i][0], arena.chunks[i][1]);
+		}
+		for (i = 0; i < arena.topChunks.length; i += 1) {
+			this.releaseBlock(arena.topChunks[i][0], arena.topChunks[i][1]);
+		}
+		arena.chunks = [];
+		arena.topChunks = [];
+		arena.wasmPointer = 0;
+		arena.chunkEnd = 0;
+		arena.topPointer = 0;
+		arena.topEnd = 0;
+
+		// forget the owners and matrices so they are no longer rebased
+		arena.owners = [];
+		arena.transientOwner = null;
+		arena.wasmMatrices = {};
+		arena.allocations = [];
+
+		// remove the arena from the heap
+		this.arenas.splice(this.arenas.indexOf(arena), 1);
+	};
+
+	// take a block from the free list or the top of the heap
+	// returns the offset or -1 if the heap could not grow
+	/** @returns {number} */
+	Allocator.prototype.takeBlock = function(/** @type {number} */ size) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ result = -1,
+			/** @type {Array<number>} */ block = null;
+
+		// use the first free block that fits
+		while (i < this.freeBlocks.length && result === -1) {
+			block = this.freeBlocks[i];
+			if (block[1] >= size) {
+				result = block[0];
+				if (block[1] === size) {
+					this.freeBlocks.splice(i, 1);
+				} else {
+					block[0] += size;
+					block[1] -= size;
+				}
+				this.numReused += 1;
+			} else {
+				i += 1;
+			}
+		}
+
+		// otherwise take it from the heap pointer
+		if (result === -1) {
+			if (this.wasmPointer + size + 16 > this.heapTop()) {
+				if (!this.growHeap(this.wasmPointer + size + 16 - this.heapTop())) {
+					return -1;
+				}
+			}
+			result = this.wasmPointer;
+			this.wasmPointer += size;
+		}
+
+		return result;
+	};
+
+	// return a block to the free list merging it with its neighbours
+	Allocator.prototype.releaseBlock = function(/** @type {number} */ start, /** @type {number} */ size) {
+		var	/** @type {number} */ i = 0,
+			/** @type {Array<Array<number>>} */ blocks = this.freeBlocks,
+			/** @type {Array<number>} */ block = null;
+
+		// find the insertion point
+		while (i < blocks.length && blocks[i][0] < start) {
+			i += 1;
+		}
+
+		// merge with the previous block or insert
+		if (i > 0 && blocks[i - 1][0] + blocks[i - 1][1] === start) {
+			i -= 1;
+			block = blocks[i];
+			block[1] += size;
+		} else {
+			block = [start, size];
+			blocks.splice(i, 0, block);
+		}
+
+		// merge with the next block
+		if (i + 1 < blocks.length && block[0] + block[1] === blocks[i + 1][0]) {
+			block[1] += blocks[i + 1][1];
+			blocks.splice(i + 1, 1);
+		}
+
+		// give the block back to the heap pointer if it is the last one
+		if (block[0] + block[1] === this.wasmPointer) {
+			this.wasmPointer = block[0];
+			blocks.splice(i, 1);
+		}
+	};
+
+	// make sure the current arena chunk has room for the given number of bytes
+	// returns the offset for the allocation or -1 if the heap could not grow
+	/** @returns {number} */
+	Allocator.prototype.arenaPlace = function(/** @type {number} */ size, /** @type {boolean} */ atTop) {
+		var	/** @type {number} */ aligned = (size + 15) & ~15,
+			/** @type {number} */ chunkSize = aligned > this.heap.arenaChunkBytes ? aligned : this.heap.arenaChunkBytes,
+			/** @type {number} */ start = 0;
+
+		if (atTop) {
+			// top allocations come from their own chunks so resizes can free them all
+			if (this.topPointer + aligned > this.topEnd) {
+				start = this.heap.takeBlock(chunkSize);
+				if (start === -1) {
+					return -1;
+				}
+				this.topChunks[this.topChunks.length] = [start, chunkSize];
+				this.topPointer = start;
+				this.topEnd = start + chunkSize;
+			}
+			start = this.topPointer;
+		} else {
+			if (this.wasmPointer + aligned > this.chunkEnd) {
+				start = this.heap.takeBlock(chunkSize);
+				if (start === -1) {
+					return -1;
+				}
+				this.chunks[this.chunks.length] = [start, chunkSize];
+				this.wasmPointer = start;
+				this.chunkEnd = start + chunkSize;
+			}
+			start = this.wasmPointer;
+		}
+
+		return start;
+	};
+
+	// free the arena chunks allocated after the one containing the pointer and move the arena pointer to it
+	Allocator.prototype.rewindArena = function(/** @type {number} */ pointer) {
+		var	/** @type {number} */ i = this.chunks.length - 1,
+			/** @type {Array<number>} */ chunk = null;
+
+		while (i >= 0 && !(pointer >= this.chunks[i][0] && pointer <= this.chunks[i][0] + this.chunks[i][1])) {
+			chunk = this.chunks[i];
+			this.heap.releaseBlock(chunk[0], chunk[1]);
+			i -= 1;
+		}
+		this.chunks.length = i + 1;
+
+		if (i >= 0) {
+			this.wasmPointer = pointer;
+			this.chunkEnd = this.chunks[i][0] + this.chunks[i][1];
+		} else {
+			this.wasmPointer = 0;
+			this.chunkEnd = 0;
+		}
+	};
+
+	// output the arena chunk usage as a string
+	/** @returns {string} */
+	Allocator.prototype.arenaInfo = function() {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ reserved = 0,
+			/** @type {number} */ used = 0,
+			/** @type {number} */ free = 0;
+
+		if (this.heap === null) {
+			// the heap reports its free blocks and the number of arenas sharing it
+			for (i = 0; i < this.freeBlocks.length; i += 1) {
+				free += this.freeBlocks[i][1];
+			}
+			return this.arenaName + "\t" + this.arenas.length + " arenas\t" + this.freeBlocks.length + " free\t" + free + "\t" + this.numReused + " reused";
+		}
+
+		for (i = 0; i < this.chunks.length; i += 1) {
+			reserved += this.chunks[i][1];
+		}
+		for (i = 0; i < this.topChunks.length; i += 1) {
+			reserved += this.topChunks[i][1];
+		}
+		used = reserved - (this.chunkEnd - this.wasmPointer) - (this.topEnd - this.topPointer);
+
+		return this.arenaName + "\t" + (this.chunks.length + this.topChunks.length) + " chunks\t" + reserved + "\t" + used + " used";
+	};
+
 	// reset the allocator
 	Allocator.prototype.reset = function(/** @type {number} */ pointer) {
 		//console.log("Allocator reset to " + pointer);
-		this.wasmPointer = pointer;
+		if (this.heap !== null) {
+			this.rewindArena(pointer);
+		} else {
+			this.wasmPointer = pointer;
+		}
 		this.allocations = [];
 		this.numAllocs = 0;
 		this.numFrees = 0;
 		this.totalBytes = 0;
 		this.totalFreedBytes = 0;
+		this.wasmMatrices = {};
 	};
 
 	// reset the top of memory pointer
 	Allocator.prototype.resetTop = function() {
-		this.wasmMemTop = WASM.memory.buffer.byteLength;
+		var	/** @type {number} */ i = 0;
+
+		this.numTopResets += 1;
+		if (this.heap !== null) {
+			// return the arena top chunks to the heap
+			for (i = 0; i < this.topChunks.length; i += 1) {
+				this.heap.releaseBlock(this.topChunks[i][0], this.topChunks[i][1]);
+			}
+			this.topChunks = [];
+			this.topPointer = 0;
+			this.topEnd = 0;
+		} else {
+			this.wasmMemTop = WASM.memory.buffer.byteLength;
+		}
 	};
 
 	// output a specific allocation as a string
@@ -300,8 +572,27 @@ This file is part of LifeViewer
 			/** @type {number} */ size = elements * Type.sizeInBytes(type),
 			/** @type {number} */ where = (this.wasmPointer >>> 0);
 
+		// check the memory has not been detached without the views being rebased
+		if (wasmHeap && !this.checkBuffer(name)) {
+			return null;
+		}
+
+		// arenas allocate from their own chunks
+		if (wasmHeap && this.heap !== null) {
+			where = this.arenaPlace(size, atTop);
+			if (where === -1) {
+				alert(ViewConstants.externalViewerTitle + " is out of memory\n\nFailed to allocate " + elements + " element " + Type.typeName(type) + " array for " + name);
+				return null;
+			}
+			where = (where >>> 0);
+		} else if (wasmHeap && this.wasmPointer + size + 16 > this.heapTop()) {
+			// grow the wasm heap if the allocation does not fit between the heap pointer and the top of memory
+			this.growHeap(this.wasmPointer + size + 16 - this.heapTop());
+			where = (this.wasmPointer >>> 0);
+		}
+
 		// check if allocation at top of heap required
-		if (atTop) {
+		if (atTop && this.heap === null) {
 			// allocate from top of memory 16 byte aligned
 			where = ((this.wasmMemTop - size) & ~15) >>> 0;
 
@@ -403,18 +694,41 @@ This file is part of LifeViewer
 		}
 
 		// if the allocation succeeded for the WASM heap then update the heap pointer
-		if (result !== null && wasmHeap && !atTop) {
+		if (result !== null && wasmHeap) {
 			// check size is a multiple of 16
 			if ((size & 0x0f) !== 0) {
 				size = (size & 0xfffffff0) + 16;
 			}
-			this.wasmPointer += size;
+			if (!atTop) {
+				this.wasmPointer += size;
+			} else {
+				if (this.heap !== null) {
+					this.topPointer += size;
+				}
+			}
 		}
 
 		// return memory
 		return result;
 	};
 
+	// check the wasm buffer that views were created on has not been detached by growth outside growHeap
+	/** @returns {boolean} */
+	Allocator.prototype.checkBuffer = function(/** @type {string} */ name) {
+		var	/** @type {Allocator} */ root = (this.heap !== null ? this.heap : this);
+
+		if (root.wasmBuffer === null) {
+			root.wasmBuffer = WASM.memory.buffer;
+		} else {
+			if (root.wasmBuffer.byteLength === 0) {
+				alert(ViewConstants.externalViewerTitle + " WASM memory was detached without rebasing\n\nFailed to allocate " + name);
+				return false;
+			}
+		}
+
+		return true;
+	};
+
 	// allocate typed memory
 	/** @returns {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array|null} */
 	Allocator.prototype.allocate = function(/** @type {number} */ type, /** @type {number} */ elements, /** @type {string} */ name, /** @type {boolean} */ wasmHeap) {
@@ -464,25 +778,337 @@ This file is part of LifeViewer
 		return result;
 	};
 
-	// return available heap in bytes
+	// return available heap in bytes (including space the heap can still grow into)
 	/** @returns {number} */
 	Allocator.prototype.availableHeap = function() {
-		return this.wasmMemTop - this.wasmPointer;
+		var	/** @type {number} */ result = 0,
+			/** @type {number} */ i = 0;
+
+		// arenas can use the rest of their current chunk and anything the heap has left
+		if (this.heap !== null) {
+			return this.chunkEnd - this.wasmPointer + this.heap.availableHeap();
+		}
+
+		result = this.heapTop() - this.wasmPointer;
+		for (i = 0; i < this.freeBlocks.length; i += 1) {
+			result += this.freeBlocks[i][1];
+		}
+
+		if (WASM.memory !== null) {
+			result += this.wasmMaxBytes - WASM.memory.buffer.byteLength;
+		}
+
+		return result;
+	};
+
+	// return the number of bytes of the wasm heap in use (excluding free blocks)
+	/** @returns {number} */
+	Allocator.prototype.usedHeap = function() {
+		var	/** @type {number} */ result = 0,
+			/** @type {number} */ i = 0;
+
+		if (this.heap !== null) {
+			return this.heap.usedHeap();
+		}
+
+		result = this.wasmPointer + WASM.memory.buffer.byteLength - this.heapTop();
+		for (i = 0; i < this.freeBlocks.length; i += 1) {
+			result -= this.freeBlocks[i][1];
+		}
+
+		return result;
+	};
+
+	// return the top of the free wasm heap
+	/** @returns {number} */
+	Allocator.prototype.heapTop = function() {
+		var	/** @type {number} */ result = this.wasmMemTop;
+
+		// if nothing has been allocated at the top yet then use the end of memory
+		if (result === 0 && WASM.memory !== null) {
+			result = WASM.memory.buffer.byteLength;
+		}
+
+		return result;
+	};
+
+	// register an object whose wasm typed views must be rebased when the heap grows
+	Allocator.prototype.registerOwner = function(/** @type {Object} */ owner) {
+		this.owners[this.owners.length] = owner;
+	};
+
+	// stop rebasing the wasm typed views of an object that is being discarded
+	Allocator.prototype.unregisterOwner = function(/** @type {Object} */ owner) {
+		var	/** @type {number} */ i = this.owners.indexOf(owner);
+
+		if (i !== -1) {
+			this.owners.splice(i, 1);
+		}
+		if (this.transientOwner === owner) {
+			this.transientOwner = null;
+		}
+	};
+
+	// remember a wasm matrix so it can be rebased even if only a local variable references it
+	Allocator.prototype.trackMatrix = function(/** @type {Array} */ mat, /** @type {string} */ name) {
+		var	/** @type {Array} */ entry = this.wasmMatrices[name];
+
+		if (entry === undefined) {
+			this.wasmMatrices[name] = [null, mat];
+		} else {
+			entry[0] = entry[1];
+			entry[1] = mat;
+		}
+	};
+
+	// ensure the given number of bytes can be allocated without growing the heap
+	// (call before allocating several blocks that are only held in local variables)
+	Allocator.prototype.reserveHeap = function(/** @type {number} */ bytes) {
+		var	/** @type {number} */ free = 0;
+
+		// arenas make sure the current chunk is big enough
+		if (this.heap !== null) {
+			this.arenaPlace(bytes, false);
+			return;
+		}
+
+		free = this.heapTop() - this.wasmPointer;
+		if (bytes > free) {
+			this.growHeap(bytes - free);
+		}
+	};
+
+	// add a matrix and the layout of its rows to the list to rebase if it lives on the given buffer
+	Allocator.prototype.addMatrix = function(/** @type {Array} */ matrices, /** @type {Array} */ mat, /** @type {ArrayBuffer} */ buffer) {
+		var	/** @type {Array} */ layouts = [],
+			/** @type {number} */ i = 0;
+
+		if (mat !== null && mat.whole && mat.whole.buffer === buffer) {
+			for (i = 0; i < matrices.length; i += 1) {
+				if (matrices[i][0] === mat) {
+					return;
+				}
+			}
+
+			// rows added later may be on the JS heap
+			for (i = 0; i < mat.length; i += 1) {
+				layouts[i] = (mat[i].buffer === buffer) ? this.viewLayout(mat[i]) : null;
+			}
+			matrices[matrices.length] = [mat, this.viewLayout(mat.whole), layouts];
+		}
+	};
+
+	// find the typed views, ImageData and matrices of an object that live on the given buffer
+	Allocator.prototype.collectViews = function(/** @type {Object} */ owner, /** @type {ArrayBuffer} */ buffer, /** @type {Array} */ views, /** @type {Array} */ matrices) {
+		var	/** @type {string} */ key = "";
+
+		for (key in owner) {
+			if (owner.hasOwnProperty(key)) {
+				this.collectValue(owner, key, buffer, views, matrices, 0);
+			}
+		}
+	};
+
+	// add a field of an owner to the views or matrices that live on the given buffer
+	// (arrays and plain objects are searched a few levels deep so nested views are rebased too)
+	Allocator.prototype.collectValue = function(/** @type {Object} */ container, /** @type {string|number} */ key, /** @type {ArrayBuffer} */ buffer, /** @type {Array} */ views, /** @type {Array} */ matrices, /** @type {number} */ depth) {
+		var	/** @type {number} */ i = 0,
+			/** @type {string} */ field = "",
+			value = container[key];
+
+		if (value === null || typeof value !== "object") {
+			return;
+		}
+
+		if (ArrayBuffer.isView(value)) {
+			if (value.buffer === buffer) {
+				views[views.length] = [container, key, this.viewLayout(value)];
+			}
+		} else if (value instanceof ImageData) {
+			if (value.data.buffer === buffer) {
+				views[views.length] = [container, key, this.viewLayout(value.data)];
+			}
+		} else if (Array.isArray(value)) {
+			if (value.whole) {
+				this.addMatrix(matrices, value, buffer);
+			} else {
+				if (depth < 3) {
+					for (i = 0; i < value.length; i += 1) {
+						this.collectValue(value, i, buffer, views, matrices, depth + 1);
+					}
+				}
+			}
+		} else if (depth < 3 && Object.getPrototypeOf(value) === Object.prototype) {
+			for (field in value) {
+				if (value.hasOwnProperty(field)) {
+					this.collectValue(value, field, buffer, views, matrices, depth + 1);
+				}
+			}
+		}
+	};
+
+	// record the type, offset and length of a view since they are lost when the buffer is detached
+	/** @returns {Array} */
+	Allocator.prototype.viewLayout = function(view) {
+		return [view.constructor, view.byteOffset, view.length];
+	};
+
+	// create a view of the grown buffer from the layout of a view of the old buffer
+	/** @returns {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array} */
+	Allocator.prototype.rebaseView = function(/** @type {Array} */ layout, /** @type {ArrayBuffer} */ buffer, /** @type {number} */ top, /** @type {number} */ delta) {
+		var	/** @type {Function} */ viewType = layout[0],
+			/** @type {number} */ offset = layout[1];
+
+		// blocks allocated at the top of memory move up with the top of memory
+		if (offset >= top) {
+			offset += delta;
+		}
+
+		return new viewType(buffer, offset, layout[2]);
+	};
+
+	// find the views of the registered owners and matrices of an arena that live on the given buffer
+	Allocator.prototype.collectArenaViews = function(/** @type {Allocator} */ arena, /** @type {ArrayBuffer} */ buffer, /** @type {Array} */ views, /** @type {Array} */ matrices) {
+		var	/** @type {number} */ i = 0,
+			/** @type {string} */ name = "",
+			/** @type {Array} */ entry = null;
+
+		for (i = 0; i < arena.owners.length; i += 1) {
+			this.collectViews(arena.owners[i], buffer, views, matrices);
+		}
+		if (arena.transientOwner !== null) {
+			this.collectViews(arena.transientOwner, buffer, views, matrices);
+		}
+		for (name in arena.wasmMatrices) {
+			if (arena.wasmMatrices.hasOwnProperty(name)) {
+				entry = arena.wasmMatrices[name];
+				this.addMatrix(matrices, entry[0], buffer);
+				this.addMatrix(matrices, entry[1], buffer);
+			}
+		}
+	};
+
+	// grow the wasm heap by at least the given number of bytes and rebase registered views
+	/** @returns {boolean} */
+	Allocator.prototype.growHeap = function(/** @type {number} */ bytes) {
+		var	/** @type {ArrayBuffer} */ oldBuffer = null,
+			/** @type {ArrayBuffer} */ newBuffer = null,
+			/** @type {number} */ oldLength = 0,
+			/** @type {number} */ newLength = 0,
+			/** @type {number} */ top = 0,
+			/** @type {number} */ delta = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {Array} */ views = [],
+			/** @type {Array} */ matrices = [],
+			/** @type {Array} */ entry = null,
+			/** @type {Array} */ mat = null,
+			/** @type {Array} */ layouts = null,
+			/** @type {AllocationInfo} */ info = null,
+			value = null;
+
+		// arenas grow the heap they belong to
+		if (this.heap !== null) {
+			return this.heap.growHeap(bytes);
+		}
+
+		if (WASM.memory === null) {
+			return false;
+		}
+
+		oldBuffer = WASM.memory.buffer;
+		oldLength = oldBuffer.byteLength;
+		top = this.heapTop();
+
+		// at least double the heap (in 64Kb pages) up to the maximum
+		newLength = oldLength + ((bytes + 65535) & ~65535);
+		if (newLength < oldLength * 2) {
+			newLength = oldLength * 2;
+		}
+		if (newLength > this.wasmMaxBytes) {
+			newLength = this.wasmMaxBytes;
+		}
+		delta = newLength - oldLength;
+		if (delta < bytes) {
+			return false;
+		}
+
+		// find everything that views the old buffer before it is detached (in this heap and all of its arenas)
+		this.collectArenaViews(this, oldBuffer, views, matrices);
+		for (i = 0; i < this.arenas.length; i += 1) {
+			this.collectArenaViews(this.arenas[i], oldBuffer, views, matrices);
+		}
+
+		// grow the memory
+		try {
+			WASM.memory.grow(delta >> 16);
+		} catch(e) {
+			return false;
+		}
+		newBuffer = WASM.memory.buffer;
+		this.wasmBuffer = newBuffer;
+		this.numGrows += 1;
+
+		// move the blocks allocated at the top of memory to the new top
+		if (top < oldLength) {
+			new Uint8Array(newBuffer).copyWithin(top + delta, top, oldLength);
+		}
+		if (this.wasmMemTop !== 0) {
+			this.wasmMemTop += delta;
+		}
+		for (i = 0; i < this.allocations.length; i += 1) {
+			info = this.allocations[i];
+			if (info.name.charAt(0) === "^" && info.offset >= top) {
+				info.offset += delta;
+			}
+		}
+
+		// rebase typed views and ImageData
+		for (i = 0; i < views.length; i += 1) {
+			entry = views[i];
+			value = entry[0][entry[1]];
+			if (value instanceof ImageData) {
+				entry[0][entry[1]] = new ImageData(/** @type {!Uint8ClampedArray} */ (this.rebaseView(entry[2], newBuffer, top, delta)), value.width, value.height);
+			} else {
+				entry[0][entry[1]] = this.rebaseView(entry[2], newBuffer, top, delta);
+			}
+		}
+
+		// rebase matrices in place
+		for (i = 0; i < matrices.length; i += 1) {
+			entry = matrices[i];
+			mat = entry[0];
+			layouts = entry[2];
+			for (j = 0; j < layouts.length; j += 1) {
+				if (layouts[j] !== null) {
+					mat[j] = this.rebaseView(layouts[j], newBuffer, top, delta);
+				}
+			}
+			mat.whole = this.rebaseView(entry[1], newBuffer, top, delta);
+		}
+
+		return true;
 	};
 
 	// allocate typed memory when adding a row to a matrix
 	/** @returns {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array|null} */
-	Allocator.prototype.allocateRow = function(/** @type {number} */ type, /** @type {number} */ elements, /** @type {string} */ name, /** @type {number} */ rows) {
+	Allocator.prototype.allocateRow = function(/** @type {number} */ type, /** @type {number} */ elements, /** @type {string} */ name, /** @type {number} */ rows, /** @type {boolean} */ wasmHeap) {
 		var	/** @type {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array|null} */ result = null;
 
 		// get typed block of memory
 		if (elements > 0) {
-			result = this.typedMemory(type, elements, name, false, false);
+			result = this.typedMemory(type, elements, name, wasmHeap, false);
+
+			// rows of wasm matrices are on the wasm heap so clear them
+			if (result && wasmHeap) {
+				result.fill(0);
+				name = "* " + name;
+			}
 		}
 
 		// check if allocation succeeded
 		if (result || elements === 0) {
-			this.saveAllocationInfo(type, elements * rows, name, result.byteOffset);
+			this.saveAllocationInfo(type, elements * rows, name, result ? result.byteOffset : 0);
 		}
 
 		// return memory
@@ -497,7 +1123,11 @@ This file is part of LifeViewer
 
 	// set WASM heap pointer
 	Allocator.prototype.setHeapPointer = function(/** @type {number} */ value) {
-		this.wasmPointer = value;
+		if (this.heap !== null) {
+			this.rewindArena(value);
+		} else {
+			this.wasmPointer = value;
+		}
 	};
 
 	// create an array matrix for a given type
@@ -511,6 +1141,7 @@ This file is part of LifeViewer
 		mat.allocator = allocator;
 		mat.dataType = type;
 		mat.whole = null;
+		mat.wasmHeap = wasmHeap;
 
 		// create whole array
 		whole = allocator.allocate(type, m * n, name, wasmHeap);
@@ -518,6 +1149,11 @@ This file is part of LifeViewer
 		// save reference to the whole array
 		mat.whole = whole;
 
+		// track wasm matrices so they can be rebased if the heap grows
+		if (whole && wasmHeap) {
+			allocator.trackMatrix(mat, name);
+		}
+
 		// create rows if they are not empty and allocation succeeded
 		if (whole) {
 			if (n > 0) {
@@ -545,7 +1181,7 @@ This file is part of LifeViewer
 		var	/** @type {number} */ m = source[0].length,
 
 			// create the new row
-			/** @type {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array|null} */ row = source.allocator.allocateRow(source.dataType, m, name, source.length + 1);
+			/** @type {Uint8Array|Uint8ClampedArray|Uint16Array|Uint32Array|Int8Array|Int16Array|Int32Array|Float32Array|Float64Array|null} */ row = source.allocator.allocateRow(source.dataType, m, name, source.length + 1, source.wasmHeap === true);
 
 		// check whether to fill with an initial value
 		if (initial !== 0) {
@@ -580,6 +1216,11 @@ This file is part of LifeViewer
 		}
 		mat.whole = allocator.typedView(source.whole, type, source.whole.length / Type.sizeInBytes(type), 0, "");
 
+		// track wasm matrix views so they can be rebased if the heap grows
+		if (WASM.memory !== null && source.whole.buffer === WASM.memory.buffer) {
+			allocator.trackMatrix(mat, name);
+		}
+
 		// return typed view of matrix
 		return mat;
 	};
@@ -26,6 +26,7 @@ This file is part of LifeViewer
 	function HROT(/** @type {Allocator} */ allocator, /** @type {Life} */ engine, /** @type {PatternManager} */ manager) {
 		// allocator
 		/** @type {Allocator} */ this.allocator = allocator;
+		allocator.registerOwner(this);
 
 		// engine
 		/** @type {Life} */ this.engine = engine;
@@ -99,6 +99,9 @@ This file is part of LifeViewer
 		// maximum number of bits for rule tree/table lookup
 		/** @const {number} */ maxRuleTreeLookupBits : 27,
 
+		// number of bits for the RuleTree neighbourhood cache index
+		/** @const {number} */ ruleTreeCacheBits : 12,
+
 		// maximum number of bits for rule tree partial lookup
 		/** @const {number} */ maxRuleTreePartialLookupBits : 36,
 
@@ -475,6 +478,344 @@ This file is part of LifeViewer
 		this.endColour.set(fromRange.endColour);
 	};
 
+	// RuleLoaderLookupCache singleton
+	var RuleLoaderLookupCache = {
+		// IndexedDB database name
+		/** @const {string} */ dbName : "LifeViewerRuleLoaderLookup",
+
+		// IndexedDB database version
+		/** @const {number} */ dbVersion : 1,
+
+		// IndexedDB object store name
+		/** @const {string} */ storeName : "lookups",
+
+		// IndexedDB object store for lookup sizes and last used times
+		/** @const {string} */ usageStoreName : "usage",
+
+		// maximum bytes of lookups to keep in memory
+		/** @const {number} */ maxMemoryBytes : 256 << 20,
+
+		// maximum bytes of lookups to keep in persistent storage
+		/** @const {number} */ maxStoreBytes : 256 << 20,
+
+		// running 64 bit rule digest as two independent 32 bit lanes used as the key
+		/** @type {Uint32Array} */ digest : new Uint32Array(2),
+
+		// running content check (a third independent 32 bit hash and the number of values mixed) stored with each entry
+		/** @type {Uint32Array} */ check : new Uint32Array(2),
+
+		// open database (null if not yet open or unavailable)
+		/** @type {IDBDatabase} */ db : null,
+
+		// whether the database is unavailable
+		/** @type {boolean} */ dbFailed : false,
+
+		// callbacks waiting for the database to open
+		/** @type {Array} */ dbWaiting : [],
+
+		// lookups keyed by rule hash
+		/** @type {Object} */ entries : {},
+
+		// keys in least recently used order for eviction
+		/** @type {Array<string>} */ keys : [],
+
+		// bytes of lookups held in memory
+		/** @type {number} */ memoryBytes : 0
+	};
+
+	// mix a 32bit value into both lanes of the digest and into the content check
+	RuleLoaderLookupCache.mix = function(/** @type {number} */ value) {
+		var	/** @type {Uint32Array} */ digest = this.digest,
+			/** @type {Uint32Array} */ check = this.check,
+			/** @type {number} */ lo = Math.imul(digest[0] ^ value, 0x01000193),
+			/** @type {number} */ hi = Math.imul(digest[1] ^ value, 0x5bd1e995),
+			/** @type {number} */ c = Math.imul(value, 0xcc9e2d51);
+
+		digest[0] = lo ^ (lo >>> 15);
+		digest[1] = Math.imul(hi ^ (hi >>> 13), 0xc2b2ae35);
+
+		// murmur3 style block step so the check does not share a structure with the key lanes
+		c = Math.imul((c << 15) | (c >>> 17), 0x1b873593) ^ check[0];
+		check[0] = Math.imul((c << 13) | (c >>> 19), 5) + 0xe6546b64;
+		check[1] += 1;
+	};
+
+	// mix an array and its length into the digest
+	RuleLoaderLookupCache.mixArray = function(/** @type {Uint8Array|Uint32Array|Array<number>} */ values) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ l = values.length;
+
+		this.mix(l);
+		for (i = 0; i < l; i += 1) {
+			this.mix(values[i]);
+		}
+	};
+
+	// return a 32bit value as 8 hex digits
+	/** @returns {string} */
+	RuleLoaderLookupCache.hex = function(/** @type {number} */ value) {
+		return ("0000000" + (value >>> 0).toString(16)).slice(-8);
+	};
+
+	// compute the cache key for the engine's current RuleLoader rule and save the content check in the engine
+	/** @returns {string} */
+	RuleLoaderLookupCache.getKey = function(/** @type {Life} */ engine) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {Array} */ lut = engine.ruleTableLUT,
+			/** @type {string} */ prefix = "";
+
+		// both lanes see all of the decoded rule which determines the lookup contents
+		this.digest[0] = 0x811c9dc5;
+		this.digest[1] = 0x3c6ef372;
+		this.check[0] = 0x9747b28c;
+		this.check[1] = 0;
+		if (engine.ruleTableOutput === null) {
+			prefix = "tree";
+			this.mix(engine.ruleTreeStates);
+			this.mix(engine.ruleTreeNeighbours);
+			this.mix(engine.ruleTreeBase);
+			this.mixArray(engine.ruleTreeA);
+			this.mixArray(engine.ruleTreeB);
+		} else {
+			prefix = "table";
+			this.mix(engine.multiNumStates);
+			this.mix(engine.ruleTableNeighbourhood);
+			this.mix(engine.ruleTableCompressedRules);
+			this.mixArray(engine.ruleTableOutput);
+			this.mix(lut.length);
+			for (i = 0; i < lut.length; i += 1) {
+				this.mix(lut[i].length);
+				for (j = 0; j < lut[i].length; j += 1) {
+					this.mixArray(lut[i][j]);
+				}
+			}
+		}
+
+		// include the lookup size limits since they determine the lookup type
+		this.mix(LifeConstants.maxRuleTreeLookupBits);
+		this.mix(LifeConstants.maxRuleTreePartialLookupBits);
+
+		// a key collision is detected by comparing the check when an entry is found
+		engine.ruleLoaderLookupCheck = this.hex(this.check[1]) + this.hex(this.check[0]);
+
+		return prefix + ":" + this.hex(this.digest[1]) + this.hex(this.digest[0]);
+	};
+
+	// install a cached lookup into the engine
+	/** @returns {boolean} */
+	RuleLoaderLookupCache.get = function(/** @type {string} */ key, /** @type {Life} */ engine) {
+		var	entry = this.entries[key],
+			/** @type {number} */ startTime = performance.now();
+
+		// ignore a different rule whose key collided
+		if (entry === undefined || entry.check !== engine.ruleLoaderLookupCheck) {
+			return false;
+		}
+
+		// mark as most recently used
+		this.keys.splice(this.keys.indexOf(key), 1);
+		this.keys[this.keys.length] = key;
+
+		// copy the lookup into engine memory
+		engine.ruleLoaderLookup = null;
+		engine.ruleTreePartialLookup = null;
+		if (entry.partial !== null) {
+			engine.ruleTreePartialLookup = /** @type {!Uint32Array} */ (engine.allocator.allocate(Type.Uint32, entry.partial.length, "Life.ruleTreePartialLookup", Controller.useWASM));
+			engine.ruleTreePartialLookup.set(entry.partial);
+		} else {
+			engine.ruleLoaderLookup = /** @type {!Uint8Array} */ (engine.allocator.allocate(Type.Uint8, entry.lookup.length, "Life.ruleTreeLookup", Controller.useWASM));
+			engine.ruleLoaderLookup.set(entry.lookup);
+		}
+		engine.ruleLoaderLookupBits = entry.bits;
+		engine.ruleLoaderStep = -1;
+		engine.ruleLoaderGenerationTime = performance.now() - startTime;
+
+		return true;
+	};
+
+	// save an entry in memory evicting the least recently used if over budget
+	RuleLoaderLookupCache.remember = function(/** @type {string} */ key, /** @type {string} */ check, /** @type {number} */ bits, /** @type {Uint8Array} */ lookup, /** @type {Uint32Array} */ partial) {
+		var	/** @type {number} */ bytes = (partial !== null ? partial.byteLength : lookup.byteLength),
+			existing = this.entries[key],
+			oldest = null;
+
+		if ((existing !== undefined && existing.check === check) || bytes > this.maxMemoryBytes) {
+			return;
+		}
+
+		// replace an entry for a different rule with the same key
+		if (existing !== undefined) {
+			this.memoryBytes -= (existing.partial !== null ? existing.partial.byteLength : existing.lookup.byteLength);
+			delete this.entries[key];
+			this.keys.splice(this.keys.indexOf(key), 1);
+		}
+
+		while (this.memoryBytes + bytes > this.maxMemoryBytes) {
+			oldest = this.entries[this.keys[0]];
+			this.memoryBytes -= (oldest.partial !== null ? oldest.partial.byteLength : oldest.lookup.byteLength);
+			delete this.entries[this.keys[0]];
+			this.keys.shift();
+		}
+
+		this.entries[key] = {check: check, bits: bits, lookup: lookup, partial: partial};
+		this.keys[this.keys.length] = key;
+		this.memoryBytes += bytes;
+	};
+
+	// add the engine's newly built lookup to the cache and persistent storage
+	RuleLoaderLookupCache.add = function(/** @type {string} */ key, /** @type {Life} */ engine) {
+		var	/** @type {Uint8Array} */ lookup = null,
+			/** @type {Uint32Array} */ partial = null;
+
+		var	/** @type {string} */ check = engine.ruleLoaderLookupCheck;
+
+		// check there is a lookup to save
+		if ((this.entries[key] !== undefined && this.entries[key].check === check) || (engine.ruleLoaderLookup === null && engine.ruleTreePartialLookup === null)) {
+			return;
+		}
+
+		// take a copy since engine memory is reset on pattern load
+		if (engine.ruleTreePartialLookup !== null) {
+			partial = new Uint32Array(engine.ruleTreePartialLookup);
+		} else {
+			lookup = new Uint8Array(engine.ruleLoaderLookup);
+		}
+		this.remember(key, check, engine.ruleLoaderLookupBits, lookup, partial);
+
+		// persist for future page loads
+		this.openDB(function(/** @type {IDBDatabase} */ db) {
+			var	/** @type {IDBTransaction} */ transaction = null,
+				/** @type {number} */ bytes = (partial !== null ? partial.byteLength : lookup.byteLength);
+
+			if (db !== null) {
+				try {
+					transaction = db.transaction([RuleLoaderLookupCache.storeName, RuleLoaderLookupCache.usageStoreName], "readwrite");
+					transaction.objectStore(RuleLoaderLookupCache.storeName).put({"key": key, "check": check, "bits": engine.ruleLoaderLookupBits, "lookup": lookup, "partial": partial});
+					transaction.objectStore(RuleLoaderLookupCache.usageStoreName).put({"key": key, "bytes": bytes, "lastUsed": Date.now()});
+					RuleLoaderLookupCache.evict(transaction);
+				} catch (e) {
+					// storage is best effort so ignore quota and other errors
+				}
+			}
+		});
+	};
+
+	// delete the least recently used persistent lookups over the storage budget
+	RuleLoaderLookupCache.evict = function(/** @type {IDBTransaction} */ transaction) {
+		var	/** @type {IDBObjectStore} */ store = transaction.objectStore(this.storeName),
+			/** @type {IDBObjectStore} */ usage = transaction.objectStore(this.usageStoreName),
+			/** @type {IDBRequest} */ request = usage.index("lastUsed").openCursor(null, "prev"),
+			/** @type {number} */ total = 0;
+
+		// walk from most to least recently used deleting once over budget
+		request.onsuccess = function() {
+			var	/** @type {IDBCursorWithValue} */ cursor = request.result;
+
+			if (cursor) {
+				total += cursor.value["bytes"];
+				if (total > RuleLoaderLookupCache.maxStoreBytes) {
+					store.delete(cursor.primaryKey);
+					cursor.delete();
+				}
+				cursor.continue();
+			}
+		};
+	};
+
+	// update the last used time of a persistent lookup
+	RuleLoaderLookupCache.touch = function(/** @type {IDBDatabase} */ db, /** @type {string} */ key, /** @type {number} */ bytes) {
+		try {
+			db.transaction(this.usageStoreName, "readwrite").objectStore(this.usageStoreName).put({"key": key, "bytes": bytes, "lastUsed": Date.now()});
+		} catch (e) {
+			// storage is best effort so ignore errors
+		}
+	};
+
+	// fetch a lookup from persistent storage into memory and call back with whether it was found for the rule with the given check
+	RuleLoaderLookupCache.fetch = function(/** @type {string} */ key, /** @type {string} */ check, /** @type {function(boolean):void} */ callback) {
+		this.openDB(function(/** @type {IDBDatabase} */ db) {
+			var	/** @type {IDBRequest} */ request = null;
+
+			if (db === null) {
+				callback(false);
+			} else {
+				try {
+					request = db.transaction(RuleLoaderLookupCache.storeName, "readonly").objectStore(RuleLoaderLookupCache.storeName).get(key);
+					request.onsuccess = function() {
+						var	record = request.result;
+
+						if (record && record["check"] === check && (record["lookup"] || record["partial"])) {
+							RuleLoaderLookupCache.touch(db, key, (record["partial"] ? record["partial"].byteLength : record["lookup"].byteLength));
+							RuleLoaderLookupCache.remember(key, check, record["bits"], record["lookup"], record["partial"]);
+							callback(RuleLoaderLookupCache.entries[key] !== undefined);
+						} else {
+							callback(false);
+						}
+					};
+					request.onerror = function() {
+						callback(false);
+					};
+				} catch (e) {
+					callback(false);
+				}
+			}
+		});
+	};
+
+	// open the database and call back with it or null if unavailable
+	RuleLoaderLookupCache.openDB = function(/** @type {function(IDBDatabase):void} */ callback) {
+		var	/** @type {IDBOpenDBRequest} */ request = null,
+			/** @type {number} */ i = 0,
+			/** @type {function(IDBDatabase):void} */ complete = null;
+
+		// check if already open or failed
+		if (this.db !== null || this.dbFailed) {
+			callback(this.db);
+			return;
+		}
+
+		// queue the callback and open if this is the first request
+		this.dbWaiting[this.dbWaiting.length] = callback;
+		if (this.dbWaiting.length > 1) {
+			return;
+		}
+
+		// complete all waiting callbacks
+		complete = function(/** @type {IDBDatabase} */ db) {
+			var	/** @type {Array} */ waiting = RuleLoaderLookupCache.dbWaiting;
+
+			RuleLoaderLookupCache.db = db;
+			RuleLoaderLookupCache.dbFailed = (db === null);
+			RuleLoaderLookupCache.dbWaiting = [];
+			for (i = 0; i < waiting.length; i += 1) {
+				waiting[i](db);
+			}
+		};
+
+		try {
+			request = window.indexedDB.open(this.dbName, this.dbVersion);
+			request.onupgradeneeded = function() {
+				var	/** @type {IDBDatabase} */ db = request.result;
+
+				db.createObjectStore(RuleLoaderLookupCache.storeName, {keyPath: "key"});
+				db.createObjectStore(RuleLoaderLookupCache.usageStoreName, {keyPath: "key"}).createIndex("lastUsed", "lastUsed");
+			};
+			request.onsuccess = function() {
+				complete(request.result);
+			};
+			request.onerror = function() {
+				complete(null);
+			};
+			request.onblocked = function() {
+				complete(null);
+			};
+		} catch (e) {
+			// IndexedDB missing or blocked (e.g. file:// or private mode)
+			complete(null);
+		}
+	};
+
 	// Life object
 	/**
 	 * @constructor
@@ -619,8 +960,27 @@ This file is part of LifeViewer
 		// whether last zoom was < 1/16x
 		/** @type {boolean} */ this.lastZoom16 = true;
 
-		// allocator
-		/** @type {Allocator} */ this.allocator = WASM.allocator;
+		// mask of the small colour grid last built (-1 if it needs a full rebuild)
+		/** @type {number} */ this.smallGridMask = -1;
+
+		// small colour grid buffer last built
+		/** @type {Uint8Array} */ this.smallGridBuffer = null;
+
+		// colour grid the small colour grid was last built from
+		/** @type {Array<Uint32Array>} */ this.smallGridSource = null;
+
+		// generation counter when the small colour grid was last built
+		/** @type {number} */ this.smallGridCounter = -1;
+
+		// tracked generations when the small colour grid was last built
+		/** @type {number} */ this.smallGridTracked = 0;
+
+		// number of generations whose colour changes were recorded in the colour tile dirty grid
+		/** @type {number} */ this.trackedGenerations = 0;
+
+		// allocator (an arena of the shared WASM heap)
+		/** @type {Allocator} */ this.allocator = WASM.allocator.createArena("Life");
+		this.allocator.registerOwner(this);
 
 		// list of potential gliders to clear
 		/** @type {Array} */ this.potentialClears = [];
@@ -645,6 +1005,10 @@ This file is part of LifeViewer
 		/** @type {CanvasRenderingContext2D} */ this.iconContext = null;
 		/** @type {ImageData} */ this.iconImageData = null;
 
+		// WASM icon set (allocated at the top of WASM memory on demand)
+		/** @type {Uint32Array} */ this.iconAtlas32 = null;
+		/** @type {ImageData} */ this.iconAtlasSource = null;
+
 		// snow flakes (x, y, dy)
 		/** @type {Uint16Array} */ this.snowX = null;
 		/** @type {Float32Array} */ this.snowY = null;
@@ -653,6 +1017,12 @@ This file is part of LifeViewer
 		// snow flake revive list
 		/** @type {Uint32Array} */ this.snowRevive = null;
 
+		// WASM copies of the snow flakes and revive list (allocated at the top of memory so reset when the display is resized)
+		/** @type {Uint16Array} */ this.snowXWASM = null;
+		/** @type {Float32Array} */ this.snowYWASM = null;
+		/** @type {Float32Array} */ this.snowDYWASM = null;
+		/** @type {Uint32Array} */ this.snowReviveWASM = null;
+
 		// initialise random number generator
 		/** @type {Random} */ this.randGen = new Random();
 		this.randGen.init(Date.now().toString());
@@ -665,6 +1035,7 @@ This file is part of LifeViewer
 		/** @type {number} */ this.ruleTreeBase = -1;
 		/** @type {Uint32Array} */ this.ruleTreeA = null;
 		/** @type {Uint8Array} */ this.ruleTreeB = null;
+		/** @type {Uint32Array} */ this.ruleTreeCache = null;
 		/** @type {Uint32Array} */ this.ruleTreeColours = null;
 		/** @type {Array} */ this.ruleTableIcons = null;
 
@@ -832,6 +1203,11 @@ This file is part of LifeViewer
 		// whether rule is Wolfram
 		/** @type {number} */ this.wolframRule = -1;
 
+		// frontier row, generation and population for stepping settled Wolfram patterns one row at a time (-1 if not settled)
+		/** @type {number} */ this.wolframFrontier = -1;
+		/** @type {number} */ this.wolframFrontierGen = -1;
+		/** @type {number} */ this.wolframFrontierPop = -1;
+
 		// whether neighbourhood is triangular
 		/** @type {boolean} */ this.isTriangular = false;
 
@@ -1131,6 +1507,12 @@ This file is part of LifeViewer
 		// 32bit view of colour grid
 		/** @type {Array<Uint32Array>} */ this.colourGrid32 = null;
 
+		// Generations state bit planes (one plane per state bit, 16 words per tile)
+		/** @type {Uint16Array} */ this.generationsPlanes = null;
+
+		// generation the bit planes were last updated (-1 if they must be rebuilt from the colour grid)
+		/** @type {number} */ this.generationsPlanesCounter = -1;
+
 		// next colour grid for PCA, RuleTree, Super or Extended rules
 		/** @type {Array<Uint8Array>} */ this.nextColourGrid = null;
 		/** @type {Array<Uint16Array>} */ this.nextColourGrid16 = null;
@@ -1162,6 +1544,9 @@ This file is part of LifeViewer
 		// colour tile history grid (where life has ever been)
 		/** @type {Array<Uint16Array>} */ this.colourTileHistoryGrid = null;
 
+		// colour tile dirty grid (tiles whose colours changed since the small colour grid was built)
+		/** @type {Array<Uint16Array>} */ this.colourTileDirtyGrid = null;
+
 		// state 6 grid for [R]History
 		/** @type {Array<Uint16Array>} */ this.state6Mask = null;
 		/** @type {Array<Uint16Array>} */ this.state6Cells = null;
@@ -1191,6 +1576,12 @@ This file is part of LifeViewer
 		// ruletree fast partial lookup
 		/** @type {Uint32Array} */ this.ruleTreePartialLookup = null;
 
+		// 2-state ruleLoader compiled Life-like bit lookup (null if not in use)
+		/** @type {Uint8Array} */ this.ruleLoaderBitLookup = null;
+
+		// storage for the 2-state ruleLoader bit lookup reused across rule changes
+		/** @type {Uint8Array} */ this.ruleLoaderBitTable = null;
+
 		// ruleLoader lookup bits
 		/** @type {number} */ this.ruleLoaderLookupBits = 0;
 
@@ -1203,6 +1594,12 @@ This file is part of LifeViewer
 		// ruleLoader init step for Moore @TABLE max state rules
 		/** @type {number} */ this.ruleLoaderStep = -1;
 
+		// ruleLoader lookup cache key for the current rule
+		/** @type {string} */ this.ruleLoaderLookupKey = "";
+
+		// ruleLoader lookup cache content check for the current rule
+		/** @type {string} */ this.ruleLoaderLookupCheck = "";
+
 		// 512 bit density all/odd generations
 		/** @type {number} */ this.density = 0;
 		/** @type {number} */ this.densityOdd = 0;
@@ -1211,6 +1608,10 @@ This file is part of LifeViewer
 		/** @type {Uint8Array} */ this.indexLookup63 = null;
 		/** @type {Uint8Array} */ this.indexLookup632 = null;
 
+		// Investigator bit-sliced rule lookups
+		/** @type {Uint8Array} */ this.investigatorLookup63 = null;
+		/** @type {Uint8Array} */ this.investigatorLookup632 = null;
+
 		// triangular lookup
 		/** @type {Uint8Array} */ this.indexLookupTri1 = null;
 		/** @type {Uint8Array} */ this.indexLookupTri2 = null;
@@ -1310,12 +1711,23 @@ This file is part of LifeViewer
 			this.sCanvas.width = width;
 			this.sCanvas.height = height;
 			this.sContext = /** @type {!CanvasRenderingContext2D} */ (this.sCanvas.getContext("2d", {alpha: false}));
-			this.sImageData = this.sContext.getImageData(0, 0, this.sCanvas.width, this.sCanvas.height);
-			this.sData32 = new Uint32Array(this.sImageData.data.buffer);
+			if (Controller.useWASM) {
+				// allocate at the top of WASM memory so the WASM renderer can write to it directly
+				if (this.sImageData === null || this.sImageData.width !== width || this.sImageData.height !== height) {
+					this.sImageData = this.allocateWASMImageData(width, height, "Life.sImageData");
+				}
+			} else {
+				this.sImageData = this.sContext.getImageData(0, 0, this.sCanvas.width, this.sCanvas.height);
+			}
+			this.sData32 = new Uint32Array(this.sImageData.data.buffer, this.sImageData.data.byteOffset, width * height);
 		} else {
 			this.sContext = null;
-			this.sImageData = null;
-			this.sData32 = null;
+
+			// keep the WASM buffer since top of memory is only released on resize
+			if (!Controller.useWASM) {
+				this.sImageData = null;
+				this.sData32 = null;
+			}
 		}
 	};
 
@@ -1397,6 +1809,13 @@ This file is part of LifeViewer
 		for (i = 0; i < LifeConstants.flakes; i += 1) {
 			snowY[i] -= maxPos;
 		}
+
+		// update the WASM copies if allocated
+		if (this.snowXWASM !== null) {
+			this.snowXWASM.set(snowX);
+			this.snowYWASM.set(snowY);
+			this.snowDYWASM.set(snowDY);
+		}
 	};
 
 	// get Y zoom factor based on grid type
@@ -1453,7 +1872,9 @@ This file is part of LifeViewer
 			/** @type {Float32Array} */ snowDY = this.snowDY,
 			/** @type {Uint32Array} */ snowRevive = this.snowRevive,
 			/** @type {number} */ snowCol = this.view.snowColour,
-			/** @type {number} */ yScale = 60 / Controller.refreshRate;
+			/** @type {number} */ yScale = 60 / Controller.refreshRate,
+			/** @type {number} */ timing = performance.now(),
+			/** @type {boolean} */ useWASM = Controller.useWASM && Controller.wasmEnableStarsAndSnow && this.view.wasmEnabled && this.littleEndian && screen.buffer === WASM.memory.buffer;
 
 		// set snow colour
 		if (this.littleEndian) {
@@ -1462,57 +1883,81 @@ This file is part of LifeViewer
 			snowCol = (snowCol << 8) | 255;
 		}
 
-		// update each snowflake
-		for (i = 0; i < LifeConstants.flakes; i += 1) {
-			lastX = snowX[i];
-			lastY = snowY[i];
-			dirY = snowDY[i] * yScale;
-			newX = lastX;
-			newY = lastY;
-
-			// check if the flake is on screen
-			if (lastY >= 0 && lastY < ht - 1) {
-				// check if the delta moves the flake a pixel down
-				if ((lastY | 0) === ((lastY + dirY) | 0)) {
-					newY = lastY + dirY;
-					// draw the flake at the current position
-					screen[(newY | 0) * wd + newX] = snowCol;
-				} else {
-					// check if the space below is free
-					if (screen[((lastY + dirY) | 0) * wd + lastX] === bg) {
+		if (useWASM) {
+			// allocate the WASM copies of the snow flakes if required
+			if (this.snowXWASM === null) {
+				this.snowXWASM = /** @type {!Uint16Array} */ (this.allocator.allocateTop(Type.Uint16, LifeConstants.flakes, "Life.snowXWASM", true));
+				this.snowYWASM = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, LifeConstants.flakes, "Life.snowYWASM", true));
+				this.snowDYWASM = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, LifeConstants.flakes, "Life.snowDYWASM", true));
+				this.snowReviveWASM = /** @type {!Uint32Array} */ (this.allocator.allocateTop(Type.Uint32, LifeConstants.flakes, "Life.snowReviveWASM", true));
+				this.snowXWASM.set(snowX);
+				this.snowYWASM.set(snowY);
+				this.snowDYWASM.set(snowDY);
+
+				// the allocations may have grown the heap and moved the display buffer
+				screen = this.data32;
+			}
+			snowX = this.snowXWASM;
+			snowY = this.snowYWASM;
+			snowDY = this.snowDYWASM;
+			snowRevive = this.snowReviveWASM;
+
+			// update and draw each snowflake
+			numRevive = WASM.updateSnow(snowX.byteOffset | 0, snowY.byteOffset | 0, snowDY.byteOffset | 0, snowRevive.byteOffset | 0,
+				LifeConstants.flakes, screen.byteOffset | 0, wd, ht, bg, snowCol, yScale, (randGen.random() * 4294967296) >>> 0);
+		} else {
+			// update each snowflake
+			for (i = 0; i < LifeConstants.flakes; i += 1) {
+				lastX = snowX[i];
+				lastY = snowY[i];
+				dirY = snowDY[i] * yScale;
+				newX = lastX;
+				newY = lastY;
+
+				// check if the flake is on screen
+				if (lastY >= 0 && lastY < ht - 1) {
+					// check if the delta moves the flake a pixel down
+					if ((lastY | 0) === ((lastY + dirY) | 0)) {
 						newY = lastY + dirY;
+						// draw the flake at the current position
+						screen[(newY | 0) * wd + newX] = snowCol;
 					} else {
-						// space not free so check bottom left or bottom right
-						r = randGen.random();
-						if (r < 0.05) {
-							dx = 1;
-							if (r < 0.025) {
-								dx = -1;
-							}
-							if (lastX + dx >= 0 && lastX + dx < wd) {
-								if (screen[((lastY + dirY) | 0) * wd + lastX + dx] === bg && screen[(lastY | 0) * wd + lastX + dx] === bg) {
-									newX = lastX + dx;
-									newY = lastY + dirY;
+						// check if the space below is free
+						if (screen[((lastY + dirY) | 0) * wd + lastX] === bg) {
+							newY = lastY + dirY;
+						} else {
+							// space not free so check bottom left or bottom right
+							r = randGen.random();
+							if (r < 0.05) {
+								dx = 1;
+								if (r < 0.025) {
+									dx = -1;
+								}
+								if (lastX + dx >= 0 && lastX + dx < wd) {
+									if (screen[((lastY + dirY) | 0) * wd + lastX + dx] === bg && screen[(lastY | 0) * wd + lastX + dx] === bg) {
+										newX = lastX + dx;
+										newY = lastY + dirY;
+									}
 								}
 							}
 						}
+						// draw the flake at the new position
+						screen[(newY | 0) * wd + newX] = snowCol;
 					}
-					// draw the flake at the new position
-					screen[(newY | 0) * wd + newX] = snowCol;
+				} else if (lastY < 0) {
+					// flake is above the screen so move it down
+					newY = lastY + dirY;
 				}
-			} else if (lastY < 0) {
-				// flake is above the screen so move it down
-				newY = lastY + dirY;
-			}
 
-			// if the flake is off the bottom then add to revive list
-			if (newY >= ht - 1) {
-				// add to revive list
-				snowRevive[numRevive] = i;
-				numRevive += 1;
+				// if the flake is off the bottom then add to revive list
+				if (newY >= ht - 1) {
+					// add to revive list
+					snowRevive[numRevive] = i;
+					numRevive += 1;
+				}
+				snowX[i] = newX;
+				snowY[i] = newY;
 			}
-			snowX[i] = newX;
-			snowY[i] = newY;
 		}
 
 		// process any flakes to be revived
@@ -1559,6 +2004,11 @@ This file is part of LifeViewer
 				}
 			}
 		}
+
+		if (Controller.wasmTiming) {
+			timing = performance.now() - timing;
+			this.view.menuManager.updateTimingItem("drawSnow", timing, useWASM);
+		}
 	};
 
 	// apply greyscale to a state colour
@@ -1759,7 +2209,7 @@ This file is part of LifeViewer
 			this.iconCanvas.height = this.displayHeight + this.view.maxZoom;
 
 			this.iconContext = /** @type {!CanvasRenderingContext2D} */ (this.iconCanvas.getContext("2d", {alpha: false}));
-			this.iconImageData = this.iconContext.createImageData(this.iconCanvas.width, this.iconCanvas.height);
+			this.createIconImageData();
 		}
 
 		// mark that icons are available
@@ -1955,7 +2405,7 @@ This file is part of LifeViewer
 				this.iconCanvas.height = this.displayHeight + this.view.maxZoom;
 
 				this.iconContext = /** @type {!CanvasRenderingContext2D} */ (this.iconCanvas.getContext("2d", {alpha: false}));
-				this.iconImageData = this.iconContext.createImageData(this.iconCanvas.width, this.iconCanvas.height);
+				this.createIconImageData();
 			}
 
 			// at least one icon size has been created so check if any other sizes are missing
@@ -5349,7 +5799,7 @@ This file is part of LifeViewer
 	Life.prototype.updateCellCounts = function(/** @type {BoundingBox} */ extent, /** @type {Array<Uint8Array>} */ colourGrid, /** @type {Uint32Array} */ cellCounts) {
 		var	/** @type {number} */ timing = performance.now();
 
-		if (Controller.useWASM && Controller.wasmEnableUpdateCellCounts && this.view.wasmEnabled && !this.isExtended) {
+		if (Controller.useWASM && Controller.wasmEnableUpdateCellCounts && this.view.wasmEnabled) {
 			// swap grids every generation
 			if (this.isSuper || this.isExtended || this.isRuleTree) {
 				colourGrid = this.colourGrid;
@@ -5368,6 +5818,22 @@ This file is part of LifeViewer
 					extent.rightX | 0,
 					colourGrid[0].length | 0
 				);
+			} else if (this.isExtended) {
+				WASM.updateCellCountsExtended(
+					colourGrid.whole.byteOffset | 0,
+					cellCounts.byteOffset | 0,
+					extent.bottomY | 0,
+					extent.leftX | 0,
+					extent.topY | 0,
+					extent.rightX | 0,
+					colourGrid[0].length | 0,
+					this.sharedBuffer.byteOffset | 0
+				);
+
+				// update population statistics
+				this.population -= this.sharedBuffer[0];
+				this.births += this.sharedBuffer[1];
+				this.deaths += this.sharedBuffer[2];
 			} else {
 				WASM.updateCellCounts(
 					colourGrid.whole.byteOffset | 0,
@@ -5497,7 +5963,7 @@ This file is part of LifeViewer
 			}
 		}
 
-		if (Controller.useWASM && Controller.wasmEnableUpdateOccupancyStrict && this.view.wasmEnabled && !this.isExtended) {
+		if (Controller.useWASM && Controller.wasmEnableUpdateOccupancyStrict && this.view.wasmEnabled) {
 			if (this.isSuper || this.isRuleTree) {
 				WASM.updateOccupancyStrictSuperOrRuleLoader(
 					colourGrid.whole.byteOffset | 0,
@@ -5512,6 +5978,20 @@ This file is part of LifeViewer
 					bitStart | 0,
 					colourGrid[0].length | 0
 				);
+			} else if (this.isExtended) {
+				WASM.updateOccupancyStrictExtended(
+					colourGrid.whole.byteOffset | 0,
+					frames.byteOffset | 0,
+					extent.bottomY | 0,
+					extent.leftX | 0,
+					extent.topY | 0,
+					extent.rightX | 0,
+					p | 0,
+					bitRowIn16Bits | 0,
+					bitFrameIn16Bits | 0,
+					bitStart | 0,
+					colourGrid[0].length | 0
+				);
 			} else {
 				WASM.updateOccupancyStrict(
 					colourGrid.whole.byteOffset | 0,
@@ -6291,6 +6771,11 @@ This file is part of LifeViewer
 
 			// check if there is enough memory to allocate
 			if (bitFrameIn16Bits * 2 * period <= memoryLimit) {
+				// grow the heap now if required since the frames are only held in local variables
+				if (Controller.useWASM) {
+					this.allocator.reserveHeap(bitFrameIn16Bits * 2 * period + boxWidth * boxHeight * 4 + 32);
+				}
+
 				// allocate memory for each generation in the period (allocation is one bit per cell)
 				frames = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, period * bitFrameIn16Bits, "Life.bitFrames", Controller.useWASM));
 
@@ -7608,6 +8093,140 @@ This file is part of LifeViewer
 		}
 	};
 
+	// draw hexagon or triangle cells directly into the display buffer using WASM
+	Life.prototype.drawPolygonCellsWASM = function(/** @type {Array<Uint8Array>} */ colourGrid, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ rightX, /** @type {number} */ topY) {
+		var	/** @type {number} */ timing = performance.now(),
+			/** @const {number} */ halfDisplayWidth = this.displayWidth / 2,
+			/** @const {number} */ halfDisplayHeight = this.displayHeight / 2,
+			/** @const {number} */ xzoom = this.zoom * this.originZ,
+			/** @const {number} */ yzoom = this.getYZoom(this.zoom) * this.originZ,
+			/** @const {number} */ h2 = this.height / 2,
+			/** @type {number} */ xOff = this.width / 2 - this.xOff - this.originX,
+			/** @type {number} */ yOff = this.height / 2 - this.yOff - this.originY,
+			/** @type {number} */ xBase = 0,
+			/** @type {number} */ yBase = 0,
+			/** @type {number} */ xg = this.width,
+			/** @type {number} */ yg = this.height,
+			/** @type {number} */ xadj = 0,
+			/** @type {number} */ yadj = 0,
+			/** @type {number} */ borderMode = 0,
+			/** @type {number} */ borderColour = 0,
+			/** @type {number} */ maxGridSize = this.maxGridSize;
+
+		// compute the x and y adjustments for full grid size
+		while (xg < maxGridSize) {
+			xadj += xg >> 1;
+			xg <<= 1;
+		}
+		while (yg < maxGridSize) {
+			yadj += yg >> 1;
+			yg <<= 1;
+		}
+
+		// clip the cell box to the grid
+		if (leftX < 0) {
+			leftX = 0;
+		}
+		if (rightX >= this.width) {
+			rightX = this.width - 1;
+		}
+		if (bottomY < 0) {
+			bottomY = 0;
+		}
+		if (topY >= this.height) {
+			topY = this.height - 1;
+		}
+
+		// grid lines are drawn around every cell, cell borders only around live cells
+		if (this.displayGrid) {
+			borderMode = 2;
+			borderColour = this.gridLineColour;
+		} else {
+			if (this.cellBorders) {
+				borderMode = 1;
+				borderColour = this.pixelColours[0];
+			}
+		}
+
+		if (this.isHex) {
+			// compute the display position of the hexagon centre for cell 0, 0 to match drawHexCells
+			xOff = xOff + yOff / 2 - (this.height >> 2) + 0.5;
+			yOff += 0.5;
+			xBase = ((-(this.width / 2 - ViewConstants.sqrt3 / 4) + xOff - ((0.58 / ViewConstants.sqrt3) - h2 + yOff) / 2) * xzoom) + halfDisplayWidth;
+			yBase = ((yOff - h2) * yzoom) + halfDisplayHeight;
+
+			WASM.renderHexCells(
+				colourGrid.whole.byteOffset | 0,
+				this.overlayGrid ? this.overlayGrid.whole.byteOffset | 0 : 0,
+				colourGrid[0].length | 0,
+				this.pixelColours.byteOffset | 0,
+				this.data32.byteOffset | 0,
+				this.displayWidth | 0,
+				this.displayHeight | 0,
+				leftX | 0,
+				bottomY | 0,
+				rightX | 0,
+				topY | 0,
+				xadj | 0,
+				yadj | 0,
+				maxGridSize | 0,
+				xBase,
+				yBase,
+				xzoom,
+				yzoom,
+				this.aliveStart | 0,
+				(ViewConstants.stateMap[3] + 128) | 0,
+				(ViewConstants.stateMap[4] + 128) | 0,
+				(ViewConstants.stateMap[5] + 128) | 0,
+				(ViewConstants.stateMap[6] + 128) | 0,
+				this.boundaryColour | 0,
+				borderColour | 0,
+				borderMode | 0
+			);
+		} else {
+			// compute the display position of the triangle top centre for cell 0, 0 to match drawTriangleCells
+			xBase = ((0.5 - this.width / 2 + xOff) * xzoom) + halfDisplayWidth;
+			yBase = ((yOff - h2) * yzoom) + halfDisplayHeight;
+
+			WASM.renderTriangleCells(
+				colourGrid.whole.byteOffset | 0,
+				this.overlayGrid ? this.overlayGrid.whole.byteOffset | 0 : 0,
+				colourGrid[0].length | 0,
+				this.pixelColours.byteOffset | 0,
+				this.data32.byteOffset | 0,
+				this.displayWidth | 0,
+				this.displayHeight | 0,
+				leftX | 0,
+				bottomY | 0,
+				rightX | 0,
+				topY | 0,
+				xadj | 0,
+				yadj | 0,
+				maxGridSize | 0,
+				xBase,
+				yBase,
+				xzoom,
+				yzoom,
+				this.aliveStart | 0,
+				(ViewConstants.stateMap[3] + 128) | 0,
+				(ViewConstants.stateMap[4] + 128) | 0,
+				(ViewConstants.stateMap[5] + 128) | 0,
+				(ViewConstants.stateMap[6] + 128) | 0,
+				this.boundaryColour | 0,
+				borderColour | 0,
+				borderMode | 0
+			);
+		}
+
+		// draw the image on the canvas
+		this.context.putImageData(this.imageData, 0, 0);
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem(this.isHex ? "renderHexCells" : "renderTriangleCells", timing, true);
+		}
+	};
+
 	// draw triangles
 	Life.prototype.drawTriangles = function() {
 		var	/** @type {Array<Uint8Array>} */ colourGrid = this.colourGrid,
@@ -7688,6 +8307,12 @@ This file is part of LifeViewer
 			}
 		}
 
+		// use WASM to draw the triangles directly into the display buffer if enabled
+		if (Controller.useWASM && Controller.wasmEnableRenderPolygons && this.view.wasmEnabled) {
+			this.drawPolygonCellsWASM(colourGrid, leftX - 1, bottomY, rightX + 1, topY);
+			return;
+		}
+
 		// create triangles from live cells
 		this.context.lineWidth = LifeConstants.triangleLineWidth;
 		this.context.lineCap = "butt";
@@ -8499,6 +9124,12 @@ This file is part of LifeViewer
 			topY += 1;
 		}
 
+		// use WASM to draw the hexagons directly into the display buffer if enabled
+		if (Controller.useWASM && Controller.wasmEnableRenderPolygons && this.view.wasmEnabled) {
+			this.drawPolygonCellsWASM(colourGrid, leftX, bottomY, rightX, topY);
+			return;
+		}
+
 		for (y = bottomY; y <= topY; y += 1) {
 			// clip y to window
 			displayY = ((y + yOff - h2) * yzoom) + halfDisplayHeight;
@@ -8861,6 +9492,72 @@ This file is part of LifeViewer
 		}
 	};
 
+	// encode the pattern part of RLE using WASM
+	// returns null if WASM can not be used
+	/** @returns {string|null} */
+	Life.prototype.encodeRLEWASM = function(/** @type {View} */ view, /** @type {Life} */ me, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ width, /** @type {number} */ height, /** @type {boolean} */ useColour, /** @type {Array<string>} */ outputState, /** @type {Array<number>} */ mapping, /** @type {boolean} */ blanks, /** @type {boolean} */ noNewLines) {
+		var	/** @type {string|null} */ result = null,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {number} */ bytes = 2 * (width + 1) * height,
+			/** @type {Uint16Array} */ codes = null,
+			/** @type {Uint8Array} */ states = null,
+			/** @type {Uint8Array} */ output = null,
+			/** @type {string} */ code = "",
+			/** @type {number} */ length = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ y = 0;
+
+		if (!(Controller.useWASM && Controller.wasmEnableEncodeRLE && view.wasmEnabled && this.colourGrid.whole.buffer === WASM.memory.buffer) || mapping.length > 256) {
+			return null;
+		}
+
+		// colour grid lookup must be inside the grid
+		if (useColour && (leftX < 0 || bottomY < 0 || leftX + width > this.width || bottomY + height > this.height)) {
+			return null;
+		}
+
+		// room for the RLE plus a newline every 69 characters
+		bytes += (bytes >> 6) + 64;
+
+		// use temporary WASM buffers and then restore the heap pointer
+		heapPointer = this.allocator.getHeapPointer();
+		this.allocator.reserveHeap(bytes + 512 + (useColour ? 0 : width * height) + 64);
+		codes = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, 256, "Life.rleCodes", true));
+		output = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, bytes, "Life.rleOutput", true));
+
+		// create the output characters for each state
+		codes.fill(0);
+		for (i = 0; i < mapping.length; i += 1) {
+			code = outputState[mapping[i]];
+			if (code === undefined) {
+				this.allocator.setHeapPointer(heapPointer);
+				return null;
+			}
+			codes[i] = code.charCodeAt(0) | (code.length > 1 ? code.charCodeAt(1) << 8 : 0);
+		}
+
+		if (useColour) {
+			// encode directly from the colour grid
+			length = WASM.encodeRLE(this.colourGrid.whole.byteOffset, this.width, leftX, bottomY, width, height, 1, this.deadStart, this.boundedBorderColour, codes.byteOffset, blanks ? 1 : 0, noNewLines ? 0 : 1, output.byteOffset);
+		} else {
+			// read the cell states and then encode them
+			states = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, width * height, "Life.rleStates", true));
+			i = 0;
+			for (y = bottomY; y < bottomY + height; y += 1) {
+				for (x = leftX; x < leftX + width; x += 1) {
+					states[i] = me.getState(x, y, false);
+					i += 1;
+				}
+			}
+			length = WASM.encodeRLE(states.byteOffset, width, 0, 0, width, height, 0, 0, 0, codes.byteOffset, blanks ? 1 : 0, noNewLines ? 0 : 1, output.byteOffset);
+		}
+		result = new TextDecoder().decode(output.subarray(0, length));
+		this.allocator.setHeapPointer(heapPointer);
+
+		return result;
+	};
+
 	// convert grid to RLE
 	/** @returns {string} */
 	Life.prototype.asRLE = function(/** @type {View} */ view, /** @type {Life} */ me, /** @type {number} */ inputStates, /** @type {number} */ outputStates, /** @type {Array<number>} */ mapping, /** @type {boolean} */ useAlias, /** @type {number} */ options) {
@@ -8894,7 +9591,8 @@ This file is part of LifeViewer
 			/** @type {boolean} */ blanks = (options & LifeConstants.rleBlanks) !== 0,
 			/** @type {boolean} */ noNewLines = (options & LifeConstants.rleNoNewLines) !== 0,
 			/** @type {boolean} */ noHeader = (options & LifeConstants.rleNoHeader) !== 0,
-			/** @type {boolean} */ addComments = (options & LifeConstants.rleComments) !== 0;
+			/** @type {boolean} */ addComments = (options & LifeConstants.rleComments) !== 0,
+			/** @type {string|null} */ encoded = null;
 
 		// ensure states are at least 2
 		if (inputStates < 2) {
@@ -9017,50 +9715,75 @@ This file is part of LifeViewer
 		lastLength = rle.length;
 
 		// output pattern
-		y = bottomY;
-		while (y <= topY) {
-			x = leftX;
-			// check for 2 state pattern
-			if (inputStates <= 2 && !this.isRuleTree) {
-				// use fast lookup
-				colourRow = colourGrid[y];
-				col = colourRow[x];
-				if (col <= this.deadStart || col === this.boundedBorderColour) {
-					last = 0;
+		encoded = this.encodeRLEWASM(view, me, leftX, bottomY, width, height, inputStates <= 2 && !this.isRuleTree, outputState, mapping, blanks, noNewLines);
+		if (encoded !== null) {
+			rle += encoded;
+		} else {
+			y = bottomY;
+			while (y <= topY) {
+				x = leftX;
+				// check for 2 state pattern
+				if (inputStates <= 2 && !this.isRuleTree) {
+					// use fast lookup
+					colourRow = colourGrid[y];
+					col = colourRow[x];
+					if (col <= this.deadStart || col === this.boundedBorderColour) {
+						last = 0;
+					} else {
+						last = 1;
+					}
 				} else {
-					last = 1;
+					// not 2 state so use full lookup
+					last = me.getState(x, y, false);
 				}
-			} else {
-				// not 2 state so use full lookup
-				last = me.getState(x, y, false);
-			}
-			count = 1;
-			x += 1;
-			while (x <= rightX + 1) {
-				if (x > rightX) {
-					state = -1;
-				} else {
-					// check for 2 state pattern
-					if (inputStates <= 2 && !this.isRuleTree) {
-						// use fast lookup
-						col = colourRow[x];
-						if (col <= this.deadStart || col === this.boundedBorderColour) {
-							state = 0;
+				count = 1;
+				x += 1;
+				while (x <= rightX + 1) {
+					if (x > rightX) {
+						state = -1;
+					} else {
+						// check for 2 state pattern
+						if (inputStates <= 2 && !this.isRuleTree) {
+							// use fast lookup
+							col = colourRow[x];
+							if (col <= this.deadStart || col === this.boundedBorderColour) {
+								state = 0;
+							} else {
+								state = 1;
+							}
 						} else {
-							state = 1;
+							// not 2 state so use full lookup
+							state = me.getState(x, y, false);
 						}
-					} else {
-						// not 2 state so use full lookup
-						state = me.getState(x, y, false);
 					}
-				}
-				if (state !== last) {
-					// output end of previous row(s)
-					if ((!(state === -1 && last === 0) || blanks) && rowCount > 0) {
-						if (rowCount > 1) {
-							rle += rowCount;
+					if (state !== last) {
+						// output end of previous row(s)
+						if ((!(state === -1 && last === 0) || blanks) && rowCount > 0) {
+							if (rowCount > 1) {
+								rle += rowCount;
+							}
+							rle += "$";
+
+							if (!noNewLines) {
+								if (rle.length - lastLength >= charsPerRow) {
+									rle += "\n";
+									lastLength = rle.length;
+								}
+							}
+							rowCount = 0;
+						}
+						// check if run is alive or dead
+						if ((last > 0) || blanks) {
+							if (count > 1) {
+								rle += count;
+							}
+							rle += outputState[mapping[last]];
+						} else if (x <= rightX) {
+							if (count > 1) {
+								rle += count;
+							}
+							rle += outputState[mapping[last]];
 						}
-						rle += "$";
 
 						if (!noNewLines) {
 							if (rle.length - lastLength >= charsPerRow) {
@@ -9068,37 +9791,17 @@ This file is part of LifeViewer
 								lastLength = rle.length;
 							}
 						}
-						rowCount = 0;
-					}
-					// check if run is alive or dead
-					if ((last > 0) || blanks) {
-						if (count > 1) {
-							rle += count;
-						}
-						rle += outputState[mapping[last]];
-					} else if (x <= rightX) {
-						if (count > 1) {
-							rle += count;
-						}
-						rle += outputState[mapping[last]];
-					}
-
-					if (!noNewLines) {
-						if (rle.length - lastLength >= charsPerRow) {
-							rle += "\n";
-							lastLength = rle.length;
-						}
+						count = 1;
+						last = state;
+					} else {
+						count += 1;
 					}
-					count = 1;
-					last = state;
-				} else {
-					count += 1;
+					x += 1;
 				}
-				x += 1;
+				// end of row
+				rowCount += 1;
+				y += 1;
 			}
-			// end of row
-			rowCount += 1;
-			y += 1;
 		}
 		rle += "!\n";
 
@@ -10115,6 +10818,12 @@ This file is part of LifeViewer
 	// dispatcher for setState
 	/** @returns {number} */
 	Life.prototype.setState = function(/** @type {number} */ x, /** @type {number} */ y, /** @type {number} */ state, /** @type {boolean} */ deadZero) {
+		// cell edits are not recorded in the dirty tile grid
+		this.invalidateDerivedGrids();
+
+		// cell edits may unsettle a Wolfram pattern
+		this.wolframFrontier = -1;
+
 		switch (this.stateMode) {
 		case LifeConstants.mode2:
 			return this.setState2(x, y, state, deadZero);
@@ -10486,8 +11195,13 @@ This file is part of LifeViewer
 
 			// check if a snapshot was deleted
 			if (numSnapshots !== this.snapshotManager.snapshots.length) {
-				// reduce snapshot target
-				this.nextSnapshotTarget -= (LifeConstants.snapshotInterval * (numSnapshots - this.snapshotManager.snapshots.length));
+				// next snapshot follows the latest remaining one (older snapshots may be spaced further apart)
+				numSnapshots = this.snapshotManager.snapshots.length;
+				if (numSnapshots > 0) {
+					this.nextSnapshotTarget = this.snapshotManager.snapshots[numSnapshots - 1].counter + LifeConstants.snapshotInterval;
+				} else {
+					this.nextSnapshotTarget = LifeConstants.snapshotInterval;
+				}
 			}
 		}
 
@@ -10535,6 +11249,7 @@ This file is part of LifeViewer
 		// restore the counter
 		this.counter = snapshot.counter;
 		view.fixedPointCounter = snapshot.fixedCounter;
+		this.invalidateDerivedGrids();
 		this.counterMargolus = snapshot.counterMargolus;
 		this.maxMargolusGen = snapshot.maxMargolusGen;
 
@@ -10712,6 +11427,7 @@ This file is part of LifeViewer
 		this.nextTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.nextTileGrid", Controller.useWASM);
 		this.colourTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileGrid", Controller.useWASM);
 		this.colourTileHistoryGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileHistoryGrid", Controller.useWASM);
+		this.colourTileDirtyGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileDirtyGrid", Controller.useWASM);
 		this.diedGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.diedGrid", Controller.useWASM);
 
 		// blank row for 16 bit life grid
@@ -10737,6 +11453,7 @@ This file is part of LifeViewer
 
 		// colour grid
 		this.colourGrid = Array.matrix(Type.Uint8, this.height, this.width, this.unoccupied, this.allocator, "Life.colourGrid", Controller.useWASM);
+		this.generationsPlanes = null;
 		if (this.isPCA || this.isRuleTree || this.isSuper || this.isExtended) {
 			this.nextColourGrid = Array.matrix(Type.Uint8, this.height, this.width, this.unoccupied, this.allocator, "Life.nextColourGrid", Controller.useWASM);
 			this.nextColourGrid16 = Array.matrixView(Type.Uint16, this.nextColourGrid, "Life.nextColourGrid16");
@@ -10794,6 +11511,7 @@ This file is part of LifeViewer
 		this.nextTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.nextTileGrid", Controller.useWASM);
 		this.colourTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileGrid", Controller.useWASM);
 		this.colourTileHistoryGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileHistoryGrid", Controller.useWASM);
+		this.colourTileDirtyGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileDirtyGrid", Controller.useWASM);
 		this.diedGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.diedGrid", Controller.useWASM);
 
 		// blank row for 16 bit life grid
@@ -10819,6 +11537,7 @@ This file is part of LifeViewer
 
 		// colour grid
 		this.colourGrid = Array.matrix(Type.Uint8, this.height, this.width, this.unoccupied, this.allocator, "Life.colourGrid", Controller.useWASM);
+		this.generationsPlanes = null;
 		this.colourGrid16 = Array.matrixView(Type.Uint16, this.colourGrid, "Life.colourGrid16");
 		this.colourGrid32 = Array.matrixView(Type.Uint32, this.colourGrid, "Life.colourGrid32");
 		if (this.isPCA || this.isRuleTree || this.isSuper || this.isExtended) {
@@ -10852,6 +11571,84 @@ This file is part of LifeViewer
 		}
 	};
 
+	// copy the given rows and columns of a grid to the center of a new grid (used by grow grid)
+	Life.prototype.copyGridRangeToCenter = function(/** @type {number} */ firstRow, /** @type {number} */ lastRow, /** @type {number} */ firstCol, /** @type {number} */ lastCol, /** @type {number} */ yOffset, /** @type {number} */ xOffset, /** @type {Array} */ destGrid, /** @type {Array} */ sourceGrid) {
+		var	/** @type {number} */ y = 0;
+
+		for (y = firstRow; y <= lastRow; y += 1) {
+			destGrid[y + yOffset].set(sourceGrid[y].subarray(firstCol, lastCol + 1), xOffset + firstCol);
+		}
+	};
+
+	// get the extent of the grid that may contain cells in tile units (tile rows and 16 tile column groups)
+	/** @returns {Array<number>} */
+	Life.prototype.getGrowExtent = function(/** @type {Array<Array<Uint16Array>>} */ tileGrids) {
+		var	/** @type {number} */ rows = this.tileRows,
+			/** @type {number} */ cols = ((this.tileCols - 1) >> 4) + 1,
+			/** @type {number} */ bottom = rows,
+			/** @type {number} */ top = -1,
+			/** @type {number} */ left = cols,
+			/** @type {number} */ right = -1,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ y = 0,
+			/** @type {number} */ tiles = 0,
+			/** @type {Array<Uint16Array>} */ grid = null;
+
+		// HROT rules do not maintain the tile grids so use the whole grid
+		if (this.isHROT) {
+			return [0, rows - 1, 0, cols - 1];
+		}
+
+		// find the union of the occupied tiles
+		for (i = 0; i < tileGrids.length; i += 1) {
+			grid = tileGrids[i];
+			if (grid) {
+				for (y = 0; y < rows; y += 1) {
+					for (x = 0; x < cols; x += 1) {
+						tiles = grid[y][x];
+						if (tiles) {
+							if (y < bottom) {
+								bottom = y;
+							}
+							if (y > top) {
+								top = y;
+							}
+							if (x < left) {
+								left = x;
+							}
+							if (x > right) {
+								right = x;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		// include the pattern bounding box
+		if (this.population > 0) {
+			y = this.zoomBox.bottomY >> this.tilePower;
+			if (y < bottom) {
+				bottom = y < 0 ? 0 : y;
+			}
+			y = this.zoomBox.topY >> this.tilePower;
+			if (y > top) {
+				top = y >= rows ? rows - 1 : y;
+			}
+			x = this.zoomBox.leftX >> (this.tilePower + 4);
+			if (x < left) {
+				left = x < 0 ? 0 : x;
+			}
+			x = this.zoomBox.rightX >> (this.tilePower + 4);
+			if (x > right) {
+				right = x >= cols ? cols - 1 : x;
+			}
+		}
+
+		return [bottom, top, left, right];
+	};
+
 	// grow grid
 	Life.prototype.growGrid = function(/** @type {boolean} */ growX, /** @type {boolean} */ growY, /** @type {boolean} */ copyContents) {
 		// get the current grid size
@@ -10894,9 +11691,27 @@ This file is part of LifeViewer
 			/** @type {number} */ idBottom = 0,
 			/** @type {number} */ idLeft = 0,
 
+			// extent of the grid that may contain cells (copy range in rows and cells)
+			/** @type {Array<number>} */ extent = null,
+			/** @type {number} */ firstRow = 0,
+			/** @type {number} */ lastRow = -1,
+			/** @type {number} */ firstCell = 0,
+			/** @type {number} */ lastCell = -1,
+
 			// row number
 			/** @type {number} */ y = 0;
 
+		// find the live area before the grids are replaced
+		if (copyContents) {
+			extent = this.getGrowExtent([currentTileGrid, currentNextTileGrid, currentColourTileGrid, currentColourTileHistoryGrid, currentDiedGrid, currentMaskTileGrid]);
+			if (extent[1] >= extent[0]) {
+				firstRow = extent[0] << this.tilePower;
+				lastRow = ((extent[1] + 1) << this.tilePower) - 1;
+				firstCell = extent[2] << (this.tilePower + 4);
+				lastCell = ((extent[3] + 1) << (this.tilePower + 4)) - 1;
+			}
+		}
+
 		// check if already at maximum size or just allocating
 		if (currentWidth < this.maxGridSize || currentHeight < this.maxGridSize || !copyContents) {
 			// double the size
@@ -10941,6 +11756,7 @@ This file is part of LifeViewer
 			this.nextTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.nextTileGrid", Controller.useWASM);
 			this.colourTileGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileGrid", Controller.useWASM);
 			this.colourTileHistoryGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileHistoryGrid", Controller.useWASM);
+			this.colourTileDirtyGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.colourTileDirtyGrid", Controller.useWASM);
 			this.diedGrid = Array.matrix(Type.Uint16, this.tileRows, ((this.tileCols - 1) >> 4) + 1, 0, this.allocator, "Life.diedGrid", Controller.useWASM);
 
 			if (currentOccTileMap) {
@@ -10983,6 +11799,7 @@ This file is part of LifeViewer
 
 			// colour grid
 			this.colourGrid = Array.matrix(Type.Uint8, this.height, this.width, this.unoccupied, this.allocator, "Life.colourGrid", Controller.useWASM);
+			this.generationsPlanes = null;
 			this.smallColourGrid = Array.matrix(Type.Uint8, this.height, this.width, this.unoccupied, this.allocator, "Life.smallColourGrid", Controller.useWASM);
 			this.colourGrid16 = Array.matrixView(Type.Uint16, this.colourGrid, "Life.colourGrid16");
 			this.colourGrid32 = Array.matrixView(Type.Uint32, this.colourGrid, "Life.colourGrid32");
@@ -11008,32 +11825,36 @@ This file is part of LifeViewer
 			this.widthMask = this.width - 1;
 			this.heightMask = this.height - 1;
 
-			// copy the old grids to the center of the new ones if required
+			// copy the live area of the old grids to the center of the new ones if required (the rest of the new grids is already empty)
 			if (copyContents) {
-				this.copyGridToCenter(currentHeight, yOffset, xOffset >> 3, this.grid, currentGrid);
-				this.copyGridToCenter(currentHeight, yOffset, xOffset >> 3, this.nextGrid, currentNextGrid);
-				this.copyGridToCenter(currentHeight, yOffset, xOffset, this.colourGrid, currentColourGrid);
-				// ignore small colour grid it will be generated next time it is needed
+				if (lastRow >= firstRow) {
+					this.copyGridRangeToCenter(firstRow, lastRow, firstCell >> 3, lastCell >> 3, yOffset, xOffset >> 3, this.grid, currentGrid);
+					this.copyGridRangeToCenter(firstRow, lastRow, firstCell >> 3, lastCell >> 3, yOffset, xOffset >> 3, this.nextGrid, currentNextGrid);
+					this.copyGridRangeToCenter(firstRow, lastRow, firstCell, lastCell, yOffset, xOffset, this.colourGrid, currentColourGrid);
+					// ignore small colour grid it will be generated next time it is needed
+
+					if (this.isPCA || this.isRuleTree || this.isSuper || this.isExtended) {
+						this.copyGridRangeToCenter(firstRow, lastRow, firstCell, lastCell, yOffset, xOffset, this.nextColourGrid, currentNextColourGrid);
+					}
+					if (currentOverlayGrid) {
+						this.copyGridRangeToCenter(firstRow, lastRow, firstCell, lastCell, yOffset, xOffset, this.overlayGrid, currentOverlayGrid);
+						// ignore small overlay grid it will be generated next time it is needed
+					}
 
-				if (this.isPCA || this.isRuleTree || this.isSuper || this.isExtended) {
-					this.copyGridToCenter(currentHeight, yOffset, xOffset, this.nextColourGrid, currentNextColourGrid);
+					if (currentMaskGrid && currentMaskAliveGrid && currentMaskCellsGrid) {
+						this.copyGridRangeToCenter(firstRow, lastRow, firstCell >> 4, lastCell >> 4, yOffset, xOffset >> 4, this.state6Mask, currentMaskGrid);
+						this.copyGridRangeToCenter(firstRow, lastRow, firstCell >> 4, lastCell >> 4, yOffset, xOffset >> 4, this.state6Alive, currentMaskAliveGrid);
+						this.copyGridRangeToCenter(firstRow, lastRow, firstCell >> 4, lastCell >> 4, yOffset, xOffset >> 4, this.state6Cells, currentMaskCellsGrid);
+					}
 				}
+
+				// identify lists are not tile based so copy them whole
 				if (this.countList) {
 					this.copyGridToCenter(currentHeight, yOffset, xOffset, this.countList, currentCountList);
 				}
 				if (this.initList) {
 					this.copyGridToCenter(currentHeight, yOffset, xOffset, this.initList, currentInitList);
 				}
-				if (currentOverlayGrid) {
-					this.copyGridToCenter(currentHeight, yOffset, xOffset, this.overlayGrid, currentOverlayGrid);
-					// ignore small overlay grid it will be generated next time it is needed
-				}
-
-				if (currentMaskGrid && currentMaskAliveGrid && currentMaskCellsGrid) {
-					this.copyGridToCenter(currentHeight, yOffset, xOffset >> 4, this.state6Mask, currentMaskGrid);
-					this.copyGridToCenter(currentHeight, yOffset, xOffset >> 4, this.state6Alive, currentMaskAliveGrid);
-					this.copyGridToCenter(currentHeight, yOffset, xOffset >> 4, this.state6Cells, currentMaskCellsGrid);
-				}
 
 				// copy the old tile grids to the center of the new ones
 				if (growY) {
@@ -11334,11 +12155,25 @@ This file is part of LifeViewer
 		this.displayWidth = displayWidth;
 		this.displayHeight = displayHeight;
 
+		// copy the WASM snow flakes back since the top of memory will be reused
+		if (this.snowXWASM !== null) {
+			this.snowX.set(this.snowXWASM);
+			this.snowY.set(this.snowYWASM);
+			this.snowDY.set(this.snowDYWASM);
+		}
+
 		// clear the old buffers
 		this.imageData = null;
 		this.data32 = null;
 		this.data8 = null;
 		this.mode7Buffer = null;
+		this.sImageData = null;
+		this.iconAtlas32 = null;
+		this.iconAtlasSource = null;
+		this.snowXWASM = null;
+		this.snowYWASM = null;
+		this.snowDYWASM = null;
+		this.snowReviveWASM = null;
 
 		if (Controller.useWASM) {
 			// reset top of memory pointer since screen related data will be at top of memory coming down to handle resizes
@@ -11381,7 +12216,15 @@ This file is part of LifeViewer
 				this.iconCanvas.height = this.displayHeight + this.view.maxZoom;
 
 				this.iconContext = /** @type {!CanvasRenderingContext2D} */ (this.iconCanvas.getContext("2d", {alpha: false}));
-				this.iconImageData = this.iconContext.createImageData(this.iconCanvas.width, this.iconCanvas.height);
+				this.createIconImageData();
+			}
+		} else {
+			if (Controller.useWASM) {
+				// reallocate the scale and icon buffers since the top of memory was reset
+				this.initPretty();
+				if (this.iconCanvas !== null) {
+					this.createIconImageData();
+				}
 			}
 		}
 	};
@@ -11654,6 +12497,9 @@ This file is part of LifeViewer
 	// reset the colour grid from the grid
 	Life.prototype.resetColourGridBox = function(/** @type {Array<Uint16Array>} */ grid) {
 		if (!(this.isPCA || this.isRuleTree || this.isHROT)) {
+			// the colour grid is rebuilt directly
+			this.invalidateDerivedGrids();
+
 			switch (this.cellRenderer) {
 				case LifeConstants.shaderCellAge:
 					if (Controller.useWASM && Controller.wasmEnableResetColourGrid && this.view.wasmEnabled) {
@@ -13296,6 +14142,7 @@ This file is part of LifeViewer
 		if (!bitOnly) {
 			colourTileGrid.whole.fill(0);
 			colourTileHistoryGrid.whole.fill(0);
+			this.invalidateDerivedGrids();
 		}
 	};
 
@@ -14050,6 +14897,16 @@ This file is part of LifeViewer
 		}
 	};
 
+	// get the RuleTree neighbourhood cache allocating it (cleared) on first use after a new rule is loaded
+	/** @returns {Uint32Array} */
+	Life.prototype.getRuleTreeCache = function() {
+		if (this.ruleTreeCache === null) {
+			this.ruleTreeCache = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, 4 << LifeConstants.ruleTreeCacheBits, "Life.ruleTreeCache", Controller.useWASM));
+		}
+
+		return this.ruleTreeCache;
+	};
+
 	// create rule tree lookup
 	Life.prototype.createRuleTreeLookup = function() {
 		// get number of cells in neighbourhood
@@ -14359,6 +15216,9 @@ This file is part of LifeViewer
 			// clear lookup table
 			this.ruleLoaderLookup = null;
 			this.ruleLoaderStep = -1;
+
+			// compile 2-state rules into a Life-like bit lookup
+			this.createRuleLoaderBitLookup();
 			return;
 		}
 
@@ -14457,6 +15317,8 @@ This file is part of LifeViewer
 		// clear rule buffers
 		this.indexLookup63 = null;
 		this.indexLookup632 = null;
+		this.investigatorLookup63 = null;
+		this.investigatorLookup632 = null;
 		this.indexLookupTri1 = null;
 		this.indexLookupTri2 = null;
 		this.margolusLookup1 = null;
@@ -14467,16 +15329,16 @@ This file is part of LifeViewer
 		// check for PCA
 		if (this.isPCA) {
 			// create lookup array
-			this.margolusLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCALookup1", false));
+			this.margolusLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCALookup1", Controller.useWASM));
 			if (altSpecified) {
-				this.margolusLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCALookup2", false));
+				this.margolusLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCALookup2", Controller.useWASM));
 				this.createPCAIndex(this.margolusLookup2, ruleArray, false);
 				this.createPCAIndex(this.margolusLookup1, ruleAltArray, false);
 
 				// check for alternate
 				if (this.canReverse(ruleArray, false) && this.canReverse(ruleAltArray, false)) {
-					this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAReverseLookup1", false));
-					this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAReverseLookup2", false));
+					this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAReverseLookup1", Controller.useWASM));
+					this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAReverseLookup2", Controller.useWASM));
 					this.canReverse(ruleAltArray, false);
 					this.createPCAIndex(this.margolusReverseLookup1, ruleAltArray, true);
 					this.canReverse(ruleArray, false);
@@ -14487,7 +15349,7 @@ This file is part of LifeViewer
 
 				// check for reverse
 				if (this.canReverse(ruleArray, false)) {
-					this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAsReverseLookup1", false));
+					this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashPCA, "Life.PCAsReverseLookup1", Controller.useWASM));
 					this.createPCAIndex(this.margolusReverseLookup1, ruleArray, true);
 				}
 			}
@@ -14495,7 +15357,7 @@ This file is part of LifeViewer
 			// check for Margolus
 			if (this.isMargolus) {
 				// create lookup array
-				this.margolusLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusLookup1", false));
+				this.margolusLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusLookup1", Controller.useWASM));
 
 				//  check for V0 = 15 and V15 = 0
 				if (ruleArray[0] === 15 && ruleArray[15] === 0) {
@@ -14513,22 +15375,22 @@ This file is part of LifeViewer
 				}
 
 				if (altSpecified) {
-					this.margolusLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusLookup2", false));
+					this.margolusLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusLookup2", Controller.useWASM));
 					this.createMargolusIndex(this.margolusLookup2, ruleArray);
 					this.createMargolusIndex(this.margolusLookup1, ruleAltArray);
 
 					// check for reverse V0=15/V15=0
 					if (savedArray && this.canReverse(savedArray, true)) {
-						this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", false));
-						this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup2", false));
+						this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", Controller.useWASM));
+						this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup2", Controller.useWASM));
 						this.createNonStrobingAlternates(savedArray, ruleAltArray);
 						this.createMargolusIndex(this.margolusReverseLookup1, ruleAltArray);
 						this.createMargolusIndex(this.margolusReverseLookup2, savedArray);
 					} else {
 						// check for alternate
 						if (this.canReverse(ruleArray, false) && this.canReverse(ruleAltArray, false)) {
-							this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", false));
-							this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup2", false));
+							this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", Controller.useWASM));
+							this.margolusReverseLookup2 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup2", Controller.useWASM));
 							this.canReverse(ruleArray, true);
 							this.createMargolusIndex(this.margolusReverseLookup1, ruleArray);
 							this.canReverse(ruleAltArray, true);
@@ -14540,7 +15402,7 @@ This file is part of LifeViewer
 
 					// check for reverse
 					if (this.canReverse(ruleArray, true)) {
-						this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", false));
+						this.margolusReverseLookup1 = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, LifeConstants.hashMargolus, "Life.margolusReverseLookup1", Controller.useWASM));
 						this.createMargolusIndex(this.margolusReverseLookup1, ruleArray);
 					}
 				}
@@ -14548,9 +15410,9 @@ This file is part of LifeViewer
 				// check for Triangular
 				if (this.isTriangular) {
 					// create lookup arrays
-					this.indexLookupTri1 = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hashTriDouble, "Life.indexLookupTri1", false));
+					this.indexLookupTri1 = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hashTriDouble, "Life.indexLookupTri1", Controller.useWASM));
 					if (altSpecified) {
-						this.indexLookupTri2 = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hashTriDouble, "Life.indexLookupTri2", false));
+						this.indexLookupTri2 = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hashTriDouble, "Life.indexLookupTri2", Controller.useWASM));
 						this.createTriangularIndex(this.indexLookupTri2, ruleArray);
 						this.createTriangularIndex(this.indexLookupTri1, ruleAltArray);
 					} else {
@@ -20843,6 +21705,232 @@ This file is part of LifeViewer
 		this.deaths += delta;
 	};
 
+	// check whether the pattern is a settled Wolfram pattern that can be stepped using just the frontier row
+	/** @returns {boolean} */
+	Life.prototype.canStepWolfram1D = function() {
+		return this.wolframFrontier !== -1 && this.wolframFrontier === this.zoomBox.topY && this.wolframFrontier + 1 < this.height &&
+			this.wolframFrontierGen === this.counter && this.wolframFrontierPop === this.population;
+	};
+
+	// after a full grid generation check whether a Wolfram pattern has settled so only the frontier row will change
+	Life.prototype.checkWolfram1D = function(/** @type {number} */ previousTopY) {
+		var	/** @type {Uint16Array} */ gridRow = null,
+			/** @type {Uint8Array} */ bitCounts = this.bitCounts16,
+			/** @type {number} */ topY = this.zoomBox.topY,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ cells = 0;
+
+		this.wolframFrontier = -1;
+
+		// only even rules without alternation or bounded grids are supported since in those all cells survive and only the row above the pattern can change
+		if (this.altSpecified || (this.wolframRule & 1) !== 0 || this.boundedGridType !== -1 || this.isLifeHistory || this.multiNumStates !== -1 || this.population === 0) {
+			return;
+		}
+
+		// the pattern has settled if this generation's births were all in a new top row
+		if (this.births !== 0) {
+			if (topY !== previousTopY + 1) {
+				return;
+			}
+
+			// count the cells in the new top row
+			if (this.counter & 1) {
+				gridRow = this.grid16[topY];
+			} else {
+				gridRow = this.nextGrid16[topY];
+			}
+			for (x = this.zoomBox.leftX >> 4; x <= this.zoomBox.rightX >> 4; x += 1) {
+				cells += bitCounts[gridRow[x]];
+			}
+
+			if (cells !== this.births) {
+				return;
+			}
+		}
+
+		// save the frontier for the next generation
+		this.wolframFrontier = topY;
+		this.wolframFrontierGen = this.counter + 1;
+		this.wolframFrontierPop = this.population;
+	};
+
+	// compute the next generation for a settled Wolfram pattern by stepping only the frontier row
+	Life.prototype.nextGenerationWolfram1D = function() {
+		var	/** @type {number} */ timing = performance.now();
+
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationWolfram1D && this.view.wasmEnabled) {
+			WASM.nextGenerationWolfram1D(
+				this.grid16.whole.byteOffset | 0,
+				this.nextGrid16.whole.byteOffset | 0,
+				this.grid16[0].length | 0,
+				this.tileGrid.whole.byteOffset | 0,
+				this.nextTileGrid.whole.byteOffset | 0,
+				this.tileGrid[0].length | 0,
+				this.tileGrid.whole.length | 0,
+				this.columnOccupied16.byteOffset | 0,
+				this.columnOccupied16.length | 0,
+				this.rowOccupied16.byteOffset | 0,
+				this.rowOccupied16.length | 0,
+				this.wolframRule | 0,
+				this.population | 0,
+				this.zoomBox.leftX | 0,
+				this.zoomBox.rightX | 0,
+				this.zoomBox.bottomY | 0,
+				this.wolframFrontier | 0,
+				this.width | 0,
+				this.height | 0,
+				this.tileY | 0,
+				this.counter | 0,
+				this.sharedBuffer.byteOffset | 0
+			);
+
+			this.population = this.sharedBuffer[0];
+			this.births = this.sharedBuffer[1];
+			this.deaths = this.sharedBuffer[2];
+			this.zoomBox.leftX = this.sharedBuffer[3];
+			this.zoomBox.bottomY = this.sharedBuffer[4];
+			this.zoomBox.rightX = this.sharedBuffer[5];
+			this.zoomBox.topY = this.sharedBuffer[6];
+		} else {
+			this.nextGenerationWolfram1DJS();
+		}
+
+		// the new row is the frontier for the next generation
+		this.wolframFrontier = this.zoomBox.topY;
+		this.wolframFrontierGen = this.counter + 1;
+		this.wolframFrontierPop = this.population;
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("nextWolfram1D", timing, Controller.useWASM && Controller.wasmEnableNextGenerationWolfram1D && this.view.wasmEnabled);
+		}
+	};
+
+	// compute the Wolfram rule output for a 16 cell word given the words either side
+	/** @returns {number} */
+	Life.prototype.wolframWord = function(/** @type {number} */ rule, /** @type {number} */ prev, /** @type {number} */ cur, /** @type {number} */ next) {
+		var	/** @type {number} */ l = ((cur >> 1) | (prev << 15)) & 65535,
+			/** @type {number} */ r = ((cur << 1) | (next >> 15)) & 65535,
+			/** @type {number} */ k = 0,
+			/** @type {number} */ result = 0;
+
+		// combine the neighbourhoods that are set in the rule (rule is even so the empty neighbourhood is never included)
+		for (k = 1; k < 8; k += 1) {
+			if ((rule & (1 << k)) !== 0) {
+				result |= ((k & 4) ? l : ~l) & ((k & 2) ? cur : ~cur) & ((k & 1) ? r : ~r);
+			}
+		}
+
+		return result & 65535;
+	};
+
+	// compute the next generation for a settled Wolfram pattern Javascript version
+	Life.prototype.nextGenerationWolfram1DJS = function() {
+		var	/** @type {Array<Uint16Array>} */ grid = null,
+			/** @type {Array<Uint16Array>} */ nextGrid = null,
+			/** @type {Array<Uint16Array>} */ tileGrid = null,
+			/** @type {Array<Uint16Array>} */ nextTileGrid = null,
+			/** @type {Uint16Array} */ frontierRow = null,
+			/** @type {Uint16Array} */ targetRow = null,
+			/** @type {Uint16Array} */ nextTargetRow = null,
+			/** @type {Uint16Array} */ columnOccupied16 = this.columnOccupied16,
+			/** @type {Uint8Array} */ bitCounts = this.bitCounts16,
+			/** @type {BoundingBox} */ zoomBox = this.zoomBox,
+			/** @type {number} */ rule = this.wolframRule,
+			/** @type {number} */ frontierY = this.wolframFrontier,
+			/** @type {number} */ targetY = frontierY + 1,
+			/** @type {number} */ gridWidth = this.grid16[0].length,
+			/** @type {number} */ tileCols = this.tileCols,
+			/** @type {number} */ tileRows = this.tileRows,
+			/** @type {number} */ ySize = this.tileY,
+			/** @type {number} */ th = (targetY / ySize) | 0,
+			/** @type {number} */ leftW = (zoomBox.leftX >> 4) - 1,
+			/** @type {number} */ rightW = (zoomBox.rightX >> 4) + 1,
+			/** @type {number} */ w = 0,
+			/** @type {number} */ tc = 0,
+			/** @type {number} */ last = 0,
+			/** @type {number} */ bit = 0,
+			/** @type {number} */ value = 0,
+			/** @type {number} */ births = 0;
+
+		// switch buffers each generation
+		if ((this.counter & 1) !== 0) {
+			grid = this.nextGrid16;
+			nextGrid = this.grid16;
+			tileGrid = this.nextTileGrid;
+			nextTileGrid = this.tileGrid;
+		} else {
+			grid = this.grid16;
+			nextGrid = this.nextGrid16;
+			tileGrid = this.tileGrid;
+			nextTileGrid = this.nextTileGrid;
+		}
+
+		// both buffers hold the full history so make the next buffer match the current one
+		frontierRow = grid[frontierY];
+		nextGrid[frontierY].set(frontierRow);
+		nextTileGrid.whole.set(tileGrid.whole);
+
+		// the new row can extend at most one cell beyond the current extent on each side
+		if (leftW < 0) {
+			leftW = 0;
+		}
+		if (rightW > gridWidth - 1) {
+			rightW = gridWidth - 1;
+		}
+
+		// rebuild the occupancy from the current bounding box (only its edges matter) so it does not depend on the previous step
+		columnOccupied16.fill(0);
+		this.rowOccupied16.fill(0);
+		columnOccupied16[zoomBox.leftX >> 4] |= 32768 >> (zoomBox.leftX & 15);
+		columnOccupied16[zoomBox.rightX >> 4] |= 32768 >> (zoomBox.rightX & 15);
+		this.rowOccupied16[zoomBox.bottomY >> 4] |= 32768 >> (zoomBox.bottomY & 15);
+		this.rowOccupied16[frontierY >> 4] |= 32768 >> (frontierY & 15);
+
+		// compute the new row
+		targetRow = grid[targetY];
+		nextTargetRow = nextGrid[targetY];
+		for (w = leftW; w <= rightW; w += 1) {
+			value = this.wolframWord(rule, w > 0 ? frontierRow[w - 1] : 0, frontierRow[w], w + 1 < gridWidth ? frontierRow[w + 1] : 0);
+			targetRow[w] = value;
+			nextTargetRow[w] = value;
+			if (value) {
+				births += bitCounts[value];
+				columnOccupied16[w] |= value;
+			}
+		}
+
+		// mark the tiles containing the new row and their neighbours in both tile grids
+		if (births) {
+			this.rowOccupied16[targetY >> 4] |= 32768 >> (targetY & 15);
+
+			for (w = leftW; w <= rightW; w += 1) {
+				if (targetRow[w]) {
+					last = w + 1 < tileCols ? w + 1 : tileCols - 1;
+					for (tc = w > 0 ? w - 1 : 0; tc <= last; tc += 1) {
+						bit = 32768 >> (tc & 15);
+						tileGrid[th][tc >> 4] |= bit;
+						nextTileGrid[th][tc >> 4] |= bit;
+
+						// if the new row is the top of the tile then the tile above is also needed
+						if ((targetY % ySize) === ySize - 1 && th + 1 < tileRows) {
+							tileGrid[th + 1][tc >> 4] |= bit;
+							nextTileGrid[th + 1][tc >> 4] |= bit;
+						}
+					}
+				}
+			}
+		}
+
+		// update bounding box
+		this.updateBoundingBox(columnOccupied16, this.rowOccupied16, this.width, this.height, -1, -1, zoomBox);
+
+		// save statistics
+		this.population += births;
+		this.births = births;
+		this.deaths = 0;
+	};
+
 	// compute the next generation with or without statistics
 	Life.prototype.processNextGen = function(/** @type {boolean} */ noHistory) {
 		var	/** @type {BoundingBox} */ zoomBox = this.zoomBox,
@@ -20850,6 +21938,7 @@ This file is part of LifeViewer
 			/** @type {BoundingBox} */ identifyHistoryBox = this.identifyHistoryBox,
 			/** @type {number} */ boundarySize = 16,
 			/** @type {number} */ currentPop = 0,
+			/** @type {number} */ previousTopY = 0,
 			/** @type {number} */ timing = 0;
 
 		// mark no cells killed by hitting boundary
@@ -20876,10 +21965,15 @@ This file is part of LifeViewer
 
 		// check for RuleTable rule
 		if (this.isRuleTree) {
-			if (this.ruleTableOutput === null) {
-				this.nextGenerationRuleTreeTile();
+			// 2-state rules compiled to a Life-like lookup use the bit iterator
+			if (this.ruleLoaderBitLookup !== null && this.ruleLoaderLookupEnabled && Controller.useWASM && Controller.wasmEnableNextGenerationRuleLoaderBits && this.view.wasmEnabled) {
+				this.nextGenerationRuleLoaderBits();
 			} else {
-				this.nextGenerationRuleTableTile();
+				if (this.ruleTableOutput === null) {
+					this.nextGenerationRuleTreeTile();
+				} else {
+					this.nextGenerationRuleTableTile();
+				}
 			}
 		} else {
 			if (this.isPCA) {
@@ -20898,11 +21992,22 @@ This file is part of LifeViewer
 						} else {
 							// process bit grid for [R]Standard, [R]History and [R]Super - but not for [R]Extended
 							if (!this.isExtended) {
-								this.nextGenerationTile();
+								// settled Wolfram patterns only need the frontier row computing
+								if (this.wolframRule !== -1 && this.canStepWolfram1D()) {
+									this.nextGenerationWolfram1D();
+								} else {
+									previousTopY = zoomBox.topY;
+									this.nextGenerationTile();
 
-								// for alternating wolfram rules need to clear all but the bottom line
-								if (this.altSpecified && this.wolframRule !== -1) {
-									this.clearAltWolfram();
+									if (this.wolframRule !== -1) {
+										// for alternating wolfram rules need to clear all but the bottom line
+										if (this.altSpecified) {
+											this.clearAltWolfram();
+										}
+
+										// check whether the pattern can use the frontier row next generation
+										this.checkWolfram1D(previousTopY);
+									}
 								}
 							}
 						}
@@ -20940,7 +22045,10 @@ This file is part of LifeViewer
 			timing = performance.now();
 
 			if (Controller.useWASM && Controller.wasmEnableNextGenerationGenerations && this.view.wasmEnabled) {
-				if ((this.counter & 1) !== 0) {
+				// bounded grids, glider clearing and the maximum size boundary write the colour grid after the step
+				if (Controller.wasmEnableGenerationsBitSliced && this.boundedGridType === -1 && !this.clearGliders && this.width < this.maxGridSize && this.height < this.maxGridSize) {
+					this.nextGenerationGenerationsBitSliced();
+				} else if ((this.counter & 1) !== 0) {
 					WASM.nextGenerationGenerations(
 						this.colourGrid.whole.byteOffset | 0,
 						this.colourTileHistoryGrid.whole.byteOffset | 0,
@@ -22738,6 +23846,63 @@ This file is part of LifeViewer
 
 	// update the life grid region using tiles for triangular grid
 	Life.prototype.nextGenerationTriTile = function() {
+		var	/** @type {number} */ timing = performance.now();
+
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationTriangularLife && this.view.wasmEnabled) {
+			WASM.nextGenerationTriangularLife(
+				this.grid16.whole.byteOffset | 0,
+				this.nextGrid16.whole.byteOffset | 0,
+				this.grid16[0].length | 0,
+				this.tileGrid.whole.byteOffset | 0,
+				this.nextTileGrid.whole.byteOffset | 0,
+				this.tileGrid[0].length | 0,
+				this.indexLookupTri1.byteOffset | 0,
+				(this.altSpecified ? this.indexLookupTri2.byteOffset : 0) | 0,
+				(this.altSpecified ? 1 : 0) | 0,
+				this.columnOccupied16.byteOffset | 0,
+				this.columnOccupied16.length | 0,
+				this.rowOccupied16.byteOffset | 0,
+				this.rowOccupied16.length | 0,
+				this.width | 0,
+				this.height | 0,
+				this.tileY | 0,
+				this.tileRows | 0,
+				this.tileCols | 0,
+				this.blankTileRow.byteOffset | 0,
+				this.blankTileRow.length | 0,
+				this.blankRow16.byteOffset | 0,
+				this.counter | 0,
+				LifeConstants.bottomRightSet | 0,
+				LifeConstants.bottomSet | 0,
+				LifeConstants.topRightSet | 0,
+				LifeConstants.topSet | 0,
+				LifeConstants.bottomLeftSet | 0,
+				LifeConstants.topLeftSet | 0,
+				LifeConstants.leftSet | 0,
+				LifeConstants.rightSet | 0,
+				this.tileGrid.whole.byteLength | 0,
+				this.sharedBuffer.byteOffset | 0
+			);
+
+			this.population = this.sharedBuffer[0];
+			this.births = this.sharedBuffer[1];
+			this.deaths = this.sharedBuffer[2];
+			this.zoomBox.leftX = this.sharedBuffer[3];
+			this.zoomBox.bottomY = this.sharedBuffer[4];
+			this.zoomBox.rightX = this.sharedBuffer[5];
+			this.zoomBox.topY = this.sharedBuffer[6];
+		} else {
+			this.nextGenerationTriTileJS();
+		}
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("nextGenerationTriangular", timing, Controller.useWASM && Controller.wasmEnableNextGenerationTriangularLife && this.view.wasmEnabled);
+		}
+	};
+
+	// update the life grid region using tiles for triangular rules Javascript version
+	Life.prototype.nextGenerationTriTileJS = function() {
 		var	/** @type {Uint8Array} */ indexLookup = this.indexLookupTri1,
 			/** @type {Uint16Array} */ gridRow0 = null,
 			/** @type {Uint16Array} */ gridRow1 = null,
@@ -23337,6 +24502,94 @@ This file is part of LifeViewer
 
 	// update the life grid region using tiles for Margolus grid
 	Life.prototype.nextGenerationMargolusTile = function() {
+		var	/** @type {Uint16Array} */ indexLookup = this.margolusLookup1,
+			/** @type {BoundingBox} */ zoomBox = this.zoomBox,
+
+			// counter for even/odd
+			/** @type {number} */ counter = this.counter & 1,
+
+			// timing
+			/** @type {number} */ timing = performance.now();
+
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationMargolus && this.view.wasmEnabled) {
+			// check for change in playback direction
+			if (this.reversePending) {
+				this.reverseMargolus = !this.reverseMargolus;
+				this.reversePending = false;
+			}
+
+			// select the lookup for this generation
+			if (counter !== 0) {
+				if (this.reverseMargolus) {
+					indexLookup = this.margolusReverseLookup1;
+				}
+			} else {
+				if (this.altSpecified) {
+					indexLookup = this.margolusLookup2;
+				}
+				if (this.reverseMargolus) {
+					indexLookup = (this.altSpecified ? this.margolusReverseLookup2 : this.margolusReverseLookup1);
+				}
+			}
+
+			// invert odd/even for reverse playback
+			if (this.reverseMargolus) {
+				counter = 1 - counter;
+			}
+
+			WASM.nextGenerationMargolus(
+				this.grid16.whole.byteOffset | 0,
+				this.nextGrid16.whole.byteOffset | 0,
+				this.grid16[0].length | 0,
+				this.tileGrid.whole.byteOffset | 0,
+				this.nextTileGrid.whole.byteOffset | 0,
+				this.tileGrid[0].length | 0,
+				this.diedGrid.whole.byteOffset | 0,
+				indexLookup.byteOffset | 0,
+				this.columnOccupied16.byteOffset | 0,
+				this.columnOccupied16.length | 0,
+				this.rowOccupied16.byteOffset | 0,
+				this.rowOccupied16.length | 0,
+				this.width | 0,
+				this.height | 0,
+				this.tileY | 0,
+				this.tileRows | 0,
+				this.tileCols | 0,
+				this.blankTileRow.byteOffset | 0,
+				this.blankTileRow.length | 0,
+				this.counter | 0,
+				counter | 0,
+				LifeConstants.bottomRightSet | 0,
+				LifeConstants.bottomSet | 0,
+				LifeConstants.topRightSet | 0,
+				LifeConstants.topSet | 0,
+				LifeConstants.bottomLeftSet | 0,
+				LifeConstants.topLeftSet | 0,
+				LifeConstants.leftSet | 0,
+				LifeConstants.rightSet | 0,
+				this.tileGrid.whole.byteLength | 0,
+				this.sharedBuffer.byteOffset | 0
+			);
+
+			this.population = this.sharedBuffer[0];
+			this.births = this.sharedBuffer[1];
+			this.deaths = this.sharedBuffer[2];
+			zoomBox.leftX = this.sharedBuffer[3];
+			zoomBox.bottomY = this.sharedBuffer[4];
+			zoomBox.rightX = this.sharedBuffer[5];
+			zoomBox.topY = this.sharedBuffer[6];
+		} else {
+			this.nextGenerationMargolusTileJS();
+		}
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("nextGenerationMargolus", timing, Controller.useWASM && Controller.wasmEnableNextGenerationMargolus && this.view.wasmEnabled);
+		}
+	};
+
+	// update the life grid region using tiles for Margolus grid Javascript version
+	Life.prototype.nextGenerationMargolusTileJS = function() {
 		var	/** @type {Uint16Array} */ indexLookup = this.margolusLookup1,
 			/** @type {number} */ h = 0,
 			/** @type {number} */ b = 0,
@@ -27404,10 +28657,61 @@ This file is part of LifeViewer
 		}
 	};
 
+	// mark the grids derived from the colour grid (small colour grids and Generations bit planes) as needing a full rebuild
+	Life.prototype.invalidateDerivedGrids = function() {
+		this.smallGridMask = -1;
+		this.generationsPlanesCounter = -1;
+	};
+
+	// check whether the small colour grid built last time is still valid for this zoom level and colour grid
+	/** @returns {boolean} */
+	Life.prototype.smallColourGridValid = function(/** @type {number} */ mask, /** @type {Array<Uint32Array>} */ colourGrid32) {
+		// dirty tiles are only recorded by the WASM pen converters and [R]Super iterators
+		if (!(Controller.useWASM && Controller.wasmEnableCreateSmallGrids && this.view.wasmEnabled)) {
+			return false;
+		}
+
+		// bounded grid borders, overlays and HROT write to the colour grid directly
+		if (this.boundedGridType !== -1 || this.drawOverlay || this.isHROT) {
+			return false;
+		}
+
+		// the zoom level and buffers must be unchanged
+		return (mask === this.smallGridMask && this.smallColourGrid.whole === this.smallGridBuffer && (colourGrid32 === this.colourGrid32 || colourGrid32 === this.nextColourGrid32));
+	};
+
+	// check whether the small colour grid can be kept as is because nothing changed since it was built (e.g. paused while panning)
+	/** @returns {boolean} */
+	Life.prototype.canReuseSmallColourGrid = function(/** @type {number} */ mask, /** @type {Array<Uint32Array>} */ colourGrid32) {
+		return (this.smallColourGridValid(mask, colourGrid32) && colourGrid32 === this.smallGridSource && this.counter === this.smallGridCounter && this.trackedGenerations === this.smallGridTracked);
+	};
+
+	// check whether the small colour grid can be updated using just the tiles that changed since it was built
+	/** @returns {boolean} */
+	Life.prototype.canUpdateSmallColourGrid = function(/** @type {number} */ mask, /** @type {Array<Uint32Array>} */ colourGrid32) {
+		var	/** @type {number} */ generations = this.counter - this.smallGridCounter;
+
+		// every generation since the last build must have recorded its colour changes
+		return (this.smallColourGridValid(mask, colourGrid32) && generations > 0 && generations === this.trackedGenerations - this.smallGridTracked);
+	};
+
 	// create the small colour grids based on zoom level
 	Life.prototype.createSmallColourGrids = function(/** @type {Array<Uint16Array>} */ colourGrid16, /** @type {Array<Uint32Array>} */ colourGrid32, /** @type {number} */ camZoom) {
 		var	/** @type {number} */ timing = performance.now(),
-			/** @type {string} */ fName = "";
+			/** @type {string} */ fName = "",
+			/** @type {number} */ mask = this.getMaskFromZoom(camZoom),
+			/** @type {Array<Uint16Array>} */ tileGrid = this.colourTileHistoryGrid;
+
+		// keep the small colour grid if nothing changed since it was built
+		if (this.canReuseSmallColourGrid(mask, colourGrid32)) {
+			this.lastZoom16 = (camZoom < 0.0625);
+			return;
+		}
+
+		// if the small colour grid is still valid then only update tiles that changed since it was built
+		if (this.canUpdateSmallColourGrid(mask, colourGrid32)) {
+			tileGrid = this.colourTileDirtyGrid;
+		}
 
 		// check if 0.5 <= zoom < 1
 		if (camZoom >= 0.5 && camZoom < 1) {
@@ -27420,7 +28724,7 @@ This file is part of LifeViewer
 					WASM.create2x2ColourGridSuper(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
 						this.tileCols | 0,
@@ -27434,7 +28738,7 @@ This file is part of LifeViewer
 					WASM.create2x2ColourGrid(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
 						this.tileCols | 0,
@@ -27454,7 +28758,7 @@ This file is part of LifeViewer
 					WASM.create4x4ColourGridSuper(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27469,7 +28773,7 @@ This file is part of LifeViewer
 					WASM.create4x4ColourGrid(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27490,7 +28794,7 @@ This file is part of LifeViewer
 					WASM.create8x8ColourGridSuper(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27505,7 +28809,7 @@ This file is part of LifeViewer
 					WASM.create8x8ColourGrid(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27526,7 +28830,7 @@ This file is part of LifeViewer
 					WASM.create16x16ColourGridSuper(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
 						this.tileCols | 0,
@@ -27540,7 +28844,7 @@ This file is part of LifeViewer
 					WASM.create16x16ColourGrid(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
 						this.tileCols | 0,
@@ -27559,7 +28863,7 @@ This file is part of LifeViewer
 					WASM.create32x32ColourGridSuper(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27574,7 +28878,7 @@ This file is part of LifeViewer
 					WASM.create32x32ColourGrid(
 						colourGrid32.whole.byteOffset | 0,
 						this.smallColourGrid.whole.byteOffset | 0,
-						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						tileGrid.whole.byteOffset | 0,
 						this.tileY | 0,
 						this.tileX | 0,
 						this.tileRows | 0,
@@ -27686,6 +28990,18 @@ This file is part of LifeViewer
 		} else {
 			this.lastZoom16 = false;
 		}
+
+		// save the small colour grid state if it was built from the current generation
+		if (colourGrid32 === this.colourGrid32 || colourGrid32 === this.nextColourGrid32) {
+			this.smallGridMask = mask;
+			this.smallGridBuffer = this.smallColourGrid.whole;
+			this.smallGridSource = colourGrid32;
+			this.smallGridCounter = this.counter;
+			this.smallGridTracked = this.trackedGenerations;
+			this.colourTileDirtyGrid.whole.fill(0);
+		} else {
+			this.smallGridMask = -1;
+		}
 	};
 
 	// update bounding box after next generation for RuleLoader and Extended rules
@@ -31245,6 +32561,37 @@ This file is part of LifeViewer
 		aliveBox.rightX = newAliveRightX;
 	};
 
+	// compute Generations using the WASM bit plane engine
+	Life.prototype.nextGenerationGenerationsBitSliced = function() {
+		var	/** @const {number} */ maxGenState = this.multiNumStates + this.historyStates - 1,
+			/** @const {number} */ numPlanes = 32 - Math.clz32(maxGenState),
+			/** @const {number} */ planeSize = (this.width >> 4) * this.height,
+			/** @type {boolean} */ rebuild = (this.generationsPlanesCounter !== this.counter - 1);
+
+		// allocate the bit planes if required
+		if (this.generationsPlanes === null || this.generationsPlanes.length !== numPlanes * planeSize) {
+			this.generationsPlanes = /** @type {!Uint16Array} */ (this.allocator.allocate(Type.Uint16, numPlanes * planeSize, "Life.generationsPlanes", Controller.useWASM));
+			rebuild = true;
+		}
+
+		WASM.nextGenerationGenerationsBitSliced(
+			this.colourGrid.whole.byteOffset | 0,
+			this.colourTileHistoryGrid.whole.byteOffset | 0,
+			this.colourTileGrid.whole.byteOffset | 0,
+			this.tileRows | 0, this.tileCols | 0,
+			((this.counter & 1) !== 0 ? this.nextGrid.whole.byteOffset : this.grid.whole.byteOffset) | 0,
+			((this.counter & 1) !== 0 ? this.nextTileGrid.whole.byteOffset : this.tileGrid.whole.byteOffset) | 0,
+			this.colourGrid[0].length | 0,
+			this.sharedBuffer.byteOffset | 0,
+			this.historyStates | 0, maxGenState | 0, (this.historyStates > 0 ? 1 : 0) | 0,
+			this.width | 0, this.height | 0,
+			this.generationsPlanes.byteOffset | 0, numPlanes | 0, (rebuild ? 1 : 0)
+		);
+
+		// the bit planes now match the colour grid for this generation
+		this.generationsPlanesCounter = this.counter;
+	};
+
 	// compute generations rule next generation (after state 0 and 1)
 	Life.prototype.nextGenerationGenerations = function() {
 		var	/** @type {number} */ h = 0,
@@ -31654,6 +33001,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31667,6 +33015,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31676,6 +33025,9 @@ This file is part of LifeViewer
 								this.colourGrid[0].length | 0
 							);
 						}
+
+						// colour changes were recorded in the dirty tile grid
+						this.trackedGenerations += 1;
 					} else {
 						this.convertToPensTileRegular();
 					}
@@ -31692,6 +33044,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31705,6 +33058,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31714,6 +33068,9 @@ This file is part of LifeViewer
 								this.colourGrid[0].length | 0
 							);
 						}
+
+						// colour changes were recorded in the dirty tile grid
+						this.trackedGenerations += 1;
 					} else {
 						this.convertToPensTileNeighbourCount();
 					}
@@ -31726,6 +33083,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31739,6 +33097,7 @@ This file is part of LifeViewer
 								this.colourGrid.whole.byteOffset | 0,
 								this.colourTileHistoryGrid.whole.byteOffset | 0,
 								this.colourTileGrid.whole.byteOffset | 0,
+								this.colourTileDirtyGrid.whole.byteOffset | 0,
 								this.tileY | 0,
 								this.tileX | 0,
 								this.tileRows | 0,
@@ -31748,6 +33107,9 @@ This file is part of LifeViewer
 								this.colourGrid[0].length | 0
 							);
 						}
+
+						// colour changes were recorded in the dirty tile grid
+						this.trackedGenerations += 1;
 					} else {
 						this.convertToPensTile2();
 					}
@@ -31804,6 +33166,9 @@ This file is part of LifeViewer
 			// alive mask for two cells
 			/** @type {number} */ aliveMask16 = (64 << 8) | 64;
 
+		// the colour grid is changed directly
+		this.invalidateDerivedGrids();
+
 		// initialize for first tile
 		topY = ySize;
 
@@ -31902,6 +33267,81 @@ This file is part of LifeViewer
 		}
 	};
 
+	// create an Investigator bit-sliced lookup from a rule array using only the cells in the neighbourhood
+	/** @returns {Uint8Array} */
+	Life.prototype.createInvestigatorLookup = function(/** @type {Uint8Array} */ ruleArray, /** @type {number} */ mask, /** @type {string} */ name) {
+		var	/** @type {Uint8Array} */ maskedArray = new Uint8Array(512),
+			/** @type {Uint8Array} */ lookup = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hash63, name, Controller.useWASM)),
+			/** @type {number} */ i = 0;
+
+		for (i = 0; i < 512; i += 1) {
+			maskedArray[i] = ruleArray[i & mask];
+		}
+		this.createLifeIndex63(lookup, maskedArray);
+
+		return lookup;
+	};
+
+	// update the life grid region using the bit-sliced WASM iterator for Investigator rules
+	Life.prototype.nextGenerationInvestigatorBitSliced = function() {
+		var	/** @type {number} */ mask = 511;
+
+		// get the cells in the neighbourhood
+		if (this.isHex) {
+			mask = 254;
+		} else {
+			if (this.isVonNeumann) {
+				mask = 186;
+			}
+		}
+
+		// create the rule lookups on first use since the rule arrays can be modified after the rule is decoded
+		if (this.investigatorLookup63 === null) {
+			this.investigatorLookup63 = this.createInvestigatorLookup(this.manager.ruleArray, mask, "Life.investigatorLookup63");
+			if (this.altSpecified) {
+				this.investigatorLookup632 = this.createInvestigatorLookup(this.manager.ruleAltArray, mask, "Life.investigatorLookup632");
+			}
+		}
+
+		WASM.nextGenerationInvestigatorBitSliced(
+			this.colourGrid.whole.byteOffset | 0,
+			this.nextColourGrid.whole.byteOffset | 0,
+			this.colourGrid[0].length | 0,
+			this.tileGrid.whole.byteOffset | 0,
+			this.nextTileGrid.whole.byteOffset | 0,
+			this.colourTileHistoryGrid.whole.byteOffset | 0,
+			this.tileGrid[0].length | 0,
+			this.tileGrid.whole.length | 0,
+			this.diedGrid.whole.byteOffset | 0,
+			this.columnOccupied16.byteOffset | 0,
+			this.columnOccupied16.length | 0,
+			this.rowOccupied16.byteOffset | 0,
+			this.rowOccupied16.length | 0,
+			this.investigatorLookup63.byteOffset | 0,
+			this.altSpecified ? (this.investigatorLookup632.byteOffset | 0) : 0 | 0,
+			mask | 0,
+			this.width | 0,
+			this.height | 0,
+			this.tileY | 0,
+			this.tileRows | 0,
+			this.tileCols | 0,
+			this.blankTileRow.byteOffset | 0,
+			this.blankTileRow.length | 0,
+			this.counter | 0,
+			this.altSpecified ? (1 | 0) : (0 | 0),
+			this.nextStateExtendedWASM.byteOffset | 0,
+			LifeConstants.bottomRightSet | 0,
+			LifeConstants.bottomSet | 0,
+			LifeConstants.topRightSet | 0,
+			LifeConstants.topSet | 0,
+			LifeConstants.bottomLeftSet | 0,
+			LifeConstants.topLeftSet | 0,
+			LifeConstants.leftSet | 0,
+			LifeConstants.rightSet | 0,
+			this.sharedBuffer.byteOffset | 0
+		);
+	};
+
 	// update the life grid region using tiles for Extended patterns
 	Life.prototype.nextGenerationExtendedTile = function() {
 		var	/** @type {number} */ width = this.boundedGridWidth,
@@ -31913,7 +33353,10 @@ This file is part of LifeViewer
 			/** @type {number} */ bTopY = 0,
 			/** @type {number} */ timing = performance.now();
 
-		if (this.isHex) {
+		// the bit-sliced iterator handles all neighbourhoods
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationInvestigator && Controller.wasmEnableInvestigatorBitSliced && this.view.wasmEnabled) {
+			this.nextGenerationInvestigatorBitSliced();
+		} else if (this.isHex) {
 			if (Controller.useWASM && Controller.wasmEnableNextGenerationInvestigator && this.view.wasmEnabled) {
 				WASM.nextGenerationInvestigatorHex(
 					this.colourGrid.whole.byteOffset | 0,
@@ -32043,7 +33486,7 @@ This file is part of LifeViewer
 			}
 		}
 
-		if (Controller.useWASM && Controller.wasmEnableNextGenerationSuper && this.view.wasmEnabled) {
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationInvestigator && this.view.wasmEnabled) {
 			this.population = this.sharedBuffer[0];
 			this.births = this.sharedBuffer[1];
 			this.deaths = this.sharedBuffer[2];
@@ -32104,6 +33547,7 @@ This file is part of LifeViewer
 					this.nextTileGrid.whole.byteOffset | 0,
 					this.colourTileGrid.whole.byteOffset | 0,
 					this.colourTileHistoryGrid.whole.byteOffset | 0,
+					this.colourTileDirtyGrid.whole.byteOffset | 0,
 					this.tileGrid[0].length | 0,
 					this.colourGrid.whole.byteOffset | 0,
 					this.nextColourGrid.whole.byteOffset | 0,
@@ -32140,6 +33584,7 @@ This file is part of LifeViewer
 						this.nextTileGrid.whole.byteOffset | 0,
 						this.colourTileGrid.whole.byteOffset | 0,
 						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						this.colourTileDirtyGrid.whole.byteOffset | 0,
 						this.tileGrid[0].length | 0,
 						this.colourGrid.whole.byteOffset | 0,
 						this.nextColourGrid.whole.byteOffset | 0,
@@ -32175,6 +33620,7 @@ This file is part of LifeViewer
 						this.nextTileGrid.whole.byteOffset | 0,
 						this.colourTileGrid.whole.byteOffset | 0,
 						this.colourTileHistoryGrid.whole.byteOffset | 0,
+						this.colourTileDirtyGrid.whole.byteOffset | 0,
 						this.tileGrid[0].length | 0,
 						this.colourGrid.whole.byteOffset | 0,
 						this.nextColourGrid.whole.byteOffset | 0,
@@ -32204,6 +33650,9 @@ This file is part of LifeViewer
 		}
 
 		if (Controller.useWASM && Controller.wasmEnableNextGenerationSuper && this.view.wasmEnabled) {
+			// colour changes were recorded in the dirty tile grid
+			this.trackedGenerations += 1;
+
 			this.population = this.sharedBuffer[0];
 			this.births = this.sharedBuffer[1];
 			this.deaths = this.sharedBuffer[2];
@@ -33002,7 +34451,46 @@ This file is part of LifeViewer
 
 		// 1D
 		case PatternConstants.ruleTableOneD:
-			this.nextGenerationRuleTableTile1D();
+			if (Controller.useWASM && Controller.wasmEnableNextGenerationRuleLoader && this.view.wasmEnabled) {
+				WASM.nextGenerationRuleTable1D(
+					this.colourGrid.whole.byteOffset | 0,
+					this.nextColourGrid.whole.byteOffset | 0,
+					this.colourGrid[0].length | 0,
+					this.tileGrid.whole.byteOffset | 0,
+					this.nextTileGrid.whole.byteOffset | 0,
+					this.colourTileHistoryGrid.whole.byteOffset | 0,
+					this.tileGrid[0].length | 0,
+					this.tileGrid.whole.length | 0,
+					this.diedGrid.whole.byteOffset | 0,
+					this.columnOccupied16.byteOffset | 0,
+					this.columnOccupied16.length | 0,
+					this.rowOccupied16.byteOffset | 0,
+					this.rowOccupied16.length | 0,
+					this.flatRuleTableLUT.byteOffset | 0,
+					this.flatRuleTableLUT.length | 0,
+					this.ruleTableOutput.byteOffset | 0,
+					this.ruleTableCompressedRules | 0,
+					this.width | 0,
+					this.height | 0,
+					this.tileY | 0,
+					this.tileRows | 0,
+					this.tileCols | 0,
+					this.blankTileRow.byteOffset | 0,
+					this.blankTileRow.length | 0,
+					this.counter | 0,
+					LifeConstants.bottomRightSet | 0,
+					LifeConstants.bottomSet | 0,
+					LifeConstants.topRightSet | 0,
+					LifeConstants.topSet | 0,
+					LifeConstants.bottomLeftSet | 0,
+					LifeConstants.topLeftSet | 0,
+					LifeConstants.leftSet | 0,
+					LifeConstants.rightSet | 0,
+					this.sharedBuffer.byteOffset | 0
+				);
+			} else {
+				this.nextGenerationRuleTableTile1D();
+			}
 			break;
 		}
 
@@ -35609,6 +37097,8 @@ This file is part of LifeViewer
 							this.ruleTreeA.byteOffset | 0,
 							this.ruleTreeB.byteOffset | 0,
 							this.ruleTreeBase | 0,
+							this.getRuleTreeCache().byteOffset | 0,
+							((1 << LifeConstants.ruleTreeCacheBits) - 1) | 0,
 							this.width | 0,
 							this.height | 0,
 							this.tileY | 0,
@@ -35686,6 +37176,8 @@ This file is part of LifeViewer
 							this.ruleTreeA.byteOffset | 0,
 							this.ruleTreeB.byteOffset | 0,
 							this.ruleTreeBase | 0,
+							this.getRuleTreeCache().byteOffset | 0,
+							((1 << LifeConstants.ruleTreeCacheBits) - 1) | 0,
 							this.width | 0,
 							this.height | 0,
 							this.tileY | 0,
@@ -36958,6 +38450,93 @@ This file is part of LifeViewer
 		return result;
 	};
 
+	// compile a 2-state RuleLoader rule into a Life-like bit lookup via its MAP equivalent
+	// (the iterator still reads and writes the colour grid a byte per cell so the gain comes from 4 lookups per 16 cells instead of 16)
+	Life.prototype.createRuleLoaderBitLookup = function() {
+		var	/** @type {PatternManager} */ manager = this.manager,
+			/** @type {Pattern} */ pattern = null,
+			/** @type {Uint8Array} */ ruleArray = null,
+			/** @type {string} */ base64 = "";
+
+		this.ruleLoaderBitLookup = null;
+
+		// 1D rules have no MAP equivalent
+		if (this.multiNumStates !== 2 || (this.ruleTableOutput !== null && this.ruleTableNeighbourhood === PatternConstants.ruleTableOneD)) {
+			return;
+		}
+
+		// convert the rule to MAP and expand into a 512 entry rule array
+		base64 = this.ruleLoaderToMAP().substring(3);
+		pattern = new Pattern("ruleLoaderBits", manager);
+		if (manager.validateMap(base64, pattern) === -1) {
+			return;
+		}
+		ruleArray = new Uint8Array(512);
+		manager.createRuleMap(pattern, "", "", base64, ruleArray);
+
+		// only compile rules without B0 (B0 rules keep the RuleLoader iterators)
+		if (ruleArray[0] === 0) {
+			// allocate the lookup unless it is still allocated from a previous rule
+			if (this.ruleLoaderBitTable === null || this.allocator.getInfoFor("Life.ruleLoaderBitLookup") === 0) {
+				this.ruleLoaderBitTable = /** @type {!Uint8Array} */ (this.allocator.allocate(Type.Uint8, LifeConstants.hash63, "Life.ruleLoaderBitLookup", Controller.useWASM));
+			}
+			this.ruleLoaderBitLookup = this.ruleLoaderBitTable;
+			this.createLifeIndex63(this.ruleLoaderBitLookup, ruleArray);
+		}
+	};
+
+	// update the life grid region using the compiled Life-like bit lookup for 2-state RuleLoader rules
+	Life.prototype.nextGenerationRuleLoaderBits = function() {
+		var	/** @type {number} */ timing = performance.now();
+
+		WASM.nextGenerationRuleLoaderBits(
+			this.colourGrid.whole.byteOffset | 0,
+			this.nextColourGrid.whole.byteOffset | 0,
+			this.colourGrid[0].length | 0,
+			this.tileGrid.whole.byteOffset | 0,
+			this.nextTileGrid.whole.byteOffset | 0,
+			this.colourTileHistoryGrid.whole.byteOffset | 0,
+			this.tileGrid[0].length | 0,
+			this.tileGrid.whole.length | 0,
+			this.diedGrid.whole.byteOffset | 0,
+			this.columnOccupied16.byteOffset | 0,
+			this.columnOccupied16.length | 0,
+			this.rowOccupied16.byteOffset | 0,
+			this.rowOccupied16.length | 0,
+			this.ruleLoaderBitLookup.byteOffset | 0,
+			this.width | 0,
+			this.height | 0,
+			this.tileY | 0,
+			this.tileRows | 0,
+			this.tileCols | 0,
+			this.blankTileRow.byteOffset | 0,
+			this.blankTileRow.length | 0,
+			this.counter | 0,
+			LifeConstants.bottomRightSet | 0,
+			LifeConstants.bottomSet | 0,
+			LifeConstants.topRightSet | 0,
+			LifeConstants.topSet | 0,
+			LifeConstants.bottomLeftSet | 0,
+			LifeConstants.topLeftSet | 0,
+			LifeConstants.leftSet | 0,
+			LifeConstants.rightSet | 0,
+			this.sharedBuffer.byteOffset | 0
+		);
+
+		this.population = this.sharedBuffer[0];
+		this.births = this.sharedBuffer[1];
+		this.deaths = this.sharedBuffer[2];
+		this.zoomBox.leftX = this.sharedBuffer[3];
+		this.zoomBox.bottomY = this.sharedBuffer[4];
+		this.zoomBox.rightX = this.sharedBuffer[5];
+		this.zoomBox.topY = this.sharedBuffer[6];
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("nextRuleLoaderBits", timing, true);
+		}
+	};
+
 	// update the life grid region using partial fast lookup for Moore RuleTree rules with 4bit states
 	Life.prototype.nextGenerationRuleTreeTileMoorePartial4 = function() {
 		var	/** @type {Uint8Array} */ gridRow0 = null,
@@ -47677,6 +49256,130 @@ This file is part of LifeViewer
 
 	// next generation for PCA rules
 	Life.prototype.nextGenerationPCATile = function() {
+		var	/** @type {Uint16Array} */ indexLookup = this.margolusLookup1,
+			/** @type {BoundingBox} */ zoomBox = this.zoomBox,
+			/** @type {BoundingBox} */ historyBox = this.historyBox,
+			/** @type {Array<Uint16Array>} */ colourTileGrid = this.colourTileHistoryGrid,
+			/** @type {number} */ leftX = historyBox.leftX,
+			/** @type {number} */ bottomY = historyBox.bottomY,
+			/** @type {number} */ rightX = historyBox.rightX,
+			/** @type {number} */ topY = historyBox.topY,
+
+			// maximum dead state number
+			/** @type {number} */ deadState = this.historyStates,
+
+			// minimum dead state number
+			/** @type {number} */ minDeadState = (this.historyStates > 0 ? 1 : 0),
+
+			// bounded grid edges
+			/** @type {number} */ bLeftX = 0,
+			/** @type {number} */ bBottomY = 0,
+			/** @type {number} */ bRightX = 0,
+			/** @type {number} */ bTopY = 0,
+
+			// timing
+			/** @type {number} */ timing = performance.now();
+
+		if (Controller.useWASM && Controller.wasmEnableNextGenerationMargolus && this.view.wasmEnabled) {
+			// check for bounded grid
+			if (this.boundedGridType !== -1) {
+				bLeftX = Math.round((this.width - this.boundedGridWidth) / 2);
+				bBottomY = Math.round((this.height - this.boundedGridHeight) / 2);
+				bRightX = bLeftX + this.boundedGridWidth - 1;
+				bTopY = bBottomY + this.boundedGridHeight - 1;
+
+				if (this.boundedGridWidth === 0) {
+					bLeftX = 0;
+					bRightX = this.width - 1;
+				}
+
+				if (this.boundedGridHeight === 0) {
+					bBottomY = 0;
+					bTopY = this.height - 1;
+				}
+
+				leftX = bLeftX + 1;
+				bottomY = bBottomY + 1;
+				rightX = bRightX - 1;
+				topY = bTopY - 1;
+			}
+
+			// check for change in playback direction
+			if (this.reversePending) {
+				this.reverseMargolus = !this.reverseMargolus;
+				this.reversePending = false;
+			}
+
+			// select the lookup for this generation
+			if ((this.counter & 1) !== 0) {
+				if (this.reverseMargolus) {
+					indexLookup = (this.altSpecified ? this.margolusReverseLookup2 : this.margolusReverseLookup1);
+				}
+			} else {
+				if (this.altSpecified) {
+					indexLookup = this.margolusLookup2;
+				}
+				if (this.reverseMargolus) {
+					indexLookup = this.margolusReverseLookup1;
+				}
+			}
+
+			// ensure on display
+			if (bottomY < 2) {
+				bottomY = 2;
+			}
+			if (topY > this.height - 3) {
+				topY = this.height - 3;
+			}
+			if (leftX < 1) {
+				leftX = 1;
+			}
+			if (rightX > this.width - 3) {
+				rightX = this.width - 3;
+			}
+
+			WASM.nextGenerationPCA(
+				this.colourGrid.whole.byteOffset | 0,
+				this.nextColourGrid.whole.byteOffset | 0,
+				this.colourGrid[0].length | 0,
+				colourTileGrid.whole.byteOffset | 0,
+				colourTileGrid[0].length | 0,
+				indexLookup.byteOffset | 0,
+				this.counter | 0,
+				deadState | 0,
+				minDeadState | 0,
+				this.width | 0,
+				this.height | 0,
+				leftX | 0,
+				bottomY | 0,
+				rightX | 0,
+				topY | 0,
+				this.sharedBuffer.byteOffset | 0
+			);
+
+			this.population = this.sharedBuffer[0];
+			this.births = this.sharedBuffer[1];
+			this.deaths = this.sharedBuffer[2];
+			historyBox.leftX = this.sharedBuffer[3];
+			historyBox.bottomY = this.sharedBuffer[4];
+			historyBox.rightX = this.sharedBuffer[5];
+			historyBox.topY = this.sharedBuffer[6];
+			zoomBox.leftX = this.sharedBuffer[7];
+			zoomBox.bottomY = this.sharedBuffer[8];
+			zoomBox.rightX = this.sharedBuffer[9];
+			zoomBox.topY = this.sharedBuffer[10];
+		} else {
+			this.nextGenerationPCATileJS();
+		}
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("nextGenerationPCA", timing, Controller.useWASM && Controller.wasmEnableNextGenerationMargolus && this.view.wasmEnabled);
+		}
+	};
+
+	// next generation for PCA rules Javascript version
+	Life.prototype.nextGenerationPCATileJS = function() {
 		var	/** @type {Uint16Array} */ indexLookup = this.margolusLookup1,
 			/** @type {number} */ y = 0,
 			/** @type {number} */ x = 0,
@@ -51881,22 +53584,39 @@ This file is part of LifeViewer
 							this.renderGridProjectionNoClipNoRotate(bottomGrid, layersGrid, mask, drawingSnow);
 						} else {
 							this.createPixelColours(1);
-							WASM.renderGridNoClipNoRotate(
-								bottomGrid.whole.byteOffset | 0,
-								mask | 0,
-								this.pixelColours.byteOffset | 0,
-								this.data32.byteOffset | 0,
-								this.displayWidth | 0,
-								this.displayHeight | 0,
-								this.camXOff,
-								this.camYOff,
-								this.widthMask | 0,
-								this.heightMask | 0,
-								bottomGrid[0].length | 0,
-								this.camZoom,
-								this.isTriangular ? ViewConstants.triangularYFactor : this.isHex ? ViewConstants.hexagonalYFactor : 1,
-								this.xOffsets.byteOffset | 0
-							);
+							// check for integer zoom on a square grid
+							if (this.camZoom >= 1 && this.camZoom === (this.camZoom | 0) && !this.isTriangular) {
+								WASM.renderGridNoClipNoRotateInteger(
+									bottomGrid.whole.byteOffset | 0,
+									this.pixelColours.byteOffset | 0,
+									this.data32.byteOffset | 0,
+									this.displayWidth | 0,
+									this.displayHeight | 0,
+									this.camXOff,
+									this.camYOff,
+									this.widthMask | 0,
+									this.heightMask | 0,
+									bottomGrid[0].length | 0,
+									this.camZoom | 0
+								);
+							} else {
+								WASM.renderGridNoClipNoRotate(
+									bottomGrid.whole.byteOffset | 0,
+									mask | 0,
+									this.pixelColours.byteOffset | 0,
+									this.data32.byteOffset | 0,
+									this.displayWidth | 0,
+									this.displayHeight | 0,
+									this.camXOff,
+									this.camYOff,
+									this.widthMask | 0,
+									this.heightMask | 0,
+									bottomGrid[0].length | 0,
+									this.camZoom,
+									this.isTriangular ? ViewConstants.triangularYFactor : this.isHex ? ViewConstants.hexagonalYFactor : 1,
+									this.xOffsets.byteOffset | 0
+								);
+							}
 
 							// draw grid lines and snow
 							this.drawGridLinesAndSnow(drawingSnow);
@@ -51914,17 +53634,34 @@ This file is part of LifeViewer
 		}
 	};
 
+	// create the icon grid image data (at the top of WASM memory so the WASM renderer can write to it directly)
+	Life.prototype.createIconImageData = function() {
+		if (Controller.useWASM) {
+			this.iconImageData = this.allocateWASMImageData(this.iconCanvas.width, this.iconCanvas.height, "Life.iconImageData");
+		} else {
+			this.iconImageData = this.iconContext.createImageData(this.iconCanvas.width, this.iconCanvas.height);
+		}
+	};
+
+	// allocate image data at the top of WASM memory for off-screen rendering
+	/** @returns {ImageData} */
+	Life.prototype.allocateWASMImageData = function(/** @type {number} */ width, /** @type {number} */ height, /** @type {string} */ name) {
+		const /** @type {Uint8ClampedArray} */ buffer = /** @type {Uint8ClampedArray} */ (this.allocator.allocateTop(Type.Uint8Clamped, width * height * 4, name, true));
+
+		/** @suppress {checkTypes} */
+		return new ImageData(/** @type {Uint8ClampedArray<ArrayBuffer>} */ (buffer), width, height);
+	};
+
 	// render the grid using icons
 	Life.prototype.renderGridProjectionIcons = function(/** @type {Array<Uint8Array>} */ grid, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ rightX, /** @type {number} */ topY, /** @type {boolean} */ drawingSnow, /** @type {boolean} */ drawingStars) {
 		var	/** @const {HTMLCanvasElement} */ iconCanvas = this.iconCanvas,
 			/** @const {CanvasRenderingContext2D} */ iconContext = this.iconContext,
-			/** @const {ImageData} */ iconImageData = this.iconImageData,
-			/** @const {Uint32Array} */ iconImageData32 = new Uint32Array(iconImageData.data.buffer),
+			/** @type {ImageData} */ iconImageData = this.iconImageData,
+			/** @const {Uint32Array} */ iconImageData32 = new Uint32Array(iconImageData.data.buffer, iconImageData.data.byteOffset, iconImageData.width * iconImageData.height),
 			/** @const {CanvasRenderingContext2D} */ ctx = this.context,
 			/** @type {HTMLCanvasElement} */ cellIconCanvas = null,
 			/** @type {ImageData} */ cellIconImageData = null,
 			/** @type {Uint32Array} */ cellIconImageData32 = null,
-			/** @type {Uint8Array} */ gridRow = null,
 			/** @type {number} */ width = rightX - leftX,
 			/** @type {number} */ height = topY - bottomY,
 			/** @const {number} */ yZoom = this.getYZoom(this.camZoom),
@@ -51934,14 +53671,9 @@ This file is part of LifeViewer
 			/** @type {number} */ y = 0,
 			/** @type {number} */ i = 0,
 			/** @type {number} */ j = 0,
-			/** @type {number} */ iScale = 0,
-			/** @type {number} */ jScale = 0,
 			/** @const {number} */ scale = this.camZoom,
-			/** @type {number} */ state = 0,
 			/** @type {number} */ maxIcon = 0,
 			/** @const {number} */ maxGridSize = this.maxGridSize,
-			/** @const {number} */ widthMask = this.width - 1,
-			/** @const {number} */ heightMask = this.height - 1,
 			/** @const {number} */ boundaryColour = this.boundaryColour,
 			/** @type {number} */ xg = this.width,
 			/** @type {number} */ yg = this.height,
@@ -51960,9 +53692,8 @@ This file is part of LifeViewer
 			/** @type {number} */ my = 0,
 			/** @const {number} */ diedColour = this.pixelColours[this.historyStates],
 			/** @const {number} */ destWidth = iconCanvas.width,
-			/** @type {number} */ srcX = 0,
-			/** @type {number} */ destX = 0,
-			/** @type {number} */ cellColour = 0;
+			/** @type {boolean} */ useWASM = Controller.useWASM && Controller.wasmEnableRenderIcons && this.view.wasmEnabled,
+			/** @type {number} */ timing = performance.now();
 
 		// compute the x and y adjustments for full grid size
 		while (xg < maxGridSize) {
@@ -52029,6 +53760,173 @@ This file is part of LifeViewer
 		leftX -= 1;
 		width += 1;
 
+		if (useWASM) {
+			// copy the icon set into WASM memory if it has changed
+			if (this.iconAtlasSource !== cellIconImageData) {
+				if (this.iconAtlas32 === null || this.iconAtlas32.length < cellIconImageData32.length) {
+					this.iconAtlas32 = /** @type {!Uint32Array} */ (this.allocator.allocateTop(Type.Uint32, cellIconImageData32.length, "Life.iconAtlas", true));
+
+					// the allocation may have grown the heap and moved the icon image data
+					iconImageData = this.iconImageData;
+				}
+				this.iconAtlas32.set(cellIconImageData32);
+				this.iconAtlasSource = cellIconImageData;
+			}
+
+			// compute the grid line positions
+			for (j = 0; j < height; j += 1) {
+				rowPos[j] = (j * scale) | 0;
+			}
+			for (i = 0; i < width; i += 1) {
+				colPos[i] = (i * scale) | 0;
+			}
+
+			// PCA icons start after the history states and use the died colour for borders
+			WASM.renderIconGrid(
+				grid.whole.byteOffset | 0,
+				grid[0].length | 0,
+				grid.length | 0,
+				this.pixelColours.byteOffset | 0,
+				this.iconAtlas32.byteOffset | 0,
+				iconImageData.data.byteOffset | 0,
+				destWidth | 0,
+				leftX | 0,
+				bottomY | 0,
+				width | 0,
+				height | 0,
+				xadj | 0,
+				yadj | 0,
+				maxGridSize | 0,
+				cellSize | 0,
+				iconSize | 0,
+				(this.historyStates + 1) | 0,
+				(this.isPCA ? maxIcon : maxIcon - this.historyStates) | 0,
+				(this.isPCA ? diedColour : this.pixelColours[0]) | 0,
+				boundaryColour | 0,
+				(this.boundedGridType !== -1 ? this.boundedBorderColour : 256) | 0
+			);
+		} else {
+			this.renderIconGridJS(grid, iconImageData32, cellIconImageData32, leftX, bottomY, rightX, topY, xadj, yadj, iconSize, cellSize, maxIcon, destWidth, rowPos, colPos);
+		}
+
+		timing = performance.now() - timing;
+		if (Controller.wasmTiming) {
+			this.view.menuManager.updateTimingItem("renderIcons", timing, useWASM);
+		}
+
+		// draw to the icon grid
+		iconContext.putImageData(iconImageData, 0, 0);
+
+		// scale the icon grid onto the display
+		iconContext.imageSmoothingEnabled = true;
+		iconContext.imageSmoothingQuality = "high";
+		ctx.drawImage(iconCanvas, 0, 0, width * cellSize, height * cellSize, dx, dy, width * this.camZoom, height * yZoom);
+		iconContext.imageSmoothingEnabled = false;
+
+		// draw the grid lines if required
+		if (drawGridLines) {
+			// draw the standard grid lines
+			if (this.cellBorders && !this.displayGrid) {
+				ctx.strokeStyle = this.getColourString(this.pixelColours[0]);
+				drawMajor = false;
+			} else {
+				ctx.strokeStyle = this.getColourString(gridCol);
+			}
+			ctx.lineWidth = 1;
+			ctx.beginPath();
+
+			// draw grid line rows
+			for (y = 0; y < rowPos.length; y += 1) {
+				j = ((rowPos[y] + dy) | 0) + 0.5;
+				ctx.moveTo(0, j);
+				ctx.lineTo(this.displayWidth, j);
+			}
+
+			// draw grid line columns
+			for (x = 0; x < colPos.length; x += 1) {
+				i = ((colPos[x] + dx) | 0) + 0.5;
+				ctx.moveTo(i, 0);
+				ctx.lineTo(i, this.displayHeight);
+			}
+
+			// render lines
+			ctx.stroke();
+
+			// draw grid major line rows if needed
+			if (drawMajor) {
+				// compute major grid line horizontal offset
+				my = -(this.displayHeight / 2 / this.getYZoom(this.camZoom)) - (this.height / 2 - this.yOff - this.originY) | 0;
+				my += ((this.view.patternHeight / 2) | 0) - 7;
+
+				mx = -(this.displayWidth / 2 / this.camZoom) - (this.width / 2 - this.xOff - this.originX) | 0;
+				mx += ((this.view.patternWidth / 2) | 0) - 7;
+
+				ctx.strokeStyle = this.getColourString(gridBoldCol);
+				ctx.beginPath();
+
+				// draw grid line rows
+				for (y = 0; y < rowPos.length; y += 1) {
+					if ((my % gridLineMajor) === 0) {
+						j = ((rowPos[y] + dy) | 0) + 0.5;
+						ctx.moveTo(0, j);
+						ctx.lineTo(this.displayWidth, j);
+					}
+					my += 1;
+				}
+
+				// draw grid line columns
+				for (x = 0; x < colPos.length; x += 1) {
+					if ((mx % gridLineMajor) === 0) {
+						i = ((colPos[x] + dx) | 0) + 0.5;
+						ctx.moveTo(i, 0);
+						ctx.lineTo(i, this.displayHeight);
+					}
+					mx += 1;
+				}
+
+				// render lines
+				ctx.stroke();
+			}
+		}
+
+		// update the image data if further rendering is required
+		if (drawingSnow || drawingStars) {
+			// update the image data array from the rendered image
+			this.imageData = this.context.getImageData(0, 0, this.context.canvas.width, this.context.canvas.height);
+			this.data32 = new Uint32Array(this.imageData.data.buffer);
+
+			// draw snow if enabled - TBD snow will stop on grid lines since it is drawn after when the icon renderer is used
+			if (drawingSnow) {
+				this.drawSnow();
+			}
+		} else {
+			// no need to draw the grid since it's already been rendered and there are no overlays (snow or stars)
+			this.doDrawGrid = false;
+		}
+	};
+
+	// build the integer zoom icon grid Javascript version
+	Life.prototype.renderIconGridJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Uint32Array} */ iconImageData32, /** @type {Uint32Array} */ cellIconImageData32, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ rightX, /** @type {number} */ topY, /** @type {number} */ xadj, /** @type {number} */ yadj, /** @type {number} */ iconSize, /** @type {number} */ cellSize, /** @type {number} */ maxIcon, /** @type {number} */ destWidth, /** @type {Array<number>} */ rowPos, /** @type {Array<number>} */ colPos) {
+		var	/** @type {Uint8Array} */ gridRow = null,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ y = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {number} */ iScale = 0,
+			/** @type {number} */ jScale = 0,
+			/** @const {number} */ scale = this.camZoom,
+			/** @type {number} */ state = 0,
+			/** @const {number} */ maxGridSize = this.maxGridSize,
+			/** @const {number} */ widthMask = this.width - 1,
+			/** @const {number} */ heightMask = this.height - 1,
+			/** @const {number} */ boundaryColour = this.boundaryColour,
+			/** @type {number} */ mx = 0,
+			/** @type {number} */ my = 0,
+			/** @const {number} */ diedColour = this.pixelColours[this.historyStates],
+			/** @type {number} */ srcX = 0,
+			/** @type {number} */ destX = 0,
+			/** @type {number} */ cellColour = 0;
+
 		for (y = bottomY; y < topY; y += 1) {
 			if ((y & heightMask) === y) {
 				gridRow = grid[y];
@@ -52258,109 +54156,16 @@ This file is part of LifeViewer
 			}
 			j += 1;
 		}
-
-		// draw to the icon grid
-		iconContext.putImageData(iconImageData, 0, 0);
-
-		// scale the icon grid onto the display
-		iconContext.imageSmoothingEnabled = true;
-		iconContext.imageSmoothingQuality = "high";
-		ctx.drawImage(iconCanvas, 0, 0, width * cellSize, height * cellSize, dx, dy, width * this.camZoom, height * yZoom);
-		iconContext.imageSmoothingEnabled = false;
-
-		// draw the grid lines if required
-		if (drawGridLines) {
-			// draw the standard grid lines
-			if (this.cellBorders && !this.displayGrid) {
-				ctx.strokeStyle = this.getColourString(this.pixelColours[0]);
-				drawMajor = false;
-			} else {
-				ctx.strokeStyle = this.getColourString(gridCol);
-			}
-			ctx.lineWidth = 1;
-			ctx.beginPath();
-
-			// draw grid line rows
-			for (y = 0; y < rowPos.length; y += 1) {
-				j = ((rowPos[y] + dy) | 0) + 0.5;
-				ctx.moveTo(0, j);
-				ctx.lineTo(this.displayWidth, j);
-			}
-
-			// draw grid line columns
-			for (x = 0; x < colPos.length; x += 1) {
-				i = ((colPos[x] + dx) | 0) + 0.5;
-				ctx.moveTo(i, 0);
-				ctx.lineTo(i, this.displayHeight);
-			}
-
-			// render lines
-			ctx.stroke();
-
-			// draw grid major line rows if needed
-			if (drawMajor) {
-				// compute major grid line horizontal offset
-				my = -(this.displayHeight / 2 / this.getYZoom(this.camZoom)) - (this.height / 2 - this.yOff - this.originY) | 0;
-				my += ((this.view.patternHeight / 2) | 0) - 7;
-
-				mx = -(this.displayWidth / 2 / this.camZoom) - (this.width / 2 - this.xOff - this.originX) | 0;
-				mx += ((this.view.patternWidth / 2) | 0) - 7;
-
-				ctx.strokeStyle = this.getColourString(gridBoldCol);
-				ctx.beginPath();
-
-				// draw grid line rows
-				for (y = 0; y < rowPos.length; y += 1) {
-					if ((my % gridLineMajor) === 0) {
-						j = ((rowPos[y] + dy) | 0) + 0.5;
-						ctx.moveTo(0, j);
-						ctx.lineTo(this.displayWidth, j);
-					}
-					my += 1;
-				}
-
-				// draw grid line columns
-				for (x = 0; x < colPos.length; x += 1) {
-					if ((mx % gridLineMajor) === 0) {
-						i = ((colPos[x] + dx) | 0) + 0.5;
-						ctx.moveTo(i, 0);
-						ctx.lineTo(i, this.displayHeight);
-					}
-					mx += 1;
-				}
-
-				// render lines
-				ctx.stroke();
-			}
-		}
-
-		// update the image data if further rendering is required
-		if (drawingSnow || drawingStars) {
-			// update the image data array from the rendered image
-			this.imageData = this.context.getImageData(0, 0, this.context.canvas.width, this.context.canvas.height);
-			this.data32 = new Uint32Array(this.imageData.data.buffer);
-
-			// draw snow if enabled - TBD snow will stop on grid lines since it is drawn after when the icon renderer is used
-			if (drawingSnow) {
-				this.drawSnow();
-			}
-		} else {
-			// no need to draw the grid since it's already been rendered and there are no overlays (snow or stars)
-			this.doDrawGrid = false;
-		}
 	};
 
 	// render the grid using anti-aliasing
 	Life.prototype.renderGridProjectionPretty = function(/** @type {Array<Uint8Array>} */ grid, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ rightX, /** @type {number} */ topY, /** @type {boolean} */ drawingSnow, /** @type {boolean} */ drawingStars) {
 		var	/** @type {Uint32Array} */ pixelColours = this.pixelColours,
-			/** @type {Uint32Array} */ sData32 = this.sData32,
 			/** @type {HTMLCanvasElement} */ sCanvas = this.sCanvas,
 			/** @type {CanvasRenderingContext2D} */ sContext = this.sContext,
 			/** @type {ImageData} */ sImageData = this.sImageData,
 			/** @const {number} */ intZoom2 = (this.camZoom | 0) << 1,
 			/** @const {number} */ sWidth = sCanvas.width,
-			/** @const {number} */ sZWidth = sWidth * intZoom2,
-			/** @type {Uint8Array} */ gridRow = null,
 			/** @type {number} */ width = rightX - leftX,
 			/** @type {number} */ height = topY - bottomY,
 			/** @type {number} */ yZoom = this.getYZoom(this.camZoom),
@@ -52370,13 +54175,7 @@ This file is part of LifeViewer
 			/** @type {number} */ y = 0,
 			/** @type {number} */ i = 0,
 			/** @type {number} */ j = 0,
-			/** @type {number} */ l = 0,
-			/** @type {number} */ xz = 0,
-			/** @type {number} */ yz = 0,
-			/** @type {number} */ col = 0,
 			/** @type {number} */ maxGridSize = this.maxGridSize,
-			/** @const {number} */ widthMask = this.width - 1,
-			/** @const {number} */ heightMask = this.height - 1,
 			/** @type {number} */ gridCol = this.gridLineColour,
 			/** @type {number} */ gridBoldCol = this.gridLineBoldColour,
 			/** @type {number} */ backgroundCol = this.pixelColours[0],
@@ -52384,10 +54183,8 @@ This file is part of LifeViewer
 			/** @type {boolean} */ drawMajor = (this.gridLineMajor > 0 && this.gridLineMajorEnabled && !this.cellBorders),
 			/** @type {number} */ majorX = 0,
 			/** @type {number} */ majorY = 0,
-			/** @type {number} */ majorXStart = 0,
 			/** @type {number} */ odd = this.counter & 1,
 			/** @const {number} */ intZoom = intZoom2 >> 1,
-			/** @type {number} */ intWidth2 = 0,
 			/** @type {number} */ xg = this.width,
 			/** @type {number} */ yg = this.height,
 			/** @type {number} */ xadj = 0,
@@ -52423,6 +54220,143 @@ This file is part of LifeViewer
 		rightX = leftX + width;
 		topY = bottomY + height;
 
+		if (Controller.useWASM && Controller.wasmEnableRenderIcons && this.view.wasmEnabled) {
+			// draw each cell as an integer zoom square (no icons)
+			WASM.renderIconGrid(
+				grid.whole.byteOffset | 0,
+				grid[0].length | 0,
+				grid.length | 0,
+				pixelColours.byteOffset | 0,
+				0,
+				sImageData.data.byteOffset | 0,
+				sWidth | 0,
+				leftX | 0,
+				bottomY | 0,
+				width | 0,
+				height | 0,
+				xadj | 0,
+				yadj | 0,
+				maxGridSize | 0,
+				intZoom2 | 0,
+				0,
+				256,
+				0,
+				0,
+				boundaryCol | 0,
+				256
+			);
+
+			// compute the grid line colours for NxN cells
+			if (drawGridLines && intZoom > 2) {
+				if (drawMajor) {
+					// for Margolus alternate major/minor grid lines for odd/even generations
+					if (!this.isMargolus || this.gridLineMajor !== 2 || !this.altGrid) {
+						odd = 0;
+					}
+
+					majorX = ((-(this.displayWidth / 2 / this.camZoom) - (this.width / 2 - this.xOff - this.originX) + (this.view.patternWidth / 2) + 0.05) | 0) + odd;
+					majorY = ((-(this.displayHeight / 2 / this.camZoom) - (this.height / 2 - this.yOff - this.originY) + (this.view.patternHeight / 2) + 0.05) | 0) + odd;
+				}
+
+				for (x = leftX; x < rightX; x += 1) {
+					if (drawMajor && ((majorX % this.gridLineMajor) === 0)) {
+						gridCols[gridCols.length] = gridBoldCol;
+					} else {
+						gridCols[gridCols.length] = gridCol;
+					}
+					majorX += 1;
+				}
+
+				for (y = bottomY; y < topY; y += 1) {
+					if (drawMajor && ((majorY % this.gridLineMajor) === 0)) {
+						gridRows[gridRows.length] = gridBoldCol;
+					} else {
+						gridRows[gridRows.length] = gridCol;
+					}
+					majorY += 1;
+				}
+			}
+		} else {
+			this.renderPrettyGridJS(grid, leftX, bottomY, width, height, xadj, yadj, gridCol, drawMajor, drawGridLines, gridCols, gridRows);
+		}
+
+		// put the integer zoom cells from the image data onto the canvas
+		sContext.putImageData(sImageData, 0, 0, 0, 0, width * intZoom2, height * intZoom2);
+
+		// pretty scale to the display
+		this.context.imageSmoothingEnabled = true;
+		this.context.drawImage(this.sCanvas, 0, 0, width * intZoom2, height * intZoom2, dx, dy, width * this.camZoom, height * yZoom);
+		this.context.imageSmoothingEnabled = false;
+
+		// update the image data if further rendering is required
+		if (drawingSnow || drawingStars || drawGridLines) {
+			// update the image data array from the rendered image
+			this.imageData = this.context.getImageData(0, 0, this.context.canvas.width, this.context.canvas.height);
+			this.data32 = new Uint32Array(this.imageData.data.buffer);
+
+			// draw vertical grid lines
+			if (drawGridLines) {
+				i = 0;
+				xOff = (((this.width / 2 - (this.xOff + this.originX)) * this.camZoom) + (this.displayWidth / 2)) % this.camZoom;
+				x = -this.camZoom + xOff;
+				for (j = leftX; j <= rightX; j += 1) {
+					this.drawVLine(x | 0, 0, this.displayHeight - 1, gridCols[i]);
+					x += this.camZoom;
+					i += 1;
+				}
+
+				// draw horizontal grid lines
+				i = 0;
+				yOff = (((this.height / 2 - (this.yOff + this.originY)) * this.camZoom) + (this.displayHeight / 2)) % this.camZoom;
+				y = -this.camZoom + yOff;
+				for (j = bottomY; j <= topY; j += 1) {
+					this.drawHLine(0, this.displayWidth - 1, y | 0, gridRows[i]);
+					y += this.camZoom;
+					i += 1;
+				}
+			}
+
+			// draw snow if enabled
+			if (drawingSnow) {
+				this.drawSnow();
+			}
+		} else {
+			// no need to draw the grid since it's already been rendered and there are no overlays (snow, stars, gridlines)
+			this.doDrawGrid = false;
+		}
+	};
+
+	// build the integer zoom grid for the pretty renderer Javascript version
+	Life.prototype.renderPrettyGridJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {number} */ leftX, /** @type {number} */ bottomY, /** @type {number} */ width, /** @type {number} */ height, /** @type {number} */ xadj, /** @type {number} */ yadj, /** @type {number} */ gridCol, /** @type {boolean} */ drawMajor, /** @type {boolean} */ drawGridLines, /** @type {Array<number>} */ gridCols, /** @type {Array<number>} */ gridRows) {
+		var	/** @type {Uint32Array} */ pixelColours = this.pixelColours,
+			/** @type {Uint32Array} */ sData32 = this.sData32,
+			/** @const {number} */ intZoom2 = (this.camZoom | 0) << 1,
+			/** @const {number} */ sWidth = this.sCanvas.width,
+			/** @const {number} */ sZWidth = sWidth * intZoom2,
+			/** @type {Uint8Array} */ gridRow = null,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ y = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {number} */ l = 0,
+			/** @type {number} */ xz = 0,
+			/** @type {number} */ yz = 0,
+			/** @type {number} */ col = 0,
+			/** @type {number} */ maxGridSize = this.maxGridSize,
+			/** @const {number} */ widthMask = this.width - 1,
+			/** @const {number} */ heightMask = this.height - 1,
+			/** @type {number} */ gridBoldCol = this.gridLineBoldColour,
+			/** @type {number} */ backgroundCol = this.pixelColours[0],
+			/** @type {number} */ boundaryCol = this.boundaryColour,
+			/** @type {number} */ majorX = 0,
+			/** @type {number} */ majorY = 0,
+			/** @type {number} */ majorXStart = 0,
+			/** @type {number} */ odd = this.counter & 1,
+			/** @const {number} */ intZoom = intZoom2 >> 1,
+			/** @type {number} */ intWidth2 = 0,
+			/** @const {number} */ rightX = leftX + width,
+			/** @const {number} */ topY = bottomY + height;
+
 		// use optimized scaling based on zoom level
 		switch (intZoom) {
 		case 1:
@@ -52591,51 +54525,6 @@ This file is part of LifeViewer
 			}
 			break;
 		}
-
-		// put the integer zoom cells from the image data onto the canvas
-		sContext.putImageData(sImageData, 0, 0, 0, 0, width * intZoom2, height * intZoom2);
-
-		// pretty scale to the display
-		this.context.imageSmoothingEnabled = true;
-		this.context.drawImage(this.sCanvas, 0, 0, width * intZoom2, height * intZoom2, dx, dy, width * this.camZoom, height * yZoom);
-		this.context.imageSmoothingEnabled = false;
-
-		// update the image data if further rendering is required
-		if (drawingSnow || drawingStars || drawGridLines) {
-			// update the image data array from the rendered image
-			this.imageData = this.context.getImageData(0, 0, this.context.canvas.width, this.context.canvas.height);
-			this.data32 = new Uint32Array(this.imageData.data.buffer);
-
-			// draw vertical grid lines
-			if (drawGridLines) {
-				i = 0;
-				xOff = (((this.width / 2 - (this.xOff + this.originX)) * this.camZoom) + (this.displayWidth / 2)) % this.camZoom;
-				x = -this.camZoom + xOff;
-				for (j = leftX; j <= rightX; j += 1) {
-					this.drawVLine(x | 0, 0, this.displayHeight - 1, gridCols[i]);
-					x += this.camZoom;
-					i += 1;
-				}
-
-				// draw horizontal grid lines
-				i = 0;
-				yOff = (((this.height / 2 - (this.yOff + this.originY)) * this.camZoom) + (this.displayHeight / 2)) % this.camZoom;
-				y = -this.camZoom + yOff;
-				for (j = bottomY; j <= topY; j += 1) {
-					this.drawHLine(0, this.displayWidth - 1, y | 0, gridRows[i]);
-					y += this.camZoom;
-					i += 1;
-				}
-			}
-
-			// draw snow if enabled
-			if (drawingSnow) {
-				this.drawSnow();
-			}
-		} else {
-			// no need to draw the grid since it's already been rendered and there are no overlays (snow, stars, gridlines)
-			this.doDrawGrid = false;
-		}
 	};
 
 	// render the grid with overlay using anti-aliasing
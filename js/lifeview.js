@@ -84,6 +84,12 @@ This file is part of LifeViewer
 		// safe update period in ms (2.5 times per second)
 		/** @type {number} */ safeUpdatePeriod : 400,
 
+		// margin around the visible area within which deferred embedded viewers start
+		/** @const {string} */ lazyStartMargin : "100% 0px",
+
+		// margin around the visible area outside which started embedded viewers release their engine arena
+		/** @const {string} */ lazyReleaseMargin : "400% 0px",
+
 		// default snow colour (white)
 		/** @const {number} */ defaultSnowColour : 0xffffff,
 
@@ -584,6 +590,9 @@ This file is part of LifeViewer
 		/** @type {boolean} */ wasmTiming : true,
 		/** @type {boolean} */ wasmEnableGetHash : true,
 		/** @type {boolean} */ wasmEnableRenderGrid: true,
+		/** @type {boolean} */ wasmEnableRenderPolygons: true,
+		/** @type {boolean} */ wasmEnableRenderIcons: true,
+		/** @type {boolean} */ wasmEnableStarsAndSnow: true,
 		/** @type {boolean} */ wasmEnableConvertToPens : true,
 		/** @type {boolean} */ wasmEnableCreateSmallGrids : true,
 		/** @type {boolean} */ wasmEnableUpdateCellCounts : true,
@@ -595,8 +604,11 @@ This file is part of LifeViewer
 		/** @type {boolean} */ wasmEnableWrapTorusHROT : true,
 		/** @type {boolean} */ wasmEnableClearTopAndLeft: true,
 		/** @type {boolean} */ wasmEnableNextGeneration: true,
+		/** @type {boolean} */ wasmEnableNextGenerationWolfram1D: true,
 		/** @type {boolean} */ wasmEnableNextGenerationInvestigator: true,
+		/** @type {boolean} */ wasmEnableInvestigatorBitSliced: true,
 		/** @type {boolean} */ wasmEnableNextGenerationGenerations: true,
+		/** @type {boolean} */ wasmEnableGenerationsBitSliced: true,
 		/** @type {boolean} */ wasmEnableNextGenerationSuper: true,
 		/** @type {boolean} */ wasmEnableNextGenerationCross: true,
 		/** @type {boolean} */ wasmEnableNextGenerationHash: true,
@@ -610,20 +622,57 @@ This file is part of LifeViewer
 		/** @type {boolean} */ wasmEnableNextGenerationAsterisk: true,
 		/** @type {boolean} */ wasmEnableNextGenerationTripod: true,
 		/** @type {boolean} */ wasmEnableNextGenerationTriangular: true,
+		/** @type {boolean} */ wasmEnableNextGenerationTriangularLife: true,
 		/** @type {boolean} */ wasmEnableNextGenerationCustom: true,
 		/** @type {boolean} */ wasmEnableNextGenerationGaussian: true,
 		/** @type {boolean} */ wasmEnableNextGenerationWeighted: true,
 		/** @type {boolean} */ wasmEnableNextGenerationRuleLoader: true,
+		/** @type {boolean} */ wasmEnableNextGenerationRuleLoaderBits: true,
+		/** @type {boolean} */ wasmEnableNextGenerationMargolus: true,
 		/** @type {boolean} */ wasmEnableUpdateGridFromCounts: true,
 		/** @type {boolean} */ wasmEnableResetColourGrid: true,
 		/** @type {boolean} */ wasmEnableResetPopulation: true,
 		/** @type {boolean} */ wasmEnableResetBoxes: true,
 		/** @type {boolean} */ wasmEnableShrinkTileGrid: true,
+		/** @type {boolean} */ wasmEnableSnapshotPack: true,
+		/** @type {boolean} */ wasmEnableSnapshotTiles: true,
+		/** @type {boolean} */ wasmEnableDecodeRLE: true,
+		/** @type {boolean} */ wasmEnableEncodeRLE: true,
 
 		/** @type {CanvasRenderingContext2D} */ iconCache: null,
 
 		/** @type {number} */ pageScanTime: 0,
-		/** @type {string} */ wasmError: ""
+		/** @type {string} */ wasmError: "",
+
+		// whether WebAssembly is still being fetched or compiled
+		/** @type {boolean} */ wasmLoading: false,
+
+		// whether viewers are waiting for WebAssembly to finish loading before starting
+		/** @type {boolean} */ startPending: false,
+
+		// worker used to check code box patterns off the main thread (null if checks run on the main thread)
+		/** @type {Worker} */ patternWorker: null,
+
+		// code box checks waiting for a worker reply (pattern text, rle div and text item)
+		/** @type {Array} */ patternChecks: [],
+
+		// pattern manager used for every check for the lifetime of the pattern check worker (only set in the worker)
+		/** @type {PatternManager} */ patternWorkerManager: null,
+
+		// temporary pattern managers waiting for repository requests to complete before their arenas are released
+		/** @type {Array<PatternManager>} */ discardedManagers: [],
+
+		// observer used to start embedded viewers when they scroll into view (null if not supported)
+		/** @type {IntersectionObserver} */ lazyObserver: null,
+
+		// observer used to release the engine arena of embedded viewers far outside the visible area (null if not supported)
+		/** @type {IntersectionObserver} */ releaseObserver: null,
+
+		// number of viewer ids assigned (ids follow page order even when viewers start later)
+		/** @type {number} */ numViewIds: 0,
+
+		// embedded viewers waiting to start (canvas, pattern text, maximum width and text item)
+		/** @type {Array} */ lazyViews: []
 	};
 
 	// save boolean setting
@@ -724,8 +773,12 @@ This file is part of LifeViewer
 			}
 			console.log("refresh rate", Controller.refreshRate + "Hz " + (Controller.refreshOverride ? "Fixed" : "Auto"));
 
-			// start main application
-			setTimeout(startAllViewers, 0);
+			// start main application (once WebAssembly has loaded)
+			if (Controller.wasmLoading) {
+				Controller.startPending = true;
+			} else {
+				setTimeout(startAllViewers, 0);
+			}
 		} else {
 			requestAnimationFrame(Controller.frameRateMeasure);
 		}
@@ -827,14 +880,17 @@ This file is part of LifeViewer
 			// get the next viewer
 			currentViewer = this.viewers[i][1];
 
-			// reset the viewer
-			currentViewer.playList.current = currentViewer.viewPlayList(ViewConstants.modeReset, true, currentViewer);
+			// skip viewers released while far off screen since they reset when they restart
+			if (!currentViewer.released) {
+				// reset the viewer
+				currentViewer.playList.current = currentViewer.viewPlayList(ViewConstants.modeReset, true, currentViewer);
 
-			// ensure updates happen
-			currentViewer.menuManager.setAutoUpdate(true);
+				// ensure updates happen
+				currentViewer.menuManager.setAutoUpdate(true);
 
-			// increment number of viewers reset
-			result += 1;
+				// increment number of viewers reset
+				result += 1;
+			}
 		}
 
 		// return number of viewers reset
@@ -896,6 +952,29 @@ This file is part of LifeViewer
 		return result;
 	};
 
+	// discard a temporary pattern manager releasing its arena once it has no repository requests outstanding
+	Controller.discardManager = function(/** @type {PatternManager} */ manager) {
+		this.discardedManagers[this.discardedManagers.length] = manager;
+		this.releaseDiscardedManagers();
+	};
+
+	// release the arenas of discarded pattern managers that have no repository requests outstanding
+	Controller.releaseDiscardedManagers = function() {
+		var	/** @type {number} */ i = 0,
+			/** @type {PatternManager} */ manager = null;
+
+		while (i < this.discardedManagers.length) {
+			manager = this.discardedManagers[i];
+			if (RuleTreeCache.hasRequestsFrom(manager)) {
+				i += 1;
+			} else {
+				manager.allocator.unregisterOwner(manager);
+				WASM.allocator.releaseArena(manager.allocator);
+				this.discardedManagers.splice(i, 1);
+			}
+		}
+	};
+
 	// initialize bit counts
 	Controller.initBitCounts = function() {
 		var	/** @type {number} */ i,
@@ -989,6 +1068,9 @@ This file is part of LifeViewer
 		// WASM memory reset point after initial construction
 		/** @type {number} */ this.wasmResetPoint = 0;
 
+		// whether the engine arena has been released because the viewer is far off screen
+		/** @type {boolean} */ this.released = false;
+
 		// pattern comments
 		/** @type {string} */ this.patternComments = "";
 
@@ -5022,6 +5104,9 @@ This file is part of LifeViewer
 			// whether the pattern needs clipping along a row
 			/** @type {boolean} */ needsClipping = true;
 
+		// the pattern is written directly to the colour grid
+		this.engine.invalidateDerivedGrids();
+
 		// check for bounded grid
 		if (this.engine.boundedGridType !== -1) {
 			// check if pattern is inside bounded grid
@@ -5997,10 +6082,24 @@ This file is part of LifeViewer
 	View.prototype.drawStars = function() {
 		var	/** @type {number} */ displayWidth = this.engine.displayWidth,
 			/** @type {number} */ displayHeight = this.engine.displayHeight,
-			/** @type {Uint32Array} */ data32 = this.engine.data32;
+			/** @type {Uint32Array} */ data32 = this.engine.data32,
+			/** @type {number} */ timing = performance.now(),
+			/** @type {boolean} */ useWASM = Controller.useWASM && Controller.wasmEnableStarsAndSnow && this.wasmEnabled && data32.buffer === WASM.memory.buffer;
 
 		// draw the starfield
-		this.starField.create2D(this.engine.width / 2 - this.engine.camXOff, this.engine.height / 2 - this.engine.camYOff, this.engine.camZoom, this.engine.camAngle, displayWidth, displayHeight, data32, this.engine.pixelColours[0]);
+		if (useWASM) {
+			// copying the stars may grow the heap so get the display buffer again afterwards
+			this.starField.allocateWASM();
+			data32 = this.engine.data32;
+			this.starField.create2DWASM(this.engine.width / 2 - this.engine.camXOff, this.engine.height / 2 - this.engine.camYOff, this.engine.camZoom, this.engine.camAngle, displayWidth, displayHeight, data32, this.engine.pixelColours[0]);
+		} else {
+			this.starField.create2D(this.engine.width / 2 - this.engine.camXOff, this.engine.height / 2 - this.engine.camYOff, this.engine.camZoom, this.engine.camAngle, displayWidth, displayHeight, data32, this.engine.pixelColours[0]);
+		}
+
+		if (Controller.wasmTiming) {
+			timing = performance.now() - timing;
+			this.menuManager.updateTimingItem("drawStars", timing, useWASM);
+		}
 	};
 
 	// read a single cell state
@@ -8550,13 +8649,40 @@ This file is part of LifeViewer
 
 	// create RuleLoader Lookup
 	View.prototype.createRuleLoaderLookup = function() {
+		var	/** @type {View} */ me = this,
+			/** @type {string} */ key = RuleLoaderLookupCache.getKey(this.engine);
+
+		// remember which rule the lookup is for
+		this.engine.ruleLoaderLookupKey = key;
+
+		// check if the lookup was already built on this page
+		if (RuleLoaderLookupCache.get(key, this.engine)) {
+			return;
+		}
+
+		// check persistent storage and only build if not found (the standard lookup is used meanwhile)
+		RuleLoaderLookupCache.fetch(key, this.engine.ruleLoaderLookupCheck, function(/** @type {boolean} */ found) {
+			// ignore if the rule changed while waiting
+			if (me.engine.ruleLoaderLookupKey === key) {
+				if (!(found && RuleLoaderLookupCache.get(key, me.engine))) {
+					me.buildRuleLoaderLookup();
+				}
+				me.menuManager.updateCount = 10;
+			}
+		});
+	};
+
+	// build RuleLoader Lookup
+	View.prototype.buildRuleLoaderLookup = function() {
 		// check for Moore with 3 bits since it is slow to generate and needs to be done in steps
 		if (this.engine.ruleTableOutput !== null && this.engine.ruleTableNeighbourhood === PatternConstants.ruleTableMoore && this.engine.multiNumStates > 4) {
 			// reset to first init step
 			this.engine.ruleLoaderStep = 0;
+			this.menuManager.setAutoUpdate(true);
 		} else {
 			// normal case so process now
 			this.engine.createRuleLoaderLookup();
+			RuleLoaderLookupCache.add(this.engine.ruleLoaderLookupKey, this.engine);
 		}
 	};
 
@@ -8615,6 +8741,7 @@ This file is part of LifeViewer
 		if (me.engine.ruleLoaderStep === -1) {
 			me.engine.ruleLoaderGenerationTime = performance.now() - me.engine.ruleLoaderGenerationTime;
 			me.menuManager.updateCount = 10;
+			RuleLoaderLookupCache.add(me.engine.ruleLoaderLookupKey, me.engine);
 		}
 
 		// set the auto update mode
@@ -9172,6 +9299,11 @@ This file is part of LifeViewer
 	View.prototype.viewAnimate = function(/** @type {number} */ timeSinceLastUpdate, /** @type {View} */ me) {
 		var	/** @type {number} */ startTime = performance.now();
 
+		// skip an update already scheduled when the engine was released
+		if (me.released) {
+			return;
+		}
+
 		// enable stats if pending
 		if (me.pendingStatsOn) {
 			me.genToggle.current = me.viewStats([true], true, me);
@@ -14000,8 +14132,8 @@ This file is part of LifeViewer
 
 	// mouse wheel
 	View.prototype.wheel = function(/** @type {View} */ me, /** @type {WheelEvent} */ event) {
-		// check if the canvas has focus
-		if (me.menuManager.hasFocus) {
+		// check if the canvas has focus and the engine is not released
+		if (me.menuManager.hasFocus && !me.released) {
 			// update wheel position if not computing history
 			if (!me.computeHistory) {
 				me.wheelDelta = -event.deltaY;
@@ -18795,6 +18927,11 @@ This file is part of LifeViewer
 
 	// key up
 	View.prototype.keyUp = function(/** @type {View} */ me, /** @type {KeyboardEvent} */ event) {
+		// ignore keys while the engine is released
+		if (me.released) {
+			return;
+		}
+
 		KeyProcessor.shift = event.shiftKey;
 	};
 
@@ -18806,6 +18943,11 @@ This file is part of LifeViewer
 			// flag if key processed
 			/** @type {boolean} */ processed = false;
 
+		// ignore keys while the engine is released
+		if (me.released) {
+			return;
+		}
+
 		// check for photosensitivity dialog mode
 		if (me.confirmingPhotosensitivity) {
 			processed = KeyProcessor.processKeyPhoto(me, keyCode, event);
@@ -20119,6 +20261,9 @@ This file is part of LifeViewer
 			this.engine = new Life(this.mainContext, this.displayWidth, this.displayHeight, this.defaultGridWidth, this.defaultGridHeight, this.manager, this);
 			//console.timeEnd("new engine");
 
+			// decode patterns into the engine arena so they are freed with it
+			this.manager.allocator = this.engine.allocator;
+
 			//console.time("init engine");
 			this.engine.initEngine(this.mainContext, this.displayWidth, this.displayHeight);
 			//console.timeEnd("init engine");
@@ -20180,6 +20325,29 @@ This file is part of LifeViewer
 		return result;
 	};
 
+	// stop the viewer and return its engine arena to the heap while it is far off screen
+	View.prototype.releaseEngine = function() {
+		// pause the viewer
+		if (this.generationOn) {
+			this.playList.current = this.viewPlayList(ViewConstants.modePause, true, this);
+		}
+		this.menuManager.setAutoUpdate(false);
+
+		// release the engine, HROT and starfield memory
+		WASM.allocator.releaseArena(this.engine.allocator);
+		this.released = true;
+	};
+
+	// rebuild the engine of a released viewer (as in attachToCanvas)
+	View.prototype.rebuildEngine = function() {
+		this.engine = new Life(this.mainContext, this.displayWidth, this.displayHeight, this.defaultGridWidth, this.defaultGridHeight, this.manager, this);
+		this.manager.allocator = this.engine.allocator;
+		this.engine.initEngine(this.mainContext, this.displayWidth, this.displayHeight);
+		this.starField = new Stars(ViewConstants.numStars, this.engine.allocator);
+		this.engine.createColourThemes();
+		this.released = false;
+	};
+
 	// get theme name from a number
 	/** @returns {string} */
 	View.prototype.themeName = function(/** @type {number} */ themeNumber) {
@@ -20965,6 +21133,7 @@ This file is part of LifeViewer
 		this.engine.isRuleTree = false;
 		this.engine.ruleTreeA = null;
 		this.engine.ruleTreeB = null;
+		this.engine.ruleTreeCache = null;
 		this.engine.ruleTreeColours = null;
 		this.engine.ruleTableIcons = null;
 		this.engine.ruleTableLUT = [];
@@ -21444,6 +21613,7 @@ This file is part of LifeViewer
 				me.engine.ruleTreeBase = pattern.ruleTreeBase;
 				me.engine.ruleTreeA = pattern.ruleTreeA;
 				me.engine.ruleTreeB = pattern.ruleTreeB;
+				me.engine.ruleTreeCache = null;
 				me.engine.ruleTreeColours = pattern.ruleTreeColours;
 				me.engine.ruleTableIcons = pattern.ruleTableIcons;
 				me.stateNames = pattern.ruleTableNames;
@@ -23025,6 +23195,14 @@ This file is part of LifeViewer
 		setTimeout(resizeWindow);
 	};
 
+	// give a canvas the next viewer id unless it already has one
+	function assignViewId(/** @type {HTMLCanvasElement} */ canvasItem) {
+		if (!canvasItem.dataset.viewId) {
+			Controller.numViewIds += 1;
+			canvasItem.dataset.viewId = String(Controller.numViewIds);
+		}
+	}
+
 	// start a viewer
 	function startView(/** @type {string} */ patternString, /** @type {HTMLCanvasElement} */ canvasItem, /** @type {number} */ maxWidth, /** @type {boolean} */ isInPopup, element) {
 		var	/** @type {number} */ i = 0,
@@ -23065,7 +23243,7 @@ This file is part of LifeViewer
 
 			// add a tab index to the canvas
 			canvasItem.tabIndex = 0;
-			canvasItem.dataset.viewId = String(Controller.viewers.length + 1);
+			assignViewId(canvasItem);
 
 			// wrap it in a popup window if hidden
 			if (parentItem.style.display === "none") {
@@ -23081,6 +23259,12 @@ This file is part of LifeViewer
 
 			// add the view to the list
 			Controller.viewers[Controller.viewers.length] = [canvasItem, newView, Controller.popupWindow];
+		} else {
+			// rebuild the engine if the viewer was released while far off screen
+			if (newView.released) {
+				newView.rebuildEngine();
+				newView.viewStart(newView);
+			}
 		}
 
 		if (Controller.useWASM) {
@@ -23101,6 +23285,91 @@ This file is part of LifeViewer
 		//console.groupEnd();
 	}
 
+	// start the deferred embedded viewer for a canvas if there is one
+	function startLazyView(canvasItem) {
+		var	/** @type {number} */ i = 0,
+			/** @type {Array} */ pending = null;
+
+		for (i = 0; i < Controller.lazyViews.length; i += 1) {
+			pending = Controller.lazyViews[i];
+			if (pending !== null && pending[0] === canvasItem) {
+				Controller.lazyViews[i] = null;
+				Controller.lazyObserver.unobserve(canvasItem);
+				startView(pending[1], pending[0], pending[2], false, pending[3]);
+
+				// release the viewer again if it moves far off screen
+				Controller.releaseObserver.observe(canvasItem);
+				break;
+			}
+		}
+	}
+
+	// start any deferred embedded viewers that have scrolled near the visible area
+	function lazyViewCallback(/** @type {Array<IntersectionObserverEntry>} */ entries) {
+		var	/** @type {number} */ i = 0;
+
+		for (i = 0; i < entries.length; i += 1) {
+			if (entries[i].isIntersecting) {
+				startLazyView(entries[i].target);
+			}
+		}
+	}
+
+	// release an embedded viewer that has moved far off screen and defer restarting it until it scrolls back
+	function releaseLazyView(canvasItem) {
+		var	/** @type {View} */ view = Controller.findViewerByCanvas(canvasItem.dataset.viewId);
+
+		// skip viewers already released, waiting for rule repository requests, or whose state would be lost on restart
+		// (playing, stepped past the first generation, edited or moved by the user)
+		if (view !== null && !view.released && !RuleTreeCache.hasRequestsFrom(view.manager) &&
+			!view.generationOn && view.engine.counter === 0 && view.numEdits === 0 && !view.manualChange) {
+			view.releaseEngine();
+			Controller.releaseObserver.unobserve(canvasItem);
+			Controller.lazyViews[Controller.lazyViews.length] = [canvasItem, cleanPattern(view.element), view.element.offsetWidth, view.element];
+			Controller.lazyObserver.observe(canvasItem);
+		}
+	}
+
+	// release any started embedded viewers that have moved far outside the visible area
+	function releaseViewCallback(/** @type {Array<IntersectionObserverEntry>} */ entries) {
+		var	/** @type {number} */ i = 0;
+
+		for (i = 0; i < entries.length; i += 1) {
+			if (!entries[i].isIntersecting) {
+				releaseLazyView(entries[i].target);
+			}
+		}
+	}
+
+	// start an embedded viewer now or defer it until it scrolls near the visible area
+	/** @returns {boolean} */
+	function startEmbeddedView(/** @type {string} */ patternString, /** @type {HTMLCanvasElement} */ canvasItem, /** @type {number} */ maxWidth, textItem) {
+		var	/** @type {boolean} */ deferred = false;
+
+		// assign the viewer id now so ids follow page order rather than scroll order
+		assignViewId(canvasItem);
+
+		// full screen and popup viewers always start immediately
+		if (!DocConfig.fullScreen && canvasItem.parentNode.style.display !== "none") {
+			if (Controller.lazyObserver === null && typeof IntersectionObserver !== "undefined") {
+				Controller.lazyObserver = new IntersectionObserver(lazyViewCallback, {"rootMargin": ViewConstants.lazyStartMargin});
+				Controller.releaseObserver = new IntersectionObserver(releaseViewCallback, {"rootMargin": ViewConstants.lazyReleaseMargin});
+			}
+
+			if (Controller.lazyObserver !== null) {
+				Controller.lazyViews[Controller.lazyViews.length] = [canvasItem, patternString, maxWidth, textItem];
+				Controller.lazyObserver.observe(canvasItem);
+				deferred = true;
+			}
+		}
+
+		if (!deferred) {
+			startView(patternString, canvasItem, maxWidth, false, textItem);
+		}
+
+		return deferred;
+	}
+
 	// read LifeViewer settings from meta tag if present
 	function readSettingsFromMeta() {
 		// search for the LifeViewer meta tag
@@ -23295,6 +23564,8 @@ This file is part of LifeViewer
 
 		// find the View attached to this canvas
 		if (canvasItem) {
+			// start the viewer first if it was deferred
+			startLazyView(canvasItem);
 			viewer = Controller.findViewerByCanvas(canvasItem.dataset.viewId);
 			if (viewer) {
 				// reset the HROT bounding box so fit zoom works correctly
@@ -23426,6 +23697,13 @@ This file is part of LifeViewer
 			// reset the view
 			view = viewer[1];
 			view.element = textItem;
+
+			// free the previous pattern from the viewer arena (as in updateMe)
+			view.engine.HROT.ncols = 0;
+			view.lastIdentifyType = "";
+			view.engine.countList = null;
+			view.engine.allocator.reset(view.wasmResetPoint);
+
 			view.viewStart(view);
 			view.engine.historyBox.set(view.engine.zoomBox);
 		} else {
@@ -23734,6 +24012,31 @@ This file is part of LifeViewer
 		return result;
 	}
 
+	// add the show in viewer anchor to a valid code box pattern
+	function showPatternAnchor(/** @type {string} */ patternString, rleItem, textItem) {
+		// create the anchor if specified
+		if (rleItem !== null) {
+			createAnchor(rleItem, textItem);
+		}
+
+		// check whether to limit the height of the text item
+		if (DocConfig.patternSourceMaxHeight > -1 && patternString.indexOf("@RULE") === -1) {
+			if (textItem.clientHeight > DocConfig.patternSourceMaxHeight + 26) {
+				textItem.style.height = (DocConfig.patternSourceMaxHeight + 26) + "px";
+			}
+		}
+	}
+
+	// add the show pattern error anchor to an invalid code box pattern
+	function showPatternError(/** @type {string} */ patternText, rleItem, textItem, /** @type {string} */ message) {
+		if (rleItem !== null) {
+			// ignore patterns that look like python code
+			if (!(patternText[0] === "#" && patternText.indexOf("import ") !== -1)) {
+				createError(rleItem, textItem, message);
+			}
+		}
+	}
+
 	// complete isPattern check
 	function completeIsPattern(/** @type {Pattern} */ pattern, /** @type {Array} */ args) {
 		// unpack arguments
@@ -23764,17 +24067,7 @@ This file is part of LifeViewer
 					rleItem.style.display = "none";
 				}
 			} else {
-				// create the anchor if specified
-				if (rleItem !== null) {
-					createAnchor(rleItem, textItem);
-				}
-
-				// check whether to limit the height of the text item
-				if (DocConfig.patternSourceMaxHeight > -1 && patternString.indexOf("@RULE") === -1) {
-					if (textItem.clientHeight > DocConfig.patternSourceMaxHeight + 26) {
-						textItem.style.height = (DocConfig.patternSourceMaxHeight + 26) + "px";
-					}
-				}
+				showPatternAnchor(patternString, rleItem, textItem);
 			}
 		}
 	}
@@ -23787,12 +24080,7 @@ This file is part of LifeViewer
 			textItem = args[2];
 
 		if (pattern) {
-			if (rleItem !== null) {
-				// ignore patterns that look like python code
-				if (!(patternText[0] === "#" && patternText.indexOf("import ") !== -1)) {
-					createError(rleItem, textItem, pattern.ruleName + " - " + pattern.originalFailure + "\n\n" + pattern.manager.failureReason);
-				}
-			}
+			showPatternError(patternText, rleItem, textItem, pattern.ruleName + " - " + pattern.originalFailure + "\n\n" + pattern.manager.failureReason);
 		}
 	}
 
@@ -23814,6 +24102,140 @@ This file is part of LifeViewer
 		}
 	}
 
+	// send a pattern check result to the main thread (runs in the worker)
+	function postPatternCheck(/** @type {number} */ id, /** @type {number} */ result, /** @type {string} */ message) {
+		self.postMessage({"id": id, "result": result, "message": message});
+	}
+
+	// worker pattern check complete (result 1 for valid, 0 for not a pattern)
+	function completeWorkerCheck(/** @type {Pattern} */ pattern, /** @type {Array} */ args) {
+		postPatternCheck(args[0], (pattern && pattern.lifeMap && !pattern.tooBig) ? 1 : 0, "");
+	}
+
+	// worker pattern check failed (result 2 with the error message)
+	function completeWorkerCheckFailed(/** @type {Pattern} */ pattern, /** @type {Array} */ args) {
+		if (pattern) {
+			postPatternCheck(args[0], 2, pattern.ruleName + " - " + pattern.originalFailure + "\n\n" + pattern.manager.failureReason);
+		} else {
+			postPatternCheck(args[0], 0, "");
+		}
+	}
+
+	// check a batch of code box patterns sent from the main thread (runs in the worker)
+	function patternWorkerMessage(/** @type {MessageEvent} */ event) {
+		var	data = event.data,
+			/** @type {Array<string>} */ checks = data["checks"],
+			/** @type {number} */ first = data["first"],
+			/** @type {number} */ i = 0,
+			/** @type {Allocator} */ allocator = WASM.allocator,
+			/** @type {PatternManager} */ manager = Controller.patternWorkerManager,
+			/** @type {Pattern} */ pattern = null;
+
+		// initialise on the first batch
+		if (manager === null) {
+			DocConfig.repositoryLocation = data["repository"];
+			DocConfig.rulePostfix = data["postfix"];
+			AliasManager.init();
+			Controller.initBitCounts();
+			manager = new PatternManager(allocator);
+			Controller.patternWorkerManager = manager;
+		}
+
+		for (i = 0; i < checks.length; i += 1) {
+			pattern = manager.create("", checks[i], allocator, completeWorkerCheck, completeWorkerCheckFailed, [first + i], true, null);
+			if (!manager.loadingFromRepository) {
+				if (pattern) {
+					if (pattern.invalid) {
+						pattern.originalFailure = manager.failureReason;
+						completeWorkerCheckFailed(pattern, [first + i]);
+					} else {
+						completeWorkerCheck(pattern, [first + i]);
+					}
+				} else {
+					postPatternCheck(first + i, 0, "");
+				}
+			}
+		}
+	}
+
+	// apply a pattern check result from the worker
+	function patternWorkerReply(/** @type {MessageEvent} */ event) {
+		var	data = event.data,
+			/** @type {number} */ id = data["id"],
+			/** @type {Array} */ check = Controller.patternChecks[id];
+
+		if (check) {
+			Controller.patternChecks[id] = null;
+			if (data["result"] === 1) {
+				showPatternAnchor(check[0], check[1], check[2]);
+			} else {
+				if (data["result"] === 2) {
+					showPatternError(check[0], check[1], check[2], data["message"]);
+				}
+			}
+		}
+	}
+
+	// stop the worker and check any outstanding patterns on the main thread
+	function patternWorkerFailed(/** @type {Event} */ event) {
+		var	/** @type {number} */ i = 0,
+			/** @type {Array} */ check = null,
+			/** @type {Allocator} */ allocator = WASM.allocator.createArena("PatternCheck"),
+			/** @type {PatternManager} */ manager = new PatternManager(allocator);
+
+		console.log("Pattern check worker failed, checking on main thread");
+		if (Controller.patternWorker) {
+			Controller.patternWorker.terminate();
+			Controller.patternWorker = null;
+		}
+
+		for (i = 0; i < Controller.patternChecks.length; i += 1) {
+			check = Controller.patternChecks[i];
+			if (check) {
+				Controller.patternChecks[i] = null;
+				isPattern(check[0], allocator, manager, check[1], check[2], null);
+			}
+		}
+		Controller.discardManager(manager);
+
+		// prevent the default error reporting
+		if (event) {
+			event.preventDefault();
+		}
+	}
+
+	// start the pattern check worker from this script
+	/** @returns {boolean} */
+	function startPatternWorker() {
+		if (scriptURL !== "" && typeof Worker !== "undefined") {
+			try {
+				Controller.patternWorker = new Worker(scriptURL);
+				registerEvent(Controller.patternWorker, "message", patternWorkerReply, false);
+				registerEvent(Controller.patternWorker, "error", patternWorkerFailed, false);
+			} catch (e) {
+				Controller.patternWorker = null;
+			}
+		}
+
+		return Controller.patternWorker !== null;
+	}
+
+	// send queued pattern checks to the worker
+	function sendPatternChecks(/** @type {Array<string>} */ checks, /** @type {number} */ first) {
+		var	/** @type {string} */ repository = DocConfig.repositoryLocation;
+
+		// resolve the repository against the page since the worker resolves against the script
+		if (repository !== "") {
+			try {
+				repository = new URL(repository, document.baseURI).href;
+			} catch (e) {
+				// leave unchanged
+			}
+		}
+
+		Controller.patternWorker.postMessage({"checks": checks, "first": first, "repository": repository, "postfix": DocConfig.rulePostfix});
+	}
+
 	// callback for fullscreen toggle anchor
 	function fullScreenCallback(/** @type {PointerEvent} */ event) {
 		var	/** @type {Array} */ viewer = Controller.standaloneViewer(),
@@ -23888,8 +24310,12 @@ This file is part of LifeViewer
 		} else {
 			for (i = 0; i < Controller.viewers.length; i += 1) {
 				view = Controller.viewers[i][1];
-				view.resize();
-				view.menuManager.setAutoUpdate(true);
+
+				// released viewers are resized when they restart
+				if (!view.released) {
+					view.resize();
+					view.menuManager.setAutoUpdate(true);
+				}
 			}
 		}
 	}
@@ -23957,13 +24383,18 @@ This file is part of LifeViewer
 			/** @type {Element} */ build = null,
 			/** @type {Element} */ canvasElement = null,
 			/** @type {number} */ embeddedReads = 0,
+			/** @type {number} */ deferredReads = 0,
 			/** @type {number} */ popupReads = 0,
 			/** @type {number} */ unsafe = 0,
 			/** @type {number} */ scanTime = performance.now(),
 			/** @type {boolean} */ safeMode = Controller.loadBooleanSetting(ViewConstants.safeModeSettingName),
 
-			// temporary allocator and pattern manager
-			/** @type {Allocator} */ allocator = WASM.allocator,
+			// code box checks to run after the scan (pattern text, rle div and text item)
+			/** @type {Array} */ popupChecks = [],
+			/** @type {Array<string>} */ popupTexts = [],
+
+			// temporary arena and pattern manager (released after the scan)
+			/** @type {Allocator} */ allocator = WASM.allocator.createArena("PageScan"),
 			/** @type {PatternManager} */ manager = new PatternManager(allocator);
 
 		console.time("page scan");
@@ -24020,9 +24451,11 @@ This file is part of LifeViewer
 								}
 							}
 
-							// initalise viewer not in popup
+							// initalise viewer not in popup (deferred until visible if possible)
 							canvasItem.contentEditable = "false";
-							startView(cleanItem, canvasItem, textItem.offsetWidth, false, textItem);
+							if (startEmbeddedView(cleanItem, canvasItem, textItem.offsetWidth, textItem)) {
+								deferredReads += 1;
+							}
 						} else {
 							// hide the canvas item
 							if (DocConfig.hide && canvasItem) {
@@ -24060,7 +24493,12 @@ This file is part of LifeViewer
 									anchorItem = null;
 
 									// check if the contents is a valid pattern (will add to Controller if in multiverse mode)
-									isPattern(cleanItem, allocator, manager, rleItem, textItem, null);
+									if (DocConfig.multi) {
+										isPattern(cleanItem, allocator, manager, rleItem, textItem, null);
+									} else {
+										// defer so the checks can run in the worker
+										popupChecks[popupChecks.length] = [cleanItem, rleItem, textItem];
+									}
 								}
 
 								console.timeEnd("read popup");
@@ -24072,6 +24510,24 @@ This file is part of LifeViewer
 			}
 		}
 
+		// check code box patterns in the worker if it can be started, otherwise on the main thread
+		if (popupChecks.length > 0) {
+			if (Controller.patternWorker !== null || startPatternWorker()) {
+				for (i = 0; i < popupChecks.length; i += 1) {
+					popupTexts[i] = popupChecks[i][0];
+				}
+				sendPatternChecks(popupTexts, Controller.patternChecks.length);
+				Controller.patternChecks = Controller.patternChecks.concat(popupChecks);
+			} else {
+				for (i = 0; i < popupChecks.length; i += 1) {
+					isPattern(popupChecks[i][0], allocator, manager, popupChecks[i][1], popupChecks[i][2], null);
+				}
+			}
+		}
+
+		// release the temporary pattern manager once any repository requests complete
+		Controller.discardManager(manager);
+
 		// remove accesskey elements that conflict with LifeViewer
 		anchorList = document.getElementsByTagName("a");
 
@@ -24129,7 +24585,7 @@ This file is part of LifeViewer
 		}
 
 		console.timeEnd("page scan");
-		console.log(embeddedReads + " embedded and " + popupReads + " popup (" + unsafe + " unsafe)");
+		console.log(embeddedReads + " embedded (" + deferredReads + " deferred) and " + popupReads + " popup (" + unsafe + " unsafe)");
 
 		if (DocConfig.multi) {
 			// switch to overview mode
@@ -24163,44 +24619,199 @@ This file is part of LifeViewer
 
 	console.group("LifeViewer");
 
-	// check if WASM is included in this build
-	if (wasmBase64.length > 0) {
-		// load webassembly from base64 string
-		var wasmString = atob(wasmBase64);
-		var wasmBuffer = new  Uint8Array(wasmString.length);
-		for (var i = 0; i < wasmString.length; i += 1) {
-			wasmBuffer[i] = wasmString.charCodeAt(i);
+	// decode a base64 string into bytes
+	/** @returns {Uint8Array} */
+	function decodeBase64(/** @type {string} */ source) {
+		var	/** @type {Uint8Array} */ lookup = new Uint8Array(128),
+			/** @type {string} */ alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+			/** @type {number} */ length = source.length,
+			/** @type {number} */ size = 0,
+			/** @type {Uint8Array} */ result = null,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {number} */ value = 0;
+
+		// ignore padding
+		while (length > 0 && source.charCodeAt(length - 1) === 61) {
+			length -= 1;
 		}
+		size = (length * 3) >> 2;
+		result = new Uint8Array(size);
 
-		var startTime = performance.now();
+		// create the character lookup
+		for (i = 0; i < 64; i += 1) {
+			lookup[alphabet.charCodeAt(i)] = i;
+		}
 
-		WebAssembly.instantiate(wasmBuffer)
-			.then(result => {
-			var	/** @type {number} */ count = 0,
-				/** @type {string} */ i = "";
+		// decode complete groups of 4 characters into 3 bytes
+		i = 0;
+		while (j + 3 <= size) {
+			value = (lookup[source.charCodeAt(i)] << 18) | (lookup[source.charCodeAt(i + 1)] << 12) | (lookup[source.charCodeAt(i + 2)] << 6) | lookup[source.charCodeAt(i + 3)];
+			result[j] = value >> 16;
+			result[j + 1] = value >> 8;
+			result[j + 2] = value;
+			i += 4;
+			j += 3;
+		}
 
-			// get a reference to each function
-			for (i in result.instance.exports) {
-				if (typeof result.instance.exports[i] === "function") {
-					if (!i.startsWith("_") && !i.startsWith("emscripten")) {
-						WASM[i] = result.instance.exports[i];
-						count += 1;
-					}
+		// decode any final partial group
+		if (j < size) {
+			value = (lookup[source.charCodeAt(i)] << 18) | (lookup[source.charCodeAt(i + 1)] << 12);
+			if (i + 2 < length) {
+				value |= lookup[source.charCodeAt(i + 2)] << 6;
+			}
+			result[j] = value >> 16;
+			if (j + 1 < size) {
+				result[j + 1] = value >> 8;
+			}
+		}
+
+		return result;
+	}
+
+	// get the URL of the separate WASM asset if one was specified
+	/** @returns {string} */
+	function getWASMURL() {
+		var	/** @type {string} */ result = wasmURL,
+			/** @type {Element} */ script = isWorker ? null : document.currentScript,
+			/** @type {string|null} */ attribute = null;
+
+		// a data-wasm attribute on the LifeViewer script element overrides the build setting
+		if (script) {
+			attribute = script.getAttribute("data-wasm");
+			if (attribute !== null) {
+				result = attribute;
+			}
+		}
+
+		return result;
+	}
+
+	// get the URL of this script so it can be started as the pattern check worker
+	/** @returns {string} */
+	function getScriptURL() {
+		var	/** @type {string} */ result = "",
+			/** @type {HTMLScriptElement} */ script = null;
+
+		// inline scripts have no source so the worker is not available
+		if (!isWorker) {
+			script = /** @type {HTMLScriptElement} */ (document.currentScript);
+			if (script && script.src) {
+				result = script.src;
+			}
+		}
+
+		return result;
+	}
+
+	// set up the WASM interface from an instance
+	function useWASMInstance(/** @type {WebAssembly.Instance} */ instance, /** @type {number} */ bytes, /** @type {string} */ source, /** @type {number} */ startTime) {
+		var	/** @type {number} */ count = 0,
+			/** @type {string} */ i = "";
+
+		// get a reference to each function
+		for (i in instance.exports) {
+			if (typeof instance.exports[i] === "function") {
+				if (!i.startsWith("_") && !i.startsWith("emscripten")) {
+					WASM[i] = instance.exports[i];
+					count += 1;
 				}
 			}
+		}
+
+		// get the heap
+		WASM.memory = instance.exports.memory;
+
+		// output stats
+		console.log("WebAssembly instantiated from " + source + ": " + count + " functions (" + bytes + " bytes), " + (WASM.memory.buffer.byteLength >> 20) + "Mb heap, time " + (performance.now() - startTime).toFixed(1) + "ms");
+	}
+
+	// disable WASM after a load failure
+	function failWASM(e) {
+		console.error("Error instantiating WebAssembly: ", e);
+		Controller.wasmError = String(e);
+		Controller.useWASM = false;
+		Controller.wasmTiming = false;
+	}
 
-			// get the heap
-			WASM.memory = result.instance.exports.memory;
+	// mark WASM loading complete and start viewers if they were waiting
+	function finishWASM() {
+		Controller.wasmLoading = false;
+		if (Controller.startPending) {
+			Controller.startPending = false;
+			setTimeout(startAllViewers, 0);
+		}
+	}
 
-			// output stats
-			console.log("WebAssembly instantiated: " + count + " functions (" + wasmBuffer.length + " bytes), " + (WASM.memory.buffer.byteLength >> 20) + "Mb heap, time " + (performance.now() - startTime).toFixed(1) + "ms");
-		})
-		.catch(e => {  // handle errors during instantiation
-			console.error("Error instantiating WebAssembly: ", e);
-			Controller.wasmError = String(e)
-			Controller.useWASM = false;
-			Controller.wasmTiming = false;
+	// compile (once) and instantiate WASM from bytes
+	/** @returns {Promise} */
+	function instantiateWASMBytes(/** @type {Uint8Array} */ bytes, /** @type {string} */ source, /** @type {number} */ startTime) {
+		return WebAssembly.compile(bytes).then(function(/** @type {WebAssembly.Module} */ module) {
+			WASM.module = module;
+			return WebAssembly.instantiate(module, wasmImports);
+		}).then(function(/** @type {WebAssembly.Instance} */ instance) {
+			useWASMInstance(instance, bytes.length, source, startTime);
 		});
+	}
+
+	// the heap starts small and grows on demand so provide the growth notification import
+	var wasmImports = {"env": {"emscripten_notify_memory_growth": function() {}}};
+
+	// check whether running as the pattern check worker
+	var isWorker = (typeof document === "undefined");
+
+	// URL of this script (must be read while the script is executing)
+	var scriptURL = getScriptURL();
+
+	// check if WASM is included in this build or available as a separate asset
+	var wasmAsset = getWASMURL();
+
+	if (isWorker) {
+		// the worker only checks patterns so does not need WASM
+		Controller.useWASM = false;
+		Controller.wasmTiming = false;
+		registerEvent(self, "message", patternWorkerMessage, false);
+	} else if (wasmAsset !== "" || wasmBase64.length > 0) {
+		var startTime = performance.now();
+		var wasmLoad = null;
+
+		Controller.wasmLoading = true;
+
+		if (wasmAsset !== "") {
+			// compile the separate asset while it downloads, keeping the compiled module for reuse
+			if (WebAssembly.compileStreaming) {
+				wasmLoad = WebAssembly.compileStreaming(fetch(wasmAsset)).then(function(/** @type {WebAssembly.Module} */ module) {
+					WASM.module = module;
+					return WebAssembly.instantiate(module, wasmImports);
+				}).then(function(/** @type {WebAssembly.Instance} */ instance) {
+					useWASMInstance(instance, 0, wasmAsset, startTime);
+				});
+			} else {
+				wasmLoad = Promise.reject(new Error("streaming compilation not supported"));
+			}
+
+			// fall back to a non-streaming fetch (e.g. wrong MIME type) and then to the embedded copy
+			wasmLoad = wasmLoad.catch(function() {
+				return fetch(wasmAsset).then(function(/** @type {Response} */ response) {
+					if (!response.ok) {
+						throw new Error("failed to fetch " + wasmAsset + ": " + response.status);
+					}
+					return response.arrayBuffer();
+				}).then(function(/** @type {ArrayBuffer} */ buffer) {
+					return instantiateWASMBytes(new Uint8Array(buffer), wasmAsset, startTime);
+				});
+			});
+			if (wasmBase64.length > 0) {
+				wasmLoad = wasmLoad.catch(function() {
+					return instantiateWASMBytes(decodeBase64(wasmBase64), "base64", startTime);
+				});
+			}
+		} else {
+			// single file build so decode the embedded copy
+			wasmLoad = instantiateWASMBytes(decodeBase64(wasmBase64), "base64", startTime);
+		}
+
+		wasmLoad.catch(failWASM).then(finishWASM);
 	} else {
 		// not built with WASM
 		Controller.useWASM = false;
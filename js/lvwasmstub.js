@@ -1,4 +1,5 @@
 var wasmBase64 = "";
+var wasmURL = "";
 var WASM = {
 	nextGenerationCornerEdge2: null,
 	nextGenerationCheckerBoth2: null,
@@ -51,8 +52,10 @@ var WASM = {
 	cumulativeVNCountsN: null,
 	updateOccupancyStrict: null,
 	updateOccupancyStrictSuperOrRuleLoader: null,
+	updateOccupancyStrictExtended: null,
 	updateCellCounts: null,
 	updateCellCountsSuperOrRuleTree: null,
+	updateCellCountsExtended: null,
 	getHashTwoState: null,
 	getHashSuper: null,
 	getHashLifeHistory: null,
@@ -75,10 +78,12 @@ var WASM = {
 	nextGenerationInvestigatorMoore: null,
 	nextGenerationInvestigatorHex: null,
 	nextGenerationInvestigatorVN: null,
+	nextGenerationInvestigatorBitSliced: null,
 	nextGenerationSuperMoore: null,
 	nextGenerationSuperHex: null,
 	nextGenerationSuperVN: null,
 	nextGenerationGenerations: null,
+	nextGenerationGenerationsBitSliced: null,
 	nextGenerationRuleTreeMoore: null,
 	nextGenerationRuleTreeMoorePartial4: null,
 	nextGenerationRuleLoaderMooreLookup1: null,
@@ -96,14 +101,36 @@ var WASM = {
 	nextGenerationRuleLoaderHexLookup1: null,
 	nextGenerationRuleLoaderHexLookup2: null,
 	nextGenerationRuleLoaderHexLookup3: null,
+	nextGenerationMargolus: null,
+	nextGenerationPCA: null,
+	nextGenerationTriangularLife: null,
+	nextGenerationWolfram1D: null,
+	nextGenerationRuleTable1D: null,
+	nextGenerationRuleLoaderBits: null,
 	renderGridNoClipNoRotate: null,
+	renderGridNoClipNoRotateInteger: null,
 	renderGridClipNoRotate: null,
 	renderOverlayNoClipNoRotate: null,
 	renderOverlayClipNoRotate: null,
+	renderHexCells: null,
+	renderTriangleCells: null,
+	renderIconGrid: null,
+	renderStars: null,
+	updateSnow: null,
 	resetColourGridNormal: null,
 	resetPopulationBit: null,
 	resetBoxesBit: null,
 	shrinkTileGrid: null,
+	scanRLE: null,
+	decodeRLECells: null,
+	encodeRLE: null,
+	packSnapshotData: null,
+	unpackSnapshotData: null,
+	saveGridTiles: null,
+	restoreGridTiles: null,
+	saveColourGridTiles: null,
+	restoreColourGridTiles: null,
+	module: null,
 	memory: null,
 	allocator: null
 };
\ No newline at end of file
@@ -1,5 +1,5 @@
 // Pattern decoder
-// Supports decoding various pattern formats: Cells, Life 1.05, Life 1.06, and RLE.
+// Supports decoding various pattern formats: Cells, Life 1.05, Life 1.06, Macrocell, and RLE.
 // Also handles fetching RuleTable rules from a remote repository.
 
 /*
@@ -114,6 +114,30 @@ This file is part of LifeViewer
 				Controller.viewers[0][1].initOverview();
 			}
 		}
+
+		// release any discarded pattern managers that were waiting for their requests
+		Controller.releaseDiscardedManagers();
+	};
+
+	// check if any outstanding requests were made by the given pattern manager
+	/** @returns {boolean} */
+	RuleTreeCache.hasRequestsFrom = function(/** @type {PatternManager} */ manager) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			request = null;
+
+		for (i = 0; i < this.requests.length; i += 1) {
+			request = this.requests[i];
+			if (request.name !== "") {
+				for (j = 0; j < request.pattern.length; j += 1) {
+					if (request.pattern[j].manager === manager) {
+						return true;
+					}
+				}
+			}
+		}
+
+		return false;
 	};
 
 	// remove a request from the cache
@@ -361,6 +385,18 @@ This file is part of LifeViewer
 	Life106 = {
 		// magic header
 		/** @const {string} */ magic : "#Life 1.06"
+	},
+
+	// Macrocell decoder
+	Macrocell = {
+		// magic header
+		/** @const {string} */ magic : "[M2]",
+
+		// level of 2-state 8x8 leaf nodes
+		/** @const {number} */ leafLevel : 3,
+
+		// maximum level for exact cell positions
+		/** @const {number} */ maxLevel : 52
 	};
 
 	// pattern constants
@@ -394,6 +430,7 @@ This file is part of LifeViewer
 		/** @type {number} */ this.time = 0;
 
 		/** @type {Allocator} */ this.allocator = allocator;
+		allocator.registerOwner(this);
 
 		/** @type {boolean} */ this.wolframEmulation = false;
 
@@ -820,6 +857,9 @@ This file is part of LifeViewer
 	function Pattern(/** @type {string} */ name, /** @type {PatternManager} */ manager) {
 		// allocator
 		/** @type {Allocator} */ this.allocator = manager.allocator;
+		if (this.allocator !== null) {
+			this.allocator.transientOwner = this;
+		}
 
 		// manager
 		/** @type {PatternManager} */ this.manager = manager;
@@ -6885,6 +6925,137 @@ This file is part of LifeViewer
 		return index;
 	};
 
+	// size and decode an RLE string using WASM
+	// returns the index after the bitmap, -1 if the pattern is invalid, or -2 if WASM was not used
+	/** @returns {number} */
+	PatternManager.prototype.decodeRLEWASM = function(/** @type {Pattern} */ pattern, /** @type {string} */ string, /** @type {Allocator} */ allocator, /** @type {boolean} */ checkOnly) {
+		var	/** @type {number} */ length = string.indexOf("!") + 1,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {Uint16Array} */ input = null,
+			/** @type {Uint32Array} */ stateCount = null,
+			/** @type {Uint32Array} */ result = null,
+			/** @type {Uint16Array} */ lifeMap = null,
+			/** @type {Uint8Array} */ stateMap = null,
+			/** @type {number} */ inputOffset = 0,
+			/** @type {number} */ code = 0,
+			/** @type {number} */ index = -1,
+			/** @type {number} */ width = 0,
+			/** @type {number} */ height = 0,
+			/** @type {number} */ words = 0,
+			/** @type {number} */ stateMode = 0,
+			/** @type {number} */ i = 0;
+
+		// the bitmap must end with ! for WASM to decode it
+		if (!(Controller.useWASM && Controller.wasmEnableDecodeRLE && WASM.memory !== null) || length === 0) {
+			return -2;
+		}
+
+		// copy the bitmap into temporary WASM buffers and then restore the heap pointer
+		heapPointer = allocator.getHeapPointer();
+		allocator.reserveHeap(length * 2 + 264 * 4 + 64);
+		input = /** @type {!Uint16Array} */ (allocator.allocate(Type.Uint16, length, "Pattern.rleInput", true));
+		stateCount = /** @type {!Uint32Array} */ (allocator.allocate(Type.Uint32, 256, "Pattern.rleStateCount", true));
+		result = /** @type {!Uint32Array} */ (allocator.allocate(Type.Uint32, 8, "Pattern.rleResult", true));
+		for (i = 0; i < length; i += 1) {
+			input[i] = string.charCodeAt(i);
+		}
+		stateCount.set(this.stateCount);
+		inputOffset = input.byteOffset;
+
+		// size the pattern
+		code = WASM.scanRLE(inputOffset, length, stateCount.byteOffset, result.byteOffset);
+		if (code === 1) {
+			// the ! was inside a comment so use the JS decoder
+			allocator.setHeapPointer(heapPointer);
+			return -2;
+		}
+
+		// save state counts
+		this.stateCount.set(stateCount);
+		pattern.numUsedStates += result[5];
+		pattern.maxStateRead = result[3] - 1;
+		if (result[3] > pattern.numStates) {
+			pattern.numStates = result[3];
+		}
+		if (result[4] !== 0) {
+			pattern.isSuper = true;
+			pattern.isNiemiec = true;
+		}
+
+		// check for errors
+		switch (code) {
+		case 2:
+			this.failureReason = "Leading zero in count";
+			pattern.invalid = true;
+			break;
+
+		case 3:
+			this.failureReason = PatternConstants.illegalWhitespace;
+			pattern.lifeMap = null;
+			pattern.invalid = true;
+			break;
+
+		case 4:
+			this.failureReason = "Illegal character in pattern: " + String.fromCharCode(result[6]);
+			pattern.invalid = true;
+			this.illegalState = true;
+			break;
+		}
+
+		// ensure pattern is at least one cell big so empty patterns are valid
+		width = result[1];
+		height = result[2];
+		if (width === 0) {
+			width = 1;
+			height = 1;
+		}
+		pattern.width = width;
+		pattern.height = height;
+
+		// check if small enough to save
+		if (width > this.maxWidth || height > this.maxHeight) {
+			pattern.tooBig = true;
+		}
+		pattern.patternFormat = "RLE";
+
+		// check if the pattern is valid
+		if (pattern.invalid) {
+			pattern.isSuper = false;
+			pattern.isNiemiec = false;
+		} else {
+			index = result[0];
+			pattern.lifeMap = [];
+
+			// decode the cells unless the pattern is too big or only being validated
+			if (!pattern.tooBig && !checkOnly) {
+				words = ((width - 1) >> 4) + 1;
+				pattern.lifeMap = Array.matrix(Type.Uint16, height, words, 0, allocator, "Pattern.lifeMap", false);
+				pattern.multiStateMap = Array.matrix(Type.Uint8, height, width, 0, allocator, "Pattern.multiStateMap", false);
+
+				// decode into temporary WASM grids and then copy them into the pattern maps
+				// (the pattern maps stay on the Javascript heap since patterns outlive the heap pointer restore below
+				// and may be decoded by temporary pattern managers sharing the global allocator)
+				allocator.reserveHeap(height * words * 2 + height * width + 64);
+				lifeMap = /** @type {!Uint16Array} */ (allocator.allocate(Type.Uint16, height * words, "Pattern.rleLifeMap", true));
+				stateMap = /** @type {!Uint8Array} */ (allocator.allocate(Type.Uint8, height * width, "Pattern.rleStateMap", true));
+				lifeMap.fill(0);
+				stateMap.fill(0);
+				if (pattern.multiNumStates === 2) {
+					stateMode = 1;
+				} else if (pattern.multiNumStates !== -1) {
+					stateMode = 2;
+				}
+				WASM.decodeRLECells(inputOffset, length, lifeMap.byteOffset, words, stateMap.byteOffset, width, stateMode, pattern.multiNumStates, LifeConstants.aliveStart,
+					(!(pattern.isHistory || pattern.isExtended || pattern.isSuper) || pattern.multiNumStates !== -1) ? 1 : 0, (pattern.isHistory || pattern.isSuper) ? 1 : 0);
+				pattern.lifeMap.whole.set(lifeMap);
+				pattern.multiStateMap.whole.set(stateMap);
+			}
+		}
+		allocator.setHeapPointer(heapPointer);
+
+		return index;
+	};
+
 	// decode a list into a pattern
 	PatternManager.prototype.decodeList = function(/** @type {Pattern} */ pattern, /** @type {Array<number>} */ list, /** @type {Allocator} */ allocator) {
 		// index of next list entry
@@ -6980,6 +7151,368 @@ This file is part of LifeViewer
 		}
 	};
 
+	// set a decoded cell in the pattern maps using the same state mapping as decodeList
+	PatternManager.prototype.setMacrocellCell = function(/** @type {Pattern} */ pattern, /** @type {number} */ x, /** @type {number} */ y, /** @type {number} */ stateNum, /** @type {boolean} */ writeBit) {
+		// save multi-state cell
+		if (pattern.multiNumStates === -1) {
+			pattern.multiStateMap[y][x] = stateNum;
+		} else {
+			// check for 2 state LTL or HROT
+			if (pattern.multiNumStates === 2) {
+				if (stateNum === 1) {
+					pattern.multiStateMap[y][x] = LifeConstants.aliveStart;
+				}
+			} else {
+				// check state is valid
+				if (stateNum < pattern.multiNumStates) {
+					pattern.multiStateMap[y][x] = stateNum;
+				} else {
+					pattern.multiStateMap[y][x] = 1;
+				}
+			}
+		}
+
+		// update 2d map if normal state 1, [R]History, [R]Extended or [R]Super odd states, Generations state 1
+		if ((writeBit && stateNum === 1) || ((pattern.isHistory || pattern.isSuper) && (stateNum & 1)) || (pattern.multiNumStates !== -1 && stateNum === 1)) {
+			pattern.lifeMap[y][x >> 4] |= 1 << (~x & 15);
+		}
+	};
+
+	// decode the node lines of a Macrocell pattern
+	// the quadtree is sized and counted without expanding it and then only occupied leaves are written to the pattern
+	/** @returns {number} */
+	PatternManager.prototype.decodeMacrocell = function(/** @type {Pattern} */ pattern, /** @type {string} */ string, /** @type {Allocator} */ allocator, /** @type {boolean} */ checkOnly) {
+		var	/** @type {number} */ length = string.length,
+			/** @type {number} */ maxNodes = 2,
+			/** @type {number} */ index = 0,
+			/** @type {number} */ lineNumber = 0,
+			/** @type {number} */ node = 0,
+			/** @type {number} */ chr = 0,
+			/** @type {number} */ level = 0,
+			/** @type {number} */ child = 0,
+			/** @type {number} */ numValues = 0,
+			/** @type {number} */ half = 0,
+			/** @type {number} */ root = 0,
+			/** @type {number} */ count = 0,
+			/** @type {number} */ state = 0,
+			/** @type {number} */ bits = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0,
+			/** @type {number} */ x = 0,
+			/** @type {number} */ y = 0,
+			/** @type {number} */ minX = 0,
+			/** @type {number} */ minY = 0,
+			/** @type {number} */ width = 0,
+			/** @type {number} */ height = 0,
+			/** @type {boolean} */ valid = true,
+			/** @type {boolean} */ writeBit = !(pattern.isHistory || pattern.isExtended || pattern.isSuper) && pattern.multiNumStates === -1,
+			/** @type {Uint32Array} */ stateCount = this.stateCount,
+			/** @type {Array<number>} */ values = [0, 0, 0, 0, 0],
+			/** @type {Uint8Array} */ levels = null,
+			/** @type {Int32Array} */ children = null,
+			/** @type {Uint8Array} */ leaves = null,
+			/** @type {Float64Array} */ boxes = null,
+			/** @type {Float64Array} */ copies = null,
+			/** @type {Array<number>} */ stack = [];
+
+		// count lines to size the node arrays
+		i = string.indexOf("\n");
+		while (i !== -1) {
+			maxNodes += 1;
+			i = string.indexOf("\n", i + 1);
+		}
+		levels = new Uint8Array(maxNodes);
+		children = new Int32Array(maxNodes << 2);
+		leaves = new Uint8Array(maxNodes << 3);
+		boxes = new Float64Array(maxNodes << 2);
+
+		// read each node line (node 0 is the empty node)
+		while (index < length && valid) {
+			chr = string.charCodeAt(index);
+			lineNumber += 1;
+
+			// skip leading whitespace
+			while (chr === 32 || chr === 9) {
+				index += 1;
+				chr = string.charCodeAt(index);
+			}
+
+			// 2-state leaf nodes are rows of . and * separated by $
+			if (chr === 46 || chr === 42 || chr === 36) {
+				node += 1;
+				levels[node] = Macrocell.leafLevel;
+				x = 0;
+				y = 0;
+				while (index < length && chr !== 10 && valid) {
+					if (chr === 36) {
+						x = 0;
+						y += 1;
+					} else if (chr === 42 || chr === 46) {
+						if (x > 7 || y > 7) {
+							valid = false;
+						} else {
+							if (chr === 42) {
+								leaves[(node << 3) + y] |= 128 >> x;
+							}
+							x += 1;
+						}
+					} else if (chr !== 13 && chr !== 32) {
+						valid = false;
+					}
+					index += 1;
+					chr = string.charCodeAt(index);
+				}
+			} else if (chr >= 48 && chr <= 57) {
+				// tree nodes are the level followed by four children (or four states for level 1)
+				node += 1;
+				numValues = 0;
+				while (index < length && chr !== 10 && valid) {
+					if (chr >= 48 && chr <= 57) {
+						if (numValues === 5) {
+							valid = false;
+						} else {
+							values[numValues] = 0;
+							while (chr >= 48 && chr <= 57) {
+								values[numValues] = values[numValues] * 10 + chr - 48;
+								index += 1;
+								chr = string.charCodeAt(index);
+							}
+							numValues += 1;
+						}
+					} else {
+						if (chr !== 32 && chr !== 13) {
+							valid = false;
+						}
+						index += 1;
+						chr = string.charCodeAt(index);
+					}
+				}
+
+				// check the node is well formed
+				level = values[0];
+				if (numValues !== 5 || level < 1 || level > 63) {
+					valid = false;
+				} else {
+					levels[node] = level;
+					for (i = 0; i < 4; i += 1) {
+						child = values[i + 1];
+						if (level === 1) {
+							// children are states
+							if (child > 255) {
+								valid = false;
+							}
+						} else {
+							// children are earlier nodes one level down
+							if (child >= node || (child !== 0 && levels[child] !== level - 1)) {
+								valid = false;
+							}
+						}
+						children[(node << 2) + i] = child;
+					}
+				}
+			} else if (chr === 35 || chr === 10 || chr === 13) {
+				// skip comments and blank lines
+				while (index < length && string.charCodeAt(index) !== 10) {
+					index += 1;
+				}
+			} else if (index < length) {
+				valid = false;
+			}
+			index += 1;
+		}
+
+		// the last node is the root
+		root = node;
+		if (root === 0) {
+			valid = false;
+		}
+
+		if (!valid) {
+			this.failureReason = "Invalid Macrocell at line " + lineNumber;
+			pattern.invalid = true;
+			return -1;
+		}
+
+		// compute the bounding box of each node relative to its top left from the children (min x, min y, max x, max y)
+		for (node = 1; node <= root; node += 1) {
+			i = node << 2;
+			boxes[i] = -1;
+			level = levels[node];
+			if (level === Macrocell.leafLevel && children[i] === 0 && children[i + 1] === 0 && children[i + 2] === 0 && children[i + 3] === 0) {
+				// 2-state leaf
+				for (y = 0; y < 8; y += 1) {
+					bits = leaves[(node << 3) + y];
+					if (bits !== 0) {
+						// leftmost and rightmost cells from the highest and lowest set bits
+						this.addMacrocellBox(boxes, i, Math.clz32(bits) - 24, y, Math.clz32(bits & -bits) - 24, y);
+					}
+				}
+			} else if (level === 1) {
+				// 2x2 multi-state leaf
+				for (j = 0; j < 4; j += 1) {
+					if (children[i + j] !== 0) {
+						this.addMacrocellBox(boxes, i, j & 1, j >> 1, j & 1, j >> 1);
+					}
+				}
+			} else {
+				// tree node so add the child boxes at their quadrant offset
+				half = Math.pow(2, level - 1);
+				for (j = 0; j < 4; j += 1) {
+					child = children[i + j] << 2;
+					if (child !== 0 && boxes[child] !== -1) {
+						x = (j & 1) * half;
+						y = (j >> 1) * half;
+						this.addMacrocellBox(boxes, i, boxes[child] + x, boxes[child + 1] + y, boxes[child + 2] + x, boxes[child + 3] + y);
+					}
+				}
+			}
+		}
+
+		// positions are only exact up to 2^53 so drop quadrants of very large empty roots
+		while (levels[root] > Macrocell.maxLevel && levels[root] > 1) {
+			i = root << 2;
+			count = 0;
+			for (j = 0; j < 4; j += 1) {
+				if (children[i + j] !== 0 && boxes[children[i + j] << 2] !== -1) {
+					count += 1;
+					child = children[i + j];
+				}
+			}
+			if (count !== 1) {
+				break;
+			}
+			root = child;
+		}
+
+		// count the copies of each node to get the state counts without expanding the tree
+		copies = new Float64Array(root + 1);
+		copies[root] = 1;
+		for (node = root; node > 0; node -= 1) {
+			if (copies[node] > 0) {
+				i = node << 2;
+				level = levels[node];
+				if (level === Macrocell.leafLevel && children[i] === 0 && children[i + 1] === 0 && children[i + 2] === 0 && children[i + 3] === 0) {
+					for (y = 0; y < 8; y += 1) {
+						bits = leaves[(node << 3) + y];
+						while (bits !== 0) {
+							stateCount[1] += copies[node];
+							bits &= bits - 1;
+						}
+					}
+				} else if (level === 1) {
+					for (j = 0; j < 4; j += 1) {
+						state = children[i + j];
+						if (state !== 0) {
+							stateCount[state] += copies[node];
+						}
+					}
+				} else {
+					for (j = 0; j < 4; j += 1) {
+						copies[children[i + j]] += copies[node];
+					}
+				}
+			}
+		}
+
+		// update the used states
+		for (state = 1; state < 256; state += 1) {
+			if (stateCount[state] !== 0) {
+				pattern.numUsedStates += 1;
+				if (state >= pattern.numStates) {
+					pattern.numStates = state + 1;
+				}
+				pattern.maxStateRead = state;
+			}
+		}
+
+		// get the pattern size
+		i = root << 2;
+		if (boxes[i] === -1) {
+			// allocate at least one cell for empty patterns
+			width = 1;
+			height = 1;
+		} else {
+			minX = boxes[i];
+			minY = boxes[i + 1];
+			width = boxes[i + 2] - minX + 1;
+			height = boxes[i + 3] - minY + 1;
+		}
+		pattern.width = width;
+		pattern.height = height;
+		pattern.patternFormat = "Macrocell";
+		if (width > this.maxWidth || height > this.maxHeight || levels[root] > Macrocell.maxLevel) {
+			pattern.tooBig = true;
+		}
+		pattern.lifeMap = [];
+
+		// write the occupied leaves into the pattern
+		if (!pattern.tooBig && !checkOnly) {
+			pattern.lifeMap = Array.matrix(Type.Uint16, height, ((width - 1) >> 4) + 1, 0, allocator, "Pattern.lifeMap", false);
+			pattern.multiStateMap = Array.matrix(Type.Uint8, height, width, 0, allocator, "Pattern.multiStateMap", false);
+			if (boxes[i] !== -1) {
+				stack.push(root, -minX, -minY);
+			}
+			while (stack.length > 0) {
+				y = /** @type {number} */ (stack.pop());
+				x = /** @type {number} */ (stack.pop());
+				node = /** @type {number} */ (stack.pop());
+				i = node << 2;
+				level = levels[node];
+				if (level === Macrocell.leafLevel && children[i] === 0 && children[i + 1] === 0 && children[i + 2] === 0 && children[i + 3] === 0) {
+					for (j = 0; j < 8; j += 1) {
+						bits = leaves[(node << 3) + j];
+						while (bits !== 0) {
+							child = Math.clz32(bits) - 24;
+							this.setMacrocellCell(pattern, x + child, y + j, 1, writeBit);
+							bits &= ~(128 >> child);
+						}
+					}
+				} else if (level === 1) {
+					for (j = 0; j < 4; j += 1) {
+						state = children[i + j];
+						if (state !== 0) {
+							this.setMacrocellCell(pattern, x + (j & 1), y + (j >> 1), state, writeBit);
+						}
+					}
+				} else {
+					half = Math.pow(2, level - 1);
+					for (j = 0; j < 4; j += 1) {
+						child = children[i + j];
+						if (child !== 0 && boxes[child << 2] !== -1) {
+							stack.push(child, x + (j & 1) * half, y + (j >> 1) * half);
+						}
+					}
+				}
+			}
+		}
+
+		// the whole source was consumed
+		return length;
+	};
+
+	// add a rectangle to a Macrocell node bounding box
+	PatternManager.prototype.addMacrocellBox = function(/** @type {Float64Array} */ boxes, /** @type {number} */ i, /** @type {number} */ left, /** @type {number} */ top, /** @type {number} */ right, /** @type {number} */ bottom) {
+		if (boxes[i] === -1) {
+			boxes[i] = left;
+			boxes[i + 1] = top;
+			boxes[i + 2] = right;
+			boxes[i + 3] = bottom;
+		} else {
+			if (left < boxes[i]) {
+				boxes[i] = left;
+			}
+			if (top < boxes[i + 1]) {
+				boxes[i + 1] = top;
+			}
+			if (right > boxes[i + 2]) {
+				boxes[i + 2] = right;
+			}
+			if (bottom > boxes[i + 3]) {
+				boxes[i + 3] = bottom;
+			}
+		}
+	};
+
 	// set the pattern originator
 	PatternManager.prototype.setOriginator = function(/** @type {Pattern} */ pattern, /** @type {string} */ source) {
 		// end of line index
@@ -8386,6 +8919,9 @@ This file is part of LifeViewer
 			// maximum state allowed
 			/** @type {number} */ maxStates = 0,
 
+			// whether the source is Macrocell format
+			/** @type {boolean} */ isMacrocell = source.substring(0, Macrocell.magic.length) === Macrocell.magic,
+
 			// counters
 			/** @type {number} */ j = 0;
 
@@ -8430,6 +8966,14 @@ This file is part of LifeViewer
 		// add one to the string for lookahead
 		source += " ";
 
+		// skip the Macrocell header line
+		if (isMacrocell) {
+			index = source.indexOf("\n") + 1;
+			if (index === 0) {
+				index = end;
+			}
+		}
+
 		// read each line from the pattern
 		while (index < end && !pattern.invalid) {
 			// get current character
@@ -8493,6 +9037,19 @@ This file is part of LifeViewer
 						addToComments = false;
 						break;
 
+					case "G":
+						// check for Macrocell generation
+						if (isMacrocell) {
+							endLineIndex = source.indexOf("\n", index);
+							if (endLineIndex === -1) {
+								endLineIndex = end;
+							}
+							this.readGeneration("=" + source.substring(index, endLineIndex));
+							index = endLineIndex;
+							addToComments = false;
+						}
+						break;
+
 					case "\n":
 						// line is empty so step back to newline
 						index -= 1;
@@ -8538,14 +9095,19 @@ This file is part of LifeViewer
 						// mark decoded
 						decoded = true;
 
-						// start of bitmap so attempt to size the pattern
-						var list = [];
-						j = this.decodeRLEString(pattern, source.substring(index), list, allocator);
-						if (j !== -1) {
-							index += j;
+						// start of bitmap so attempt to size and decode the pattern using WASM
+						if (isMacrocell) {
+							j = this.decodeMacrocell(pattern, source.substring(index), allocator, checkOnly);
+						} else {
+							j = this.decodeRLEWASM(pattern, source.substring(index), allocator, checkOnly);
+						}
+						if (j === -2) {
+							// WASM could not be used so size the pattern
+							var list = [];
+							j = this.decodeRLEString(pattern, source.substring(index), list, allocator);
 
-							// looks valid so check if pattern is too big
-							if (!pattern.tooBig) {
+							// if it looks valid then check if pattern is too big
+							if (j !== -1 && !pattern.tooBig) {
 								// if validating the don't decode the states
 								if (!checkOnly) {
 									// pattern is good so decode the bitmap
@@ -8553,6 +9115,9 @@ This file is part of LifeViewer
 								}
 							}
 						}
+						if (j !== -1) {
+							index += j;
+						}
 					}
 				}
 				break;
@@ -58,10 +58,95 @@ This file is part of LifeViewer
 
 		// manager
 		/** @type {SnapshotManager} */ this.manager = manager;
+
+		// whether the snapshot includes the overlay
+		/** @type {boolean} */ this.usingOverlay = usingOverlay;
+
+		// packed copy of the tile grids and buffers (used once the snapshot buffers are released)
+		/** @type {Array<Uint32Array>} */ this.packed = null;
+
+		// unpacked length of each packed stream in 32bit words
+		/** @type {Array<number>} */ this.packedWords = null;
+
+		// tile grid dimensions of the packed copy and its position in the current tile grid (the grid may have grown since)
+		/** @type {number} */ this.packedTileWidth = 0;
+		/** @type {number} */ this.packedTileHeight = 0;
+		/** @type {number} */ this.packedXOffset = 0;
+		/** @type {number} */ this.packedYOffset = 0;
+
+		// snapshot the packed copy is an xor delta against (null if none) and delta chain length
+		/** @type {Snapshot} */ this.deltaBase = null;
+		/** @type {number} */ this.deltaDepth = 0;
 	}
 
 	// restore grid using tile map
 	Snapshot.prototype.restoreGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life) {
+		// check whether to use WASM to scatter the tiles
+		if (this.manager.useTileWASM(grid, tile, this.gridBuffer, life)) {
+			// restore the tile grid
+			Array.copy(this.tileGrid, tile);
+
+			// copy the buffer onto the grid
+			this.manager.scatterTiles(grid, tile, this.gridBuffer, this.manager.countTiles(tile) * 8, false);
+		} else {
+			this.restoreGridUsingTileJS(grid, tile, life);
+		}
+	};
+
+	// save grid using tile map
+	Snapshot.prototype.saveGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life) {
+		var	/** @type {number} */ usedCount = 0;
+
+		// check whether to use WASM to gather the tiles
+		if (this.manager.useTileWASM(grid, tile, this.gridBuffer, life)) {
+			// save the tile grid
+			Array.copy(tile, this.tileGrid);
+
+			// copy the grid in to the buffer
+			usedCount = this.manager.countTiles(tile);
+			if (usedCount) {
+				this.manager.gatherTiles(grid, tile, this.gridBuffer, usedCount * 8, false, "Snapshot.gridBufferRow");
+			}
+		} else {
+			this.saveGridUsingTileJS(grid, tile, life);
+		}
+	};
+
+	// restore colour grid using tile map
+	Snapshot.prototype.restoreColourGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer) {
+		// check whether to use WASM to scatter the tiles
+		if (this.manager.useTileWASM(grid, tile, buffer, life)) {
+			// restore the tile grid
+			Array.copy(this.colourTileGrid, tile);
+
+			// copy the buffer onto the grid
+			this.manager.scatterTiles(grid, tile, buffer, this.manager.countTiles(tile) * 64, true);
+		} else {
+			this.restoreColourGridUsingTileJS(grid, tile, life, buffer);
+		}
+	};
+
+	// save colour grid using tile map
+	Snapshot.prototype.saveColourGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer, /** @type {Array<Uint16Array>} */ colourTileGrid) {
+		var	/** @type {number} */ usedCount = 0;
+
+		// check whether to use WASM to gather the tiles
+		if (this.manager.useTileWASM(grid, tile, buffer, life)) {
+			// save the colour tile grid
+			Array.copy(tile, colourTileGrid);
+
+			// copy the grid in to the buffer
+			usedCount = this.manager.countTiles(tile);
+			if (usedCount) {
+				this.manager.gatherTiles(grid, tile, buffer, usedCount * 64, true, "Snapshot.colourGridBufferRow");
+			}
+		} else {
+			this.saveColourGridUsingTileJS(grid, tile, life, buffer, colourTileGrid);
+		}
+	};
+
+	// restore grid using tile map - Javascript version
+	Snapshot.prototype.restoreGridUsingTileJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life) {
 		// length of tile array
 		var	/** @type {number} */ l = tile.length,
 
@@ -209,8 +294,8 @@ This file is part of LifeViewer
 		}
 	};
 
-	// save grid using tile map
-	Snapshot.prototype.saveGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life) {
+	// save grid using tile map - Javascript version
+	Snapshot.prototype.saveGridUsingTileJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life) {
 		// length of tile array
 		var	/** @type {number} */ l = tile.length,
 
@@ -377,8 +462,8 @@ This file is part of LifeViewer
 		}
 	};
 
-	// restore colour grid using tile map
-	Snapshot.prototype.restoreColourGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer) {
+	// restore colour grid using tile map - Javascript version
+	Snapshot.prototype.restoreColourGridUsingTileJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer) {
 		// length of tile array
 		var	/** @type {number} */ l = tile.length,
 
@@ -648,8 +733,8 @@ This file is part of LifeViewer
 		}
 	};
 
-	// save colour grid using tile map
-	Snapshot.prototype.saveColourGridUsingTile = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer, /** @type {Array<Uint16Array>} */ colourTileGrid) {
+	// save colour grid using tile map - Javascript version
+	Snapshot.prototype.saveColourGridUsingTileJS = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Life} */ life, /** @type {Array<Uint32Array>} */ buffer, /** @type {Array<Uint16Array>} */ colourTileGrid) {
 		// length of tile array
 		var	/** @type {number} */ l = tile.length,
 
@@ -962,6 +1047,7 @@ This file is part of LifeViewer
 	function SnapshotManager(/** @type {Allocator} */ allocator, /** @type {Uint8Array} */ bitcounts) {
 		// allocator
 		/** @type {Allocator} */ this.allocator = allocator;
+		allocator.registerOwner(this);
 
 		// snapshots
 		/** @type {Array<Snapshot>} */ this.snapshots = [];
@@ -994,7 +1080,23 @@ This file is part of LifeViewer
 		/** @type {number} */ this.index = -1;
 
 		// maximum number of snapshots
-		/** @type {number} */ this.maxSnapshots = 51;
+		/** @type {number} */ this.maxSnapshots = 512;
+
+		// memory budget for packed snapshots in multiples of the newest snapshot's unpacked size
+		/** @type {number} */ this.budgetSnapshots = 51;
+
+		// number of newest snapshots kept unpacked
+		/** @type {number} */ this.unpackedSnapshots = 4;
+
+		// maximum xor delta chain length
+		/** @type {number} */ this.maxDeltaDepth = 8;
+
+		// total size of packed snapshots in bytes
+		/** @type {number} */ this.packedBytes = 0;
+
+		// unpacked streams of the most recently packed snapshot (to use as a delta base)
+		/** @type {Array<Uint32Array>} */ this.lastStreams = null;
+		/** @type {Snapshot} */ this.lastStreamsSnapshot = null;
 
 		// bit counts for bytes
 		/** @type {Uint8Array} */ this.bitCounts = bitcounts;
@@ -1035,6 +1137,9 @@ This file is part of LifeViewer
 			i += 1;
 		}
 
+		// add packed snapshots
+		result += this.packedBytes;
+
 		// return size
 		return result;
 	};
@@ -1070,6 +1175,9 @@ This file is part of LifeViewer
 		this.bufferUsed = [];
 		this.numBuffers = 0;
 		this.index = -1;
+		this.packedBytes = 0;
+		this.lastStreams = null;
+		this.lastStreamsSnapshot = null;
 	};
 
 	// get the snapshot before the target generation
@@ -1089,8 +1197,8 @@ This file is part of LifeViewer
 
 				// check if this is the only snapshot
 				if (this.index > 0) {
-					// free the buffer
-					this.freeBuffer(this.snapshots[this.index].index);
+					// free the buffer or packed copy
+					this.discardSnapshot(this.snapshots[this.index]);
 
 					// remove the snapshot
 					this.snapshots.pop();
@@ -1105,6 +1213,11 @@ This file is part of LifeViewer
 			}
 		}
 
+		// unpack the snapshot if its buffers were released
+		if (result && result.index === -1) {
+			this.unpackSnapshot(result);
+		}
+
 		// return the snapshot if found
 		return result;
 	};
@@ -1121,35 +1234,14 @@ This file is part of LifeViewer
 			// use the reset snapshot
 			snapshot = this.resetSnapshot;
 		} else {
-			// check whether to create a new snapshot
-			if (this.snapshots.length < this.maxSnapshots) {
-				// create a new snapshot
-				snapshot = this.createSnapshot(width, height, false, usingOverlay);
-				this.index += 1;
-			} else {
-				// get the next snapshot index
-				this.index += 1;
-				if (this.index >= this.maxSnapshots) {
-					this.index = this.maxSnapshots - 1;
-
-					// free the oldest snapshot
-					this.freeBuffer(this.snapshots[0].index);
-
-					// move the snapshots down
-					for (i = 0; i < this.maxSnapshots - 1; i += 1) {
-						this.snapshots[i] = this.snapshots[i + 1];
-					}
-
-					// remove the final element
-					this.snapshots.pop();
-
-					// create a new final element
-					snapshot = this.createSnapshot(width, height, false, usingOverlay);
-				}
-
-				// get the snapshot at the index
-				snapshot = this.snapshots[this.index];
+			// if there are too many snapshots then remove one so older snapshots are spaced logarithmically
+			if (this.snapshots.length >= this.maxSnapshots) {
+				this.thinSnapshots(counter);
 			}
+
+			// create a new snapshot
+			snapshot = this.createSnapshot(width, height, false, usingOverlay);
+			this.index = this.snapshots.length - 1;
 		}
 
 		// save the grid
@@ -1183,6 +1275,592 @@ This file is part of LifeViewer
 		snapshot.fixedCounter = fixedCounter;
 		snapshot.counterMargolus = counterMargolus;
 		snapshot.maxMargolusGen = maxMargolusGen;
+
+		// pack the snapshots that have left the unpacked window
+		if (!isReset) {
+			for (i = 0; i < this.snapshots.length - this.unpackedSnapshots; i += 1) {
+				if (this.snapshots[i].index !== -1) {
+					this.releaseSnapshot(i);
+				}
+			}
+
+			// keep packed snapshots within the memory budget
+			i = this.unpackedBytes(snapshot) * this.budgetSnapshots;
+			while (this.packedBytes > i && this.snapshots.length > this.unpackedSnapshots + 2) {
+				this.thinSnapshots(counter);
+			}
+		}
+	};
+
+	// return the size in bytes of the tile grids and buffer contents of an unpacked snapshot
+	/** @returns {number} */
+	SnapshotManager.prototype.unpackedBytes = function(/** @type {Snapshot} */ snapshot) {
+		var	/** @type {number} */ result = (this.countTiles(snapshot.tileGrid) * 8 + this.countTiles(snapshot.colourTileGrid) * 64) * 4 + snapshot.tileGrid.whole.length * 4;
+
+		if (snapshot.usingOverlay) {
+			result += this.countTiles(snapshot.overlayTileGrid) * 64 * 4 + snapshot.tileGrid.whole.length * 2;
+		}
+
+		return result;
+	};
+
+	// count the occupied tiles in a tile grid
+	/** @returns {number} */
+	SnapshotManager.prototype.countTiles = function(/** @type {Array<Uint16Array>} */ tileGrid) {
+		var	/** @type {Uint16Array} */ whole = tileGrid.whole,
+			/** @type {number} */ result = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ tileGroup = 0;
+
+		for (i = 0; i < whole.length; i += 1) {
+			tileGroup = whole[i];
+			if (tileGroup) {
+				result += this.bitCounts[tileGroup];
+			}
+		}
+
+		return result;
+	};
+
+	// copy the used part of a snapshot buffer into a single array
+	/** @returns {Uint32Array} */
+	SnapshotManager.prototype.readStream = function(/** @type {Array<Uint32Array>} */ buffer, /** @type {number} */ words) {
+		var	/** @type {Uint32Array} */ result = new Uint32Array(words),
+			/** @type {number} */ i = 0,
+			/** @type {number} */ rowIndex = 0,
+			/** @type {number} */ n = 0;
+
+		while (i < words) {
+			n = buffer[rowIndex].length;
+			if (n > words - i) {
+				n = words - i;
+			}
+			result.set(buffer[rowIndex].subarray(0, n), i);
+			i += n;
+			rowIndex += 1;
+		}
+
+		return result;
+	};
+
+	// check whether WASM can gather and scatter tiles for the given grid and snapshot buffer
+	/** @returns {boolean} */
+	SnapshotManager.prototype.useTileWASM = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Array<Uint32Array>} */ buffer, /** @type {Life} */ life) {
+		var	/** @type {ArrayBuffer} */ wasmBuffer = null;
+
+		if (!(Controller.useWASM && Controller.wasmEnableSnapshotTiles && life.view.wasmEnabled)) {
+			return false;
+		}
+		wasmBuffer = WASM.memory.buffer;
+
+		return grid.whole.buffer === wasmBuffer && tile.whole.buffer === wasmBuffer && buffer.whole.buffer === wasmBuffer;
+	};
+
+	// create a temporary WASM table of the offsets of the snapshot buffer rows (the caller restores the heap pointer)
+	/** @returns {Uint32Array} */
+	SnapshotManager.prototype.bufferRowTable = function(/** @type {Array<Uint32Array>} */ buffer, /** @type {number} */ rows) {
+		var	/** @type {Uint32Array} */ result = null,
+			/** @type {number} */ i = 0;
+
+		this.allocator.reserveHeap(rows * 4 + 64);
+		result = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, rows, "Snapshot.bufferRows", true));
+		for (i = 0; i < rows; i += 1) {
+			result[i] = buffer[i].byteOffset;
+		}
+
+		return result;
+	};
+
+	// gather the occupied tiles of a grid straight into the WASM heap rows of a snapshot buffer
+	SnapshotManager.prototype.gatherTiles = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Array<Uint32Array>} */ buffer, /** @type {number} */ words, /** @type {boolean} */ isColour, /** @type {string} */ name) {
+		var	/** @type {number} */ rowWords = buffer[0].length,
+			/** @type {number} */ rows = ((words + rowWords - 1) / rowWords) | 0,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {Uint32Array} */ rowTable = null;
+
+		// add any rows needed before taking the heap pointer so they are kept
+		while (buffer.length < rows) {
+			Array.addRow(buffer, 0, name);
+		}
+
+		heapPointer = this.allocator.getHeapPointer();
+		rowTable = this.bufferRowTable(buffer, rows);
+		if (isColour) {
+			WASM.saveColourGridTiles(grid.whole.byteOffset, grid[0].length, tile.whole.byteOffset, tile[0].length, tile.length, rowTable.byteOffset, rowWords);
+		} else {
+			WASM.saveGridTiles(grid.whole.byteOffset, grid[0].length >> 1, tile.whole.byteOffset, tile[0].length, tile.length, rowTable.byteOffset, rowWords);
+		}
+		this.allocator.setHeapPointer(heapPointer);
+	};
+
+	// scatter the occupied tiles of a grid straight from the WASM heap rows of a snapshot buffer
+	SnapshotManager.prototype.scatterTiles = function(/** @type {Array<Uint8Array>} */ grid, /** @type {Array<Uint16Array>} */ tile, /** @type {Array<Uint32Array>} */ buffer, /** @type {number} */ words, /** @type {boolean} */ isColour) {
+		var	/** @type {number} */ rowWords = buffer[0].length,
+			/** @type {number} */ rows = ((words + rowWords - 1) / rowWords) | 0,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {Uint32Array} */ rowTable = null;
+
+		if (rows === 0) {
+			return;
+		}
+
+		heapPointer = this.allocator.getHeapPointer();
+		rowTable = this.bufferRowTable(buffer, rows);
+		if (isColour) {
+			WASM.restoreColourGridTiles(grid.whole.byteOffset, grid[0].length, tile.whole.byteOffset, tile[0].length, tile.length, rowTable.byteOffset, rowWords);
+		} else {
+			WASM.restoreGridTiles(grid.whole.byteOffset, grid[0].length >> 1, tile.whole.byteOffset, tile[0].length, tile.length, rowTable.byteOffset, rowWords);
+		}
+		this.allocator.setHeapPointer(heapPointer);
+	};
+
+	// copy a single array into a snapshot buffer adding rows if needed
+	SnapshotManager.prototype.writeStream = function(/** @type {Array<Uint32Array>} */ buffer, /** @type {Uint32Array} */ stream, /** @type {string} */ name) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ rowIndex = 0,
+			/** @type {number} */ n = 0;
+
+		while (i < stream.length) {
+			if (rowIndex >= buffer.length) {
+				Array.addRow(buffer, 0, name);
+			}
+			n = buffer[rowIndex].length;
+			if (n > stream.length - i) {
+				n = stream.length - i;
+			}
+			buffer[rowIndex].set(stream.subarray(i, i + n));
+			i += n;
+			rowIndex += 1;
+		}
+	};
+
+	// convert a tile grid into 32bit words
+	/** @returns {Uint32Array} */
+	SnapshotManager.prototype.tileWords = function(/** @type {Uint16Array} */ tiles) {
+		var	/** @type {Uint32Array} */ result = new Uint32Array((tiles.length + 1) >> 1);
+
+		new Uint16Array(result.buffer, 0, tiles.length).set(tiles);
+
+		return result;
+	};
+
+	// get the unpacked tile grid and buffer streams of a snapshot
+	/** @returns {Array<Uint32Array>} */
+	SnapshotManager.prototype.getStreams = function(/** @type {Snapshot} */ snapshot) {
+		var	/** @type {Array<Uint32Array>} */ result = [],
+			/** @type {Array<Uint32Array>} */ base = null,
+			/** @type {number} */ i = 0;
+
+		if (snapshot.packed === null) {
+			// read from the snapshot buffers
+			result[0] = this.tileWords(snapshot.tileGrid.whole);
+			result[1] = this.tileWords(snapshot.colourTileGrid.whole);
+			result[2] = snapshot.usingOverlay ? this.tileWords(snapshot.overlayTileGrid.whole) : new Uint32Array(0);
+			result[3] = this.readStream(snapshot.gridBuffer, this.countTiles(snapshot.tileGrid) * 8);
+			result[4] = this.readStream(snapshot.colourBuffer, this.countTiles(snapshot.colourTileGrid) * 64);
+			result[5] = snapshot.usingOverlay ? this.readStream(snapshot.overlayBuffer, this.countTiles(snapshot.overlayTileGrid) * 64) : new Uint32Array(0);
+		} else {
+			// unpack (following the delta chain)
+			if (snapshot.deltaBase !== null) {
+				base = this.getStreams(snapshot.deltaBase);
+			}
+			result = this.unpackStreams(snapshot, base);
+		}
+
+		return result;
+	};
+
+	// unpack the packed copy of a snapshot given the unpacked streams of its delta base
+	/** @returns {Array<Uint32Array>} */
+	SnapshotManager.prototype.unpackStreams = function(/** @type {Snapshot} */ snapshot, /** @type {Array<Uint32Array>} */ base) {
+		var	/** @type {Array<Uint32Array>} */ result = [],
+			/** @type {number} */ i = 0;
+
+		for (i = 0; i < 6; i += 1) {
+			result[i] = this.unpackWords(snapshot.packed[i], (base === null || snapshot.deltaBase === null) ? null : base[i], snapshot.packedWords[i]);
+		}
+
+		return result;
+	};
+
+	// resize the tile grid streams of an unpacked snapshot to fit the new grid
+	/** @returns {Array<Uint32Array>} */
+	SnapshotManager.prototype.resizeStreams = function(/** @type {Array<Uint32Array>} */ streams, /** @type {number} */ width, /** @type {number} */ height, /** @type {number} */ newWidth, /** @type {number} */ newHeight, /** @type {number} */ xOffset, /** @type {number} */ yOffset) {
+		var	/** @type {Array<Uint32Array>} */ result = [],
+			/** @type {Uint16Array} */ source = null,
+			/** @type {Uint16Array} */ dest = null,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ y = 0;
+
+		for (i = 0; i < 3; i += 1) {
+			result[i] = new Uint32Array((newWidth * newHeight + 1) >> 1);
+
+			// the tiles are only kept if the snapshot has grown (matching resizeSnapshot)
+			if ((xOffset > 0 || yOffset > 0) && streams[i].length > 0) {
+				source = new Uint16Array(streams[i].buffer, 0, width * height);
+				dest = new Uint16Array(result[i].buffer, 0, newWidth * newHeight);
+				for (y = 0; y < height; y += 1) {
+					dest.set(source.subarray(y * width, (y + 1) * width), (y + yOffset) * newWidth + xOffset);
+				}
+				result[i + 3] = streams[i + 3];
+			} else {
+				result[i + 3] = new Uint32Array(0);
+			}
+			if (streams[i].length === 0) {
+				result[i] = new Uint32Array(0);
+			}
+		}
+
+		return result;
+	};
+
+	// resize the packed copies of snapshots to fit the new grid
+	SnapshotManager.prototype.resizePacked = function(/** @type {number} */ newWidth, /** @type {number} */ newHeight, /** @type {number} */ xOffset, /** @type {number} */ yOffset) {
+		var	/** @type {number} */ i = 0,
+			/** @type {Snapshot} */ snapshot = null,
+			/** @type {Snapshot} */ previous = null,
+			/** @type {Array<Uint32Array>} */ oldStreams = null,
+			/** @type {Array<Uint32Array>} */ oldPrevious = null,
+			/** @type {Array<Uint32Array>} */ newStreams = null,
+			/** @type {Array<Uint32Array>} */ newPrevious = null;
+
+		// deltas are always against the preceding snapshot so walk forwards keeping the previous old and new streams
+		for (i = 0; i < this.snapshots.length; i += 1) {
+			snapshot = this.snapshots[i];
+			if (snapshot.packed !== null) {
+				oldStreams = this.unpackStreams(snapshot, snapshot.deltaBase === previous ? oldPrevious : null);
+				newStreams = this.resizeStreams(oldStreams, snapshot.packedTileWidth, snapshot.packedTileHeight, newWidth, newHeight, xOffset, yOffset);
+				this.packStreams(snapshot, newStreams, previous, newPrevious);
+				snapshot.packedTileWidth = newWidth;
+				snapshot.packedTileHeight = newHeight;
+				snapshot.packedXOffset = 0;
+				snapshot.packedYOffset = 0;
+				previous = snapshot;
+				oldPrevious = oldStreams;
+				newPrevious = newStreams;
+			} else {
+				previous = null;
+				oldPrevious = null;
+				newPrevious = null;
+			}
+		}
+	};
+
+	// check whether two sets of streams have the same tile layout and sizes
+	/** @returns {boolean} */
+	SnapshotManager.prototype.sameLayout = function(/** @type {Array<Uint32Array>} */ a, /** @type {Array<Uint32Array>} */ b) {
+		var	/** @type {number} */ i = 0,
+			/** @type {number} */ j = 0;
+
+		for (i = 0; i < 6; i += 1) {
+			if (a[i].length !== b[i].length) {
+				return false;
+			}
+		}
+		for (i = 0; i < 3; i += 1) {
+			for (j = 0; j < a[i].length; j += 1) {
+				if (a[i][j] !== b[i][j]) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	};
+
+	// pack a set of streams into a snapshot as an xor delta against the previous snapshot where possible
+	SnapshotManager.prototype.packStreams = function(/** @type {Snapshot} */ snapshot, /** @type {Array<Uint32Array>} */ streams, /** @type {Snapshot} */ previous, /** @type {Array<Uint32Array>} */ previousStreams) {
+		var	/** @type {Array<Uint32Array>} */ base = null,
+			/** @type {number} */ i = 0;
+
+		// remove any existing packed copy
+		this.discardPacked(snapshot);
+
+		// use the previous snapshot as a delta base if the tile layout is unchanged and the chain is short enough
+		snapshot.deltaBase = null;
+		snapshot.deltaDepth = 0;
+		if (previous !== null && previousStreams !== null && previous.packed !== null && previous.deltaDepth < this.maxDeltaDepth && this.sameLayout(streams, previousStreams)) {
+			base = previousStreams;
+			snapshot.deltaBase = previous;
+			snapshot.deltaDepth = previous.deltaDepth + 1;
+		}
+
+		snapshot.packed = [];
+		snapshot.packedWords = [];
+		for (i = 0; i < 6; i += 1) {
+			snapshot.packed[i] = this.packWords(streams[i], base === null ? null : base[i]);
+			snapshot.packedWords[i] = streams[i].length;
+			this.packedBytes += snapshot.packed[i].length * 4;
+		}
+
+		// remember the streams as the base for the next snapshot
+		this.lastStreams = streams;
+		this.lastStreamsSnapshot = snapshot;
+	};
+
+	// pack a snapshot and release its buffers
+	SnapshotManager.prototype.releaseSnapshot = function(/** @type {number} */ which) {
+		var	/** @type {Snapshot} */ snapshot = this.snapshots[which],
+			/** @type {Snapshot} */ previous = (which > 0) ? this.snapshots[which - 1] : null,
+			/** @type {Array<Uint32Array>} */ previousStreams = null;
+
+		// pack if there is no existing packed copy
+		if (snapshot.packed === null) {
+			if (previous !== null) {
+				if (this.lastStreamsSnapshot === previous) {
+					previousStreams = this.lastStreams;
+				} else if (previous.index !== -1) {
+					previousStreams = this.getStreams(previous);
+				}
+			}
+			this.packStreams(snapshot, this.getStreams(snapshot), previous, previousStreams);
+			snapshot.packedTileWidth = snapshot.tileGrid[0].length;
+			snapshot.packedTileHeight = snapshot.tileGrid.length;
+			snapshot.packedXOffset = 0;
+			snapshot.packedYOffset = 0;
+		}
+
+		// release the buffers
+		this.freeBuffer(snapshot.index);
+		snapshot.index = -1;
+		snapshot.tileGrid = null;
+		snapshot.colourTileGrid = null;
+		snapshot.overlayTileGrid = null;
+		snapshot.gridBuffer = null;
+		snapshot.colourBuffer = null;
+		snapshot.overlayBuffer = null;
+	};
+
+	// unpack a snapshot into buffers (the packed copy is kept)
+	SnapshotManager.prototype.unpackSnapshot = function(/** @type {Snapshot} */ snapshot) {
+		var	/** @type {Array<Uint32Array>} */ streams = this.getStreams(snapshot),
+			/** @type {number} */ width = snapshot.packedTileWidth,
+			/** @type {number} */ height = snapshot.packedTileHeight,
+			/** @type {number} */ index = 0;
+
+		// use the current tile grid size
+		if (this.resetSnapshot !== null && this.resetSnapshot.tileGrid !== null) {
+			width = this.resetSnapshot.tileGrid[0].length;
+			height = this.resetSnapshot.tileGrid.length;
+		}
+		index = this.getBuffers(width, height, snapshot.usingOverlay);
+
+		snapshot.index = index;
+		snapshot.tileGrid = this.tileGrids[index];
+		snapshot.colourTileGrid = this.colourTileGrids[index];
+		snapshot.gridBuffer = this.gridBuffers[index];
+		snapshot.colourBuffer = this.colourBuffers[index];
+		this.placeTiles(snapshot.tileGrid, streams[0], snapshot);
+		this.placeTiles(snapshot.colourTileGrid, streams[1], snapshot);
+		this.writeStream(snapshot.gridBuffer, streams[3], "Snapshot.gridBufferRow");
+		this.writeStream(snapshot.colourBuffer, streams[4], "Snapshot.colourGridBufferRow");
+		if (snapshot.usingOverlay) {
+			snapshot.overlayTileGrid = this.overlayTileGrids[index];
+			snapshot.overlayBuffer = this.overlayBuffers[index];
+			this.placeTiles(snapshot.overlayTileGrid, streams[2], snapshot);
+			this.writeStream(snapshot.overlayBuffer, streams[5], "Snapshot.overlayGridBufferRow");
+		}
+	};
+
+	// copy a packed tile grid stream into a tile grid at the packed snapshot's position
+	SnapshotManager.prototype.placeTiles = function(/** @type {Array<Uint16Array>} */ tileGrid, /** @type {Uint32Array} */ stream, /** @type {Snapshot} */ snapshot) {
+		var	/** @type {number} */ width = snapshot.packedTileWidth,
+			/** @type {number} */ height = snapshot.packedTileHeight,
+			/** @type {Uint16Array} */ source = null,
+			/** @type {number} */ y = 0;
+
+		if (stream.length === 0) {
+			tileGrid.whole.fill(0);
+		} else {
+			source = new Uint16Array(stream.buffer, 0, width * height);
+			if (width === tileGrid[0].length && height === tileGrid.length) {
+				tileGrid.whole.set(source);
+			} else {
+				// the grid has grown since the snapshot was packed
+				tileGrid.whole.fill(0);
+				for (y = 0; y < height; y += 1) {
+					tileGrid[y + snapshot.packedYOffset].set(source.subarray(y * width, (y + 1) * width), snapshot.packedXOffset);
+				}
+			}
+		}
+	};
+
+	// remove the packed copy of a snapshot
+	SnapshotManager.prototype.discardPacked = function(/** @type {Snapshot} */ snapshot) {
+		var	/** @type {number} */ i = 0;
+
+		if (snapshot.packed !== null) {
+			for (i = 0; i < 6; i += 1) {
+				this.packedBytes -= snapshot.packed[i].length * 4;
+			}
+			snapshot.packed = null;
+			snapshot.packedWords = null;
+		}
+		if (this.lastStreamsSnapshot === snapshot) {
+			this.lastStreams = null;
+			this.lastStreamsSnapshot = null;
+		}
+	};
+
+	// free the buffers and packed copy of a snapshot
+	SnapshotManager.prototype.discardSnapshot = function(/** @type {Snapshot} */ snapshot) {
+		if (snapshot.index !== -1) {
+			this.freeBuffer(snapshot.index);
+		}
+		this.discardPacked(snapshot);
+	};
+
+	// remove the snapshot whose removal leaves the smallest gap relative to its age so spacing grows with age
+	SnapshotManager.prototype.thinSnapshots = function(/** @type {number} */ counter) {
+		var	/** @type {Array<Snapshot>} */ snapshots = this.snapshots,
+			/** @type {number} */ n = snapshots.length,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ best = -1,
+			/** @type {number} */ score = 0,
+			/** @type {number} */ bestScore = 0,
+			/** @type {Snapshot} */ snapshot = null,
+			/** @type {Snapshot} */ next = null;
+
+		// keep the oldest and newest snapshots
+		for (i = 1; i < n - 1; i += 1) {
+			score = (snapshots[i + 1].counter - snapshots[i - 1].counter) / (counter - snapshots[i - 1].counter + 1);
+			if (best === -1 || score < bestScore) {
+				best = i;
+				bestScore = score;
+			}
+		}
+
+		if (best !== -1) {
+			snapshot = snapshots[best];
+			next = snapshots[best + 1];
+
+			// if the next snapshot is a delta against this one then repack it standalone
+			if (next.deltaBase === snapshot) {
+				this.packStreams(next, this.getStreams(next), null, null);
+			}
+
+			// remove the snapshot
+			this.discardSnapshot(snapshot);
+			snapshots.splice(best, 1);
+			this.index = snapshots.length - 1;
+		}
+	};
+
+	// zero run length encode words (optionally as an xor delta against a base)
+	/** @returns {Uint32Array} */
+	SnapshotManager.prototype.packWords = function(/** @type {Uint32Array} */ words, /** @type {Uint32Array} */ base) {
+		var	/** @type {number} */ length = words.length,
+			/** @type {Uint32Array} */ result = null,
+			/** @type {Uint32Array} */ input = null,
+			/** @type {Uint32Array} */ baseWASM = null,
+			/** @type {Uint32Array} */ output = null,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ o = 0,
+			/** @type {number} */ start = 0,
+			/** @type {number} */ literals = 0,
+			/** @type {Uint32Array} */ data = words;
+
+		if (Controller.useWASM && Controller.wasmEnableSnapshotPack) {
+			// use temporary WASM buffers and then restore the heap pointer
+			heapPointer = this.allocator.getHeapPointer();
+			this.allocator.reserveHeap((length * 3 + 64) * 4);
+			input = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, length, "Snapshot.packInput", true));
+			output = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, length + 2, "Snapshot.packOutput", true));
+			input.set(words);
+			baseWASM = input;
+			if (base !== null) {
+				baseWASM = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, length, "Snapshot.packBase", true));
+				baseWASM.set(base);
+			}
+			o = WASM.packSnapshotData(input.byteOffset, length, baseWASM.byteOffset, base === null ? 0 : 1, output.byteOffset);
+			result = output.slice(0, o);
+			this.allocator.setHeapPointer(heapPointer);
+		} else {
+			// delta against the base if specified
+			if (base !== null) {
+				data = new Uint32Array(length);
+				for (i = 0; i < length; i += 1) {
+					data[i] = words[i] ^ base[i];
+				}
+			}
+
+			// encode zero runs followed by literals
+			output = new Uint32Array(length + 2);
+			i = 0;
+			while (i < length) {
+				start = i;
+				while (i < length && data[i] === 0) {
+					i += 1;
+				}
+				output[o] = i - start;
+				o += 1;
+
+				// literals continue until a run of at least 3 zeros
+				start = i;
+				while (i < length && !(data[i] === 0 && i + 2 < length && data[i + 1] === 0 && data[i + 2] === 0)) {
+					i += 1;
+				}
+				literals = i - start;
+				output[o] = literals;
+				o += 1;
+				output.set(data.subarray(start, i), o);
+				o += literals;
+			}
+			result = output.slice(0, o);
+		}
+
+		return result;
+	};
+
+	// decode zero run length encoded words (optionally as an xor delta against a base)
+	/** @returns {Uint32Array} */
+	SnapshotManager.prototype.unpackWords = function(/** @type {Uint32Array} */ packed, /** @type {Uint32Array} */ base, /** @type {number} */ length) {
+		var	/** @type {Uint32Array} */ result = null,
+			/** @type {Uint32Array} */ input = null,
+			/** @type {Uint32Array} */ baseWASM = null,
+			/** @type {Uint32Array} */ output = null,
+			/** @type {number} */ heapPointer = 0,
+			/** @type {number} */ i = 0,
+			/** @type {number} */ o = 0,
+			/** @type {number} */ literals = 0;
+
+		if (Controller.useWASM && Controller.wasmEnableSnapshotPack) {
+			// use temporary WASM buffers and then restore the heap pointer
+			heapPointer = this.allocator.getHeapPointer();
+			this.allocator.reserveHeap((packed.length + length * 2 + 64) * 4);
+			input = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, packed.length, "Snapshot.unpackInput", true));
+			output = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, length, "Snapshot.unpackOutput", true));
+			input.set(packed);
+			baseWASM = output;
+			if (base !== null) {
+				baseWASM = /** @type {!Uint32Array} */ (this.allocator.allocate(Type.Uint32, length, "Snapshot.unpackBase", true));
+				baseWASM.set(base);
+			}
+			WASM.unpackSnapshotData(input.byteOffset, packed.length, baseWASM.byteOffset, base === null ? 0 : 1, output.byteOffset, length);
+			result = output.slice(0, length);
+			this.allocator.setHeapPointer(heapPointer);
+		} else {
+			result = new Uint32Array(length);
+			while (i < packed.length) {
+				// skip the zero run (already zero)
+				o += packed[i];
+				literals = packed[i + 1];
+				i += 2;
+				result.set(packed.subarray(i, i + literals), o);
+				i += literals;
+				o += literals;
+			}
+
+			// undo the delta against the base if specified
+			if (base !== null) {
+				for (i = 0; i < length; i += 1) {
+					result[i] ^= base[i];
+				}
+			}
+		}
+
+		return result;
 	};
 
 	// free a buffer
@@ -1191,6 +1869,27 @@ This file is part of LifeViewer
 		this.bufferUsed[number] = false;
 	};
 
+	// create a snapshot buffer
+	// (with WASM the buffer is on the WASM heap so tiles can be gathered in place, and the previous buffer is reused
+	// after a snapshot reset unless the allocator has been reset since it was allocated)
+	/** @returns {Array<Uint32Array>} */
+	SnapshotManager.prototype.createBuffer = function(/** @type {Array<Uint32Array>} */ previous, /** @type {number} */ words, /** @type {string} */ name) {
+		var	/** @type {Array} */ entry = null;
+
+		if (!Controller.useWASM) {
+			return Array.matrix(Type.Uint32, 1, words, 0, this.allocator, name, false);
+		}
+
+		if (previous !== undefined && previous !== null) {
+			entry = this.allocator.wasmMatrices[name];
+			if (entry !== undefined && entry[1] === previous) {
+				return previous;
+			}
+		}
+
+		return Array.matrix(Type.Uint32, 1, words, 0, this.allocator, name, true);
+	};
+
 	// create or return a buffer
 	/** @returns {number} */
 	SnapshotManager.prototype.getBuffers = function(/** @type {number} */ width, /** @type {number} */ height, /** @type {boolean} */ usingOverlay) {
@@ -1221,11 +1920,11 @@ This file is part of LifeViewer
 			// create a new buffer
 			this.tileGrids[i] = Array.matrix(Type.Uint16, height, width, 0, this.allocator, "Snapshot.tileGrid" + i, false);
 			this.colourTileGrids[i] = Array.matrix(Type.Uint16, height, width, 0, this.allocator, "Snapshot.colourTileGrid" + i, false);
-			this.gridBuffers[i] = Array.matrix(Type.Uint32, 1, this.defaultTiles * 8, 0, this.allocator, "Snapshot.gridBuffer" + i, false);
-			this.colourBuffers[i] = Array.matrix(Type.Uint32, 1, this.defaultTiles * 64, 0, this.allocator, "Snapshot.colourGridBuffer" + i, false);
+			this.gridBuffers[i] = this.createBuffer(this.gridBuffers[i], this.defaultTiles * 8, "Snapshot.gridBuffer" + i);
+			this.colourBuffers[i] = this.createBuffer(this.colourBuffers[i], this.defaultTiles * 64, "Snapshot.colourGridBuffer" + i);
 			if (usingOverlay) {
 				this.overlayTileGrids[i] = Array.matrix(Type.Uint16, height, width, 0, this.allocator, "Snapshot.overlayTileGrid" + i, false);
-				this.overlayBuffers[i] = Array.matrix(Type.Uint32, 1, this.defaultTiles * 64, 0, this.allocator, "Snapshot.overlayGridBuffer" + i, false);
+				this.overlayBuffers[i] = this.createBuffer(this.overlayBuffers[i], this.defaultTiles * 64, "Snapshot.overlayGridBuffer" + i);
 			}
 			this.bufferUsed[i] = true;
 
@@ -1308,6 +2007,11 @@ This file is part of LifeViewer
 		}
 
 		// update the zoom box
+		this.moveSnapshotBoxes(snapshot, xOffsetPixels, yOffsetPixels);
+	};
+
+	// move the zoom and HROT boxes of a snapshot
+	SnapshotManager.prototype.moveSnapshotBoxes = function(/** @type {Snapshot} */ snapshot, /** @type {number} */ xOffsetPixels, /** @type {number} */ yOffsetPixels) {
 		snapshot.zoomBox.leftX += xOffsetPixels;
 		snapshot.zoomBox.rightX += xOffsetPixels;
 		snapshot.zoomBox.bottomY += yOffsetPixels;
@@ -1332,10 +2036,26 @@ This file is part of LifeViewer
 		i = 0;
 		l = this.snapshots.length;
 		while (i < l) {
-			this.resizeSnapshot(this.snapshots[i], newWidth, newHeight, xOffset, yOffset, xOffsetPixels, yOffsetPixels, useOverlay);
+			if (this.snapshots[i].index !== -1) {
+				this.resizeSnapshot(this.snapshots[i], newWidth, newHeight, xOffset, yOffset, xOffsetPixels, yOffsetPixels, useOverlay);
+			} else {
+				this.moveSnapshotBoxes(this.snapshots[i], xOffsetPixels, yOffsetPixels);
+			}
 			i += 1;
 		}
 
+		// if the grid has grown then packed snapshots just record their new position, otherwise they are cleared like the buffers
+		if (xOffset > 0 || yOffset > 0) {
+			for (i = 0; i < l; i += 1) {
+				if (this.snapshots[i].packed !== null) {
+					this.snapshots[i].packedXOffset += xOffset;
+					this.snapshots[i].packedYOffset += yOffset;
+				}
+			}
+		} else {
+			this.resizePacked(newWidth, newHeight, xOffset, yOffset);
+		}
+
 		// grow any unallocated buffers
 		i = 0;
 		while (i < this.bufferUsed.length) {
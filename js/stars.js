@@ -57,9 +57,20 @@ This file is part of LifeViewer
 
 		// save the allocator
 		/** @type {Allocator} */ this.allocator = allocator;
+		allocator.registerOwner(this);
 
 		// whether initialized
 		/** @type {boolean} */ this.initialized = false;
+
+		// WASM copies of the stars and tables (allocated at the top of memory so reset when the display is resized)
+		/** @type {Float32Array} */ this.wasmX = null;
+		/** @type {Float32Array} */ this.wasmY = null;
+		/** @type {Float32Array} */ this.wasmZ = null;
+		/** @type {Float32Array} */ this.wasmSin = null;
+		/** @type {Float32Array} */ this.wasmCos = null;
+
+		// top of memory reset count the WASM copies were made for (-1 if not made)
+		/** @type {number} */ this.wasmTopResets = -1;
 	}
 
 	// initialise stars
@@ -289,3 +300,40 @@ This file is part of LifeViewer
 			}
 		}
 	};
+
+	// copy the stars and tables to the top of WASM memory if they are not there
+	// (call before getting the display buffer since the allocations may grow the heap and move it)
+	Stars.prototype.allocateWASM = function() {
+		var	/** @const {number} */ tableSize = this.circleDegrees * this.degreeParts;
+
+		// check if initialized
+		if (!this.initialized) {
+			this.init(8192, 8192, 1024);
+			this.initialized = true;
+		}
+
+		// resizing the display frees the top of memory so copy the stars again
+		if (this.wasmTopResets !== this.allocator.numTopResets) {
+			this.wasmX = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, this.numStars, "Stars.wasmX", true));
+			this.wasmY = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, this.numStars, "Stars.wasmY", true));
+			this.wasmZ = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, this.numStars, "Stars.wasmZ", true));
+			this.wasmSin = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, tableSize, "Stars.wasmSin", true));
+			this.wasmCos = /** @type {!Float32Array} */ (this.allocator.allocateTop(Type.Float32, tableSize, "Stars.wasmCos", true));
+			this.wasmX.set(this.x);
+			this.wasmY.set(this.y);
+			this.wasmZ.set(this.z);
+			this.wasmSin.set(this.sin);
+			this.wasmCos.set(this.cos);
+			this.wasmTopResets = this.allocator.numTopResets;
+		}
+	};
+
+	// convert stars to display position using WASM (allocateWASM must have been called first)
+	Stars.prototype.create2DWASM = function(/** @type {number} */ xOff, /** @type {number} */ yOff, /** @type {number} */ zOff, /** @type {number} */ angle, /** @type {number} */ displayWidth, /** @type {number} */ displayHeight, /** @type {Uint32Array} */ pixelBuffer, /** @type {number} */ blackPixel) {
+		var	/** @const {Colour} */ starColour = this.starColour;
+
+		WASM.renderStars(this.wasmX.byteOffset | 0, this.wasmY.byteOffset | 0, this.wasmZ.byteOffset | 0, this.numStars,
+			this.wasmSin.byteOffset | 0, this.wasmCos.byteOffset | 0, this.circleDegrees, this.degreeParts,
+			pixelBuffer.byteOffset | 0, displayWidth, displayHeight, xOff, yOff, zOff, angle,
+			blackPixel, (0xff << 24) | (starColour.blue << 16) | (starColour.green << 8) | starColour.red);
+	};
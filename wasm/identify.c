@@ -4,8 +4,10 @@
 //
 // Identify
 //	updateOccupancyStrict
+//	updateOccupancyStrictExtended
 //	updateCellCounts
 //	updateCellCountsSuperOrRuleLoader
+//	updateCellCountsExtended
 //	getHashTwoState
 // 	getHashRuleLoaderOrPCAOrExtended
 //	getHashGenerations
@@ -230,6 +232,102 @@ void updateOccupancyStrictSuperOrRuleLoader(
 	}
 }
 
+EMSCRIPTEN_KEEPALIVE
+// update cell occupancy for rotor and stator calculation
+void updateOccupancyStrictExtended(
+	uint8_t *const colourGrid,
+	uint16_t *const frames,
+	const uint32_t bottom,
+	const uint32_t left,
+	const uint32_t top,
+	const uint32_t right,
+	const int32_t generation,
+	const int32_t bitRowInBytes,
+	const int32_t bitFrameInBytes,
+	int32_t bitStart,
+	const int32_t colourGridWidth
+) {
+	// occupied cells are any non-zero state
+	const v128_t zeroVec = wasm_i8x16_splat(0);
+
+	// reverse byte order
+	const v128_t reverse = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// get the frame for this generation
+	uint32_t rowOffset = generation * bitFrameInBytes;
+
+	// align row to 16 bytes
+	const uint32_t align16Left = (left + 15) & ~15;
+	const uint32_t align16Right = right & ~15;
+
+	// compute the first target (either the start of a 16 byte run or if smaller the right)
+	const uint32_t leftTarget = align16Left > right + 1 ? right + 1 : align16Left;
+	const uint32_t leftDelta = leftTarget - left;
+
+	for (uint32_t y = bottom; y <= top; y++) {
+		// find the start of the row for this generation frame
+		uint16_t *frameRow = frames + rowOffset;
+
+		// process the left section
+		uint32_t frameBits = 0;
+		uint32_t x = left;
+		int32_t bit = bitStart;
+
+		// read the first cells on the row up to 16 byte alignment or right edge (whichever comes first)
+		uint8_t *colourRow = colourGrid + y * colourGridWidth + x;
+
+		while (x < leftTarget) {
+			if (*colourRow) {
+				frameBits |= bit;
+			}
+			bit >>= 1;
+			colourRow++;
+			x++;
+		}
+
+		// do the rest of the row in 16 cell chunks
+		while (x < align16Right) {
+			// get the next 16 cells
+			v128_t row = wasm_v128_load(colourRow);
+			row = wasm_i8x16_ne(row, zeroVec);
+			row = wasm_i8x16_swizzle(row, reverse);
+			const uint32_t mask = wasm_i8x16_bitmask(row);
+
+			// merge the frame mask with the last one
+			const uint32_t writeMask = frameBits | (mask >> leftDelta);
+			*frameRow = writeMask;
+			frameRow++;
+
+			frameBits = mask << (16 - leftDelta);
+			x += 16;
+			colourRow += 16;
+		}
+
+		while (x <= right) {
+			if (*colourRow) {
+				frameBits |= bit;
+			}
+			bit >>= 1;
+			if (bit == 0) {
+				bit = bitStart;
+				*frameRow = frameBits;
+				frameRow++;
+				frameBits = 0;
+			}
+			colourRow++;
+			x++;
+		}
+
+		if (bit != bitStart) {
+			*frameRow = frameBits;
+		}
+
+		// next row
+		rowOffset += bitRowInBytes;
+	}
+}
+
+
 
 EMSCRIPTEN_KEEPALIVE
 // update the cell counts for strict volatility
@@ -370,6 +468,141 @@ void updateCellCountsSuperOrRuleTree(
 	}
 }
 
+// classify a single Extended cell for cell counts
+static inline void updateCellCountExtended(
+	const uint8_t state,
+	uint32_t *const count,
+	uint32_t *const stats
+) {
+	switch (state) {
+		case 0:
+			break;
+
+		case 3:
+			stats[0]++;
+			break;
+
+		case 6:
+		case 10:
+		case 12:
+		case 19:
+			stats[1]++;
+			(*count)++;
+			break;
+
+		case 7:
+		case 11:
+		case 13:
+		case 20:
+			stats[0]++;
+			stats[2]++;
+			break;
+
+		default:
+			(*count)++;
+			break;
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// update the cell counts for strict volatility for Extended rules
+// returns population reduction, births and deaths in shared
+void updateCellCountsExtended(
+	uint8_t *const colourGrid,
+	uint32_t *counts,
+	const uint32_t bottom,
+	const uint32_t left,
+	const uint32_t top,
+	const uint32_t right,
+	const int32_t colourGridWidth,
+	uint32_t *shared
+) {
+	// states that remove a cell from the population
+	const v128_t state3 = wasm_i8x16_splat(3);
+	const v128_t state7 = wasm_i8x16_splat(7);
+	const v128_t state11 = wasm_i8x16_splat(11);
+	const v128_t state13 = wasm_i8x16_splat(13);
+	const v128_t state20 = wasm_i8x16_splat(20);
+
+	// states that are births
+	const v128_t state6 = wasm_i8x16_splat(6);
+	const v128_t state10 = wasm_i8x16_splat(10);
+	const v128_t state12 = wasm_i8x16_splat(12);
+	const v128_t state19 = wasm_i8x16_splat(19);
+
+	const v128_t zeroVec = wasm_i8x16_splat(0);
+
+	// population reduction, births and deaths
+	uint32_t stats[3] = {0, 0, 0};
+
+	// align row to 16 bytes
+	const uint32_t align16Left = (left + 15) & ~15;
+	const uint32_t align16Right = right & ~15;
+
+	// compute the first target (either the start of a 16 byte run or if smaller the right)
+	const uint32_t leftTarget = align16Left > right + 1 ? right + 1 : align16Left;
+
+	// process each row
+	for (uint32_t y = bottom; y <= top; y++) {
+		uint32_t x = left;
+
+		// read the first cells on the row up to 16 byte alignment or right edge (whichever comes first)
+		uint8_t* colourRow = colourGrid + y * colourGridWidth + x;
+
+		while (x < leftTarget) {
+			updateCellCountExtended(*colourRow, counts, stats);
+			colourRow++;
+			counts++;
+			x++;
+		}
+
+		// do the rest of the row in 16 cell chunks
+		while (x < align16Right) {
+			// get the next 16 cells
+			const v128_t row = wasm_v128_load(colourRow);
+
+			// skip empty chunks
+			if (wasm_v128_any_true(row)) {
+				const v128_t died = wasm_v128_or(wasm_v128_or(wasm_i8x16_eq(row, state7), wasm_i8x16_eq(row, state11)), wasm_v128_or(wasm_i8x16_eq(row, state13), wasm_i8x16_eq(row, state20)));
+				const v128_t removed = wasm_v128_or(died, wasm_i8x16_eq(row, state3));
+				const v128_t born = wasm_v128_or(wasm_v128_or(wasm_i8x16_eq(row, state6), wasm_i8x16_eq(row, state10)), wasm_v128_or(wasm_i8x16_eq(row, state12), wasm_i8x16_eq(row, state19)));
+				const v128_t counted = wasm_v128_andnot(wasm_i8x16_ne(row, zeroVec), removed);
+
+				stats[0] += __builtin_popcount(wasm_i8x16_bitmask(removed));
+				stats[1] += __builtin_popcount(wasm_i8x16_bitmask(born));
+				stats[2] += __builtin_popcount(wasm_i8x16_bitmask(died));
+
+				// increment counts for those that are alive
+				uint16_t mask = wasm_i8x16_bitmask(counted);
+				while (mask) {
+					uint32_t i = __builtin_ctz(mask);
+					*(counts + i) += 1;
+					mask &= (mask - 1);
+				}
+			}
+
+			// next chunk
+			counts += 16;
+			colourRow += 16;
+			x += 16;
+		}
+
+		while (x <= right) {
+			updateCellCountExtended(*colourRow, counts, stats);
+			colourRow++;
+			counts++;
+			x++;
+		}
+	}
+
+	// return the statistics
+	shared[0] = stats[0];
+	shared[1] = stats[1];
+	shared[2] = stats[2];
+}
+
+
 
 EMSCRIPTEN_KEEPALIVE
 // create a hash from the colour grid for two state algo
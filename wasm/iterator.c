@@ -8,21 +8,29 @@
 //	convertToPensNeighbours (Life-like)
 //	nextGeneration (Life-like)
 //	nextGenerationGenerations (Generations)
+//	nextGenerationGenerationsBitSliced (Generations)
 //	nextGenerationSuperMoore (Super, Moore)
 //	nextGenerationSuperHex (Super, Hex)
 //	nextGenerationSuperVN (Super, von Neumann)
 //	nextGenerationInvestigatorMoore (Investigator, Moore)
 //	nextGenerationInvestigatorHex (Investigator, Hex)
 //	nextGenerationInvestigatorVN (Investigator, von Neumann)
+//	nextGenerationInvestigatorBitSliced (Investigator)
 //	nextGenerationRuleTreeMoore (RuleTree, Moore)
 //	nextGenerationRuleTreeMoorePartial4 (RuleTree, Moore)
 //	nextGenerationRuleTreeVN (RuleTree, von Neumann)
 //	nextGenerationRuleTableMoore (RuleTable, Moore)
 //	nextGenerationRuleTableHex (RuleTable, Moore)
 //	nextGenerationRuleTableVN (RuleTable, Moore)
+//	nextGenerationRuleTable1D (RuleTable, 1D)
 //	nextGenerationRuleLoaderMooreLookupN (RuleLoader, Moore)
 //	nextGenerationRuleLoaderVNLookupN (RuleLoader, von Neumann)
 //	nextGenerationRuleLoaderHexLookupN (RuleLoader, Hex)
+//	nextGenerationRuleLoaderBits (RuleLoader, 2-state)
+//	nextGenerationMargolus (Margolus)
+//	nextGenerationPCA (PCA)
+//	nextGenerationTriangularLife (Triangular)
+//	nextGenerationWolfram1D (Wolfram)
 //	resetColourGridNormal (Life-like)
 //	resetPopulationBit (Life-like)
 //	resetBoxesBit (Life-like)
@@ -613,6 +621,7 @@ void convertToPens2(
 	uint8_t *const colourGrid,
 	uint16_t *const colourTileHistoryGrid,
 	uint16_t *const colourTileGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const int32_t tileY,
 	const int32_t tileX,
 	const int32_t tileRows,
@@ -642,6 +651,7 @@ void convertToPens2(
 			// get the next tile group
 			uint16_t tiles = tileGrid[tw + tileRowOffset] | colourTileGrid[tw + tileRowOffset];
 			uint16_t nextTiles = 0;
+			uint16_t changedTiles = 0;
 
 			// process each tile in the tile group
 			while (tiles) {
@@ -651,6 +661,7 @@ void convertToPens2(
 
 				uint32_t currentX = leftX + xSize * (15 - b);
 				uint32_t tileAlive = 0;
+				uint32_t tileChanged = 0;
 
 				const uint32_t colourRowOffset = (th << 4) * colourGridWidth;
 				const uint32_t gridRowOffset = (th << 4) * gridWidth;
@@ -682,6 +693,9 @@ void convertToPens2(
 						// convert to 64 alive, 0 dead
 						cells = wasm_v128_and(cells, penBaseSet);
 
+						// check whether any pens changed
+						tileChanged |= wasm_v128_any_true(wasm_v128_xor(wasm_v128_load(colourRow), cells));
+
 						// store updated pens back to memory
 						wasm_v128_store(colourRow, cells);
 
@@ -691,6 +705,7 @@ void convertToPens2(
 						//tileAlive |= wasm_u32x4_extract_lane(cells, 0);
 						tileAlive |= wasm_v128_any_true(cells);
 					} else {
+						tileChanged |= wasm_v128_any_true(wasm_v128_load(colourRow));
 						wasm_v128_store(colourRow, zero);
 					}
 
@@ -703,11 +718,17 @@ void convertToPens2(
 				if (tileAlive) {
 					nextTiles |= (1 << b);
 				}
+
+				// if any pens changed then the tile is dirty
+				if (tileChanged) {
+					changedTiles |= (1 << b);
+				}
 			}
 
 			// save updated tiles
 			colourTileGrid[tw + tileRowOffset] = nextTiles;
 			colourTileHistoryGrid[tw + tileRowOffset] |= nextTiles;
+			colourTileDirtyGrid[tw + tileRowOffset] |= changedTiles;
 
 			// next tile group
 			leftX += xSize << 4;
@@ -727,6 +748,7 @@ void convertToPensAge(
 	uint8_t *const colourGrid,
 	uint16_t *const colourTileHistoryGrid,
 	uint16_t *const colourTileGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const int32_t tileY,
 	const int32_t tileX,
 	const int32_t tileRows,
@@ -760,6 +782,7 @@ void convertToPensAge(
 			// get the next tile group
 			uint16_t tiles = tileGrid[tw + tileRowOffset] | colourTileGrid[tw + tileRowOffset];
 			uint16_t nextTiles = 0;
+			uint16_t changedTiles = 0;
 
 			// process each tile in the tile group
 			while (tiles) {
@@ -769,6 +792,7 @@ void convertToPensAge(
 
 				uint32_t currentX = leftX + xSize * (15 - b);
 				uint32_t tileAlive = 0;
+				uint32_t tileChanged = 0;
 
 				const uint32_t colourRowOffset = (th << 4) * colourGridWidth;
 				const uint32_t gridRowOffset = (th << 4) * gridWidth;
@@ -830,9 +854,15 @@ void convertToPensAge(
 					pensNeedingSat = wasm_v128_and(pensNeedingSat, pensWereNotZero);
 					pensDead = wasm_v128_bitselect(penMinClear, pensDead, pensNeedingSat);
 
+					// keep the original pens to check for changes
+					v128_t oldPens = pens;
+
 					// now pick the dead or alive result based on the cells
 					pens = wasm_v128_bitselect(pensAlive, pensDead, cells);
 
+					// check whether any pens changed
+					tileChanged |= wasm_v128_any_true(wasm_v128_xor(oldPens, pens));
+
 					// store updated pens back to memory
 					wasm_v128_store(colourRow, pens);
 
@@ -850,11 +880,17 @@ void convertToPensAge(
 				if (tileAlive & 0xfefefefe) {
 					nextTiles |= (1 << b);
 				}
+
+				// if any pens changed then the tile is dirty
+				if (tileChanged) {
+					changedTiles |= (1 << b);
+				}
 			}
 
 			// save updated tiles
 			colourTileGrid[tw + tileRowOffset] = nextTiles;
 			colourTileHistoryGrid[tw + tileRowOffset] |= nextTiles;
+			colourTileDirtyGrid[tw + tileRowOffset] |= changedTiles;
 
 			// next tile group
 			leftX += xSize << 4;
@@ -874,6 +910,7 @@ void convertToPensNeighbours(
 	uint8_t *const colourGrid,
 	uint16_t *const colourTileHistoryGrid,
 	uint16_t *const colourTileGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const int32_t tileY,
 	const int32_t tileX,
 	const int32_t tileRows,
@@ -906,6 +943,7 @@ void convertToPensNeighbours(
 			// get the next tile group
 			uint16_t tiles = tileGrid[tw + tileRowOffset] | colourTileGrid[tw + tileRowOffset];
 			uint16_t nextTiles = 0;
+			uint16_t changedTiles = 0;
 
 			// process each tile in the tile group
 			while (tiles) {
@@ -915,6 +953,7 @@ void convertToPensNeighbours(
 
 				uint32_t currentX = leftX + xSize * (15 - b);
 				uint32_t tileAlive = 0;
+				uint32_t tileChanged = 0;
 
 				const uint32_t colourRowOffset = (th << 4) * colourGridWidth;
 				const uint32_t gridRowOffset = (th << 4) * gridWidth;
@@ -1044,12 +1083,16 @@ void convertToPensNeighbours(
 							pens = wasm_u8x16_replace_lane(pens, 15, sum);
 						}
 
+						// check whether any pens changed
+						tileChanged |= wasm_v128_any_true(wasm_v128_xor(wasm_v128_load(colourRow), pens));
+
 						// store updated pens back to memory
 						wasm_v128_store(colourRow, pens);
 
 						// update the tile alive flags
 						tileAlive |= wasm_v128_any_true(pens);
 					} else {
+						tileChanged |= wasm_v128_any_true(wasm_v128_load(colourRow));
 						wasm_v128_store(colourRow, zeroVec);
 					}
 
@@ -1062,11 +1105,17 @@ void convertToPensNeighbours(
 				if (tileAlive & 0xfefefefe) {
 					nextTiles |= (1 << b);
 				}
+
+				// if any pens changed then the tile is dirty
+				if (tileChanged) {
+					changedTiles |= (1 << b);
+				}
 			}
 
 			// save updated tiles
 			colourTileGrid[tw + tileRowOffset] = nextTiles;
 			colourTileHistoryGrid[tw + tileRowOffset] |= nextTiles;
+			colourTileDirtyGrid[tw + tileRowOffset] |= changedTiles;
 
 			// next tile group
 			leftX += xSize << 4;
@@ -1272,6 +1321,295 @@ void nextGenerationGenerations(
 }
 
 
+// load the 16bit words for 8 consecutive rows into a vector
+static inline v128_t loadRows8(
+	const uint16_t *const row,
+	const uint32_t stride
+) {
+	return wasm_u16x8_make(row[0], row[stride], row[stride * 2], row[stride * 3], row[stride * 4], row[stride * 5], row[stride * 6], row[stride * 7]);
+}
+
+// store a vector into the 16bit words for 8 consecutive rows
+static inline void storeRows8(
+	uint16_t *const row,
+	const uint32_t stride,
+	const v128_t rows
+) {
+	row[0] = wasm_u16x8_extract_lane(rows, 0);
+	row[stride] = wasm_u16x8_extract_lane(rows, 1);
+	row[stride * 2] = wasm_u16x8_extract_lane(rows, 2);
+	row[stride * 3] = wasm_u16x8_extract_lane(rows, 3);
+	row[stride * 4] = wasm_u16x8_extract_lane(rows, 4);
+	row[stride * 5] = wasm_u16x8_extract_lane(rows, 5);
+	row[stride * 6] = wasm_u16x8_extract_lane(rows, 6);
+	row[stride * 7] = wasm_u16x8_extract_lane(rows, 7);
+}
+
+// count the set bits in a vector
+static inline uint32_t popcountVec(
+	const v128_t bits
+) {
+	const v128_t counts = wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(wasm_i8x16_popcnt(bits)));
+
+	return wasm_u32x4_extract_lane(counts, 0) + wasm_u32x4_extract_lane(counts, 1) + wasm_u32x4_extract_lane(counts, 2) + wasm_u32x4_extract_lane(counts, 3);
+}
+
+// mask of cells in bit planes whose state is greater than the given value
+static inline v128_t planesGreaterThan(
+	const v128_t *const planes,
+	const uint32_t numPlanes,
+	const uint32_t value
+) {
+	v128_t greater = wasm_i64x2_splat(0);
+	v128_t equal = wasm_i64x2_splat(-1);
+
+	// no state can be greater than a value that needs more planes
+	if (value >> numPlanes) {
+		return greater;
+	}
+
+	// compare from the most significant plane down
+	for (int32_t k = numPlanes - 1; k >= 0; k--) {
+		if ((value >> k) & 1) {
+			equal = wasm_v128_and(equal, planes[k]);
+		} else {
+			greater = wasm_v128_or(greater, wasm_v128_and(equal, planes[k]));
+			equal = wasm_v128_andnot(equal, planes[k]);
+		}
+	}
+
+	return greater;
+}
+
+// mask of cells in bit planes whose state is equal to the given value
+static inline v128_t planesEqual(
+	const v128_t *const planes,
+	const uint32_t numPlanes,
+	const uint32_t value
+) {
+	v128_t equal = wasm_i64x2_splat(-1);
+
+	for (uint32_t k = 0; k < numPlanes; k++) {
+		if ((value >> k) & 1) {
+			equal = wasm_v128_and(equal, planes[k]);
+		} else {
+			equal = wasm_v128_andnot(equal, planes[k]);
+		}
+	}
+
+	return equal;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// Generations update using one bit plane per state bit so births, decay and statistics are computed 128 cells at a time
+// the bit planes are stored per 16x16 tile (16 consecutive words per tile per plane) and the colour grid is only written for rows that changed
+void nextGenerationGenerationsBitSliced(
+	uint8_t *const colourGrid,
+	uint16_t *const colourTileHistoryGrid,
+	uint16_t *const colourTileGrid,
+	const int32_t tileRows,
+	const int32_t tileCols,
+	uint16_t *const grid,
+	uint16_t *const tileGrid,
+	const int32_t colourGridWidth,
+	uint32_t *shared,
+	const uint32_t deadState,
+	const uint32_t maxGenState,
+	const uint32_t minDeadState,
+	const uint32_t width,
+	const uint32_t height,
+	uint16_t *const planes,
+	const uint32_t numPlanes,
+	const uint32_t rebuildPlanes
+) {
+	uint32_t tileRowOffset = 0;
+
+	const uint32_t tileCols16 = tileCols >> 4;
+	const uint32_t tileGridWidth = colourGridWidth >> 8;
+	const uint32_t gridWidth = colourGridWidth >> 4;
+	const uint32_t planeSize = gridWidth * height;
+
+	const v128_t zeroVec = wasm_i64x2_splat(0);
+	const v128_t maskVec = wasm_u64x2_splat(0x0102040810204080);	// mask to isolate cell bits
+	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// bounding box
+	uint32_t newLeftX = width;
+	uint32_t newRightX = 0;
+	uint32_t newBottomY = height;
+	uint32_t newTopY = 0;
+
+	// population statistics
+	uint32_t population = 0;
+	uint32_t births = 0;
+	uint32_t deaths = 0;
+
+	// rebuild the bit planes from the colour grid if it was changed outside this function
+	if (rebuildPlanes) {
+		for (int32_t th = 0; th < tileRows; th++) {
+			for (uint32_t tx = 0; tx < gridWidth; tx++) {
+				uint16_t *tilePlanes = planes + ((th * gridWidth + tx) << 4);
+				const uint8_t *colourRow = colourGrid + (th << 4) * colourGridWidth + (tx << 4);
+
+				for (uint32_t y = 0; y < 16; y++) {
+					// reverse the cells so the first cell is in the most significant bit to match the bit grid
+					const v128_t cells = wasm_i8x16_swizzle(wasm_v128_load(colourRow), reverseVec);
+
+					for (uint32_t k = 0; k < numPlanes; k++) {
+						tilePlanes[k * planeSize + y] = wasm_i8x16_bitmask(wasm_i8x16_shl(cells, 7 - k));
+					}
+					colourRow += colourGridWidth;
+				}
+			}
+		}
+	}
+
+	// find each occupied tile group
+	for (int32_t th = 0; th < tileRows; th++) {
+		const uint32_t bottomY = th << 4;
+
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group
+			uint16_t tiles = tileGrid[tw + tileRowOffset] | colourTileGrid[tw + tileRowOffset];
+			uint16_t nextTiles = 0;
+
+			// process each tile in the tile group
+			while (tiles) {
+				// get the next tile
+				uint32_t b = 31 - __builtin_clz(tiles);
+				tiles &= ~(1 << b);
+
+				const uint32_t currentX = (tw << 4) + (15 - b);
+				uint16_t *const gridTile = grid + currentX + bottomY * gridWidth;
+				uint16_t *const tilePlanes = planes + ((th * gridWidth + currentX) << 4);
+
+				uint32_t occupiedRows = 0;
+				uint32_t changedRows = 0;
+				v128_t aliveColumns = zeroVec;
+
+				// process the tile as two sets of 8 rows
+				for (uint32_t half = 0; half < 16; half += 8) {
+					v128_t current[8];
+					v128_t next[8];
+					v128_t changed = zeroVec;
+
+					// get the next 8 rows from the grid evolution (bits) and the state bit planes
+					const v128_t cells = loadRows8(gridTile + half * gridWidth, gridWidth);
+					for (uint32_t k = 0; k < numPlanes; k++) {
+						current[k] = wasm_v128_load(tilePlanes + k * planeSize + half);
+					}
+
+					// find which cells are (<= deadState || == maxGenState) && alive in bit cells
+					const v128_t wasAlive = planesEqual(current, numPlanes, maxGenState);
+					const v128_t setToAlive = wasm_v128_and(
+						cells,
+						wasm_v128_or(
+							wasm_v128_not(planesGreaterThan(current, numPlanes, deadState)),
+							wasAlive
+						)
+					);
+
+					// the other cells decrement if they are bigger than minDeadState
+					v128_t borrow = wasm_v128_andnot(planesGreaterThan(current, numPlanes, minDeadState), setToAlive);
+					for (uint32_t k = 0; k < numPlanes; k++) {
+						next[k] = wasm_v128_xor(current[k], borrow);
+						borrow = wasm_v128_andnot(borrow, current[k]);
+
+						// set the alive cells to maxGenState
+						if ((maxGenState >> k) & 1) {
+							next[k] = wasm_v128_or(next[k], setToAlive);
+						} else {
+							next[k] = wasm_v128_andnot(next[k], setToAlive);
+						}
+
+						// save the plane and note which rows changed
+						wasm_v128_store(tilePlanes + k * planeSize + half, next[k]);
+						changed = wasm_v128_or(changed, wasm_v128_xor(next[k], current[k]));
+					}
+
+					// update the population, births and deaths
+					population += popcountVec(setToAlive);
+					births += popcountVec(wasm_v128_andnot(setToAlive, wasAlive));
+					deaths += popcountVec(wasm_v128_andnot(wasAlive, setToAlive));
+
+					// update cell bit grid
+					storeRows8(gridTile + half * gridWidth, gridWidth, setToAlive);
+
+					// mark changed and occupied rows and alive columns
+					changedRows |= wasm_i16x8_bitmask(wasm_i16x8_ne(changed, zeroVec)) << half;
+					occupiedRows |= wasm_i16x8_bitmask(wasm_i16x8_ne(planesGreaterThan(next, numPlanes, minDeadState), zeroVec)) << half;
+					aliveColumns = wasm_v128_or(aliveColumns, planesGreaterThan(next, numPlanes, deadState));
+				}
+
+				// write the colour grid rows that changed
+				while (changedRows) {
+					const uint32_t y = __builtin_ctz(changedRows);
+					changedRows &= changedRows - 1;
+
+					v128_t colourVec = zeroVec;
+					for (uint32_t k = 0; k < numPlanes; k++) {
+						const uint32_t bits = tilePlanes[k * planeSize + y];
+
+						if (bits) {
+							// expand the 16 bits into 16 lanes and add the plane value
+							v128_t expanded = wasm_v8x16_shuffle(
+								wasm_u8x16_splat(bits >> 8),
+								wasm_u8x16_splat(bits & 0xff),
+								0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23
+							);
+							expanded = wasm_u8x16_gt(wasm_v128_and(expanded, maskVec), zeroVec);
+							colourVec = wasm_v128_or(colourVec, wasm_v128_and(expanded, wasm_u8x16_splat(1 << k)));
+						}
+					}
+					wasm_v128_store(colourGrid + (bottomY + y) * colourGridWidth + (currentX << 4), colourVec);
+				}
+
+				// update the bounding box if this tile has occupied cells
+				if (occupiedRows) {
+					nextTiles |= (1 << b);
+
+					if (bottomY + __builtin_ctz(occupiedRows) < newBottomY) {
+						newBottomY = bottomY + __builtin_ctz(occupiedRows);
+					}
+					if (bottomY + 31 - __builtin_clz(occupiedRows) > newTopY) {
+						newTopY = bottomY + 31 - __builtin_clz(occupiedRows);
+					}
+
+					// combine the alive columns from each row (first cell is in the most significant bit)
+					aliveColumns = wasm_v128_or(aliveColumns, wasm_i32x4_shuffle(aliveColumns, aliveColumns, 2, 3, 0, 1));
+					aliveColumns = wasm_v128_or(aliveColumns, wasm_i32x4_shuffle(aliveColumns, aliveColumns, 1, 0, 3, 2));
+					const uint32_t aliveBits = (wasm_u32x4_extract_lane(aliveColumns, 0) | (wasm_u32x4_extract_lane(aliveColumns, 0) >> 16)) & 0xffff;
+
+					if (aliveBits) {
+						if ((currentX << 4) + __builtin_clz(aliveBits) - 16 < newLeftX) {
+							newLeftX = (currentX << 4) + __builtin_clz(aliveBits) - 16;
+						}
+						if ((currentX << 4) + 15 - __builtin_ctz(aliveBits) > newRightX) {
+							newRightX = (currentX << 4) + 15 - __builtin_ctz(aliveBits);
+						}
+					}
+				}
+			}
+
+			colourTileGrid[tw + tileRowOffset] = nextTiles;
+			colourTileHistoryGrid[tw + tileRowOffset] |= nextTiles;
+		}
+
+		tileRowOffset += tileGridWidth;
+	}
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+	*shared++ = newLeftX;
+	*shared++ = newBottomY;
+	*shared++ = newRightX;
+	*shared++ = newTopY;
+}
+
+
 EMSCRIPTEN_KEEPALIVE
 // update the life grid region using tiles
 void nextGeneration(
@@ -2082,6 +2420,7 @@ void nextGenerationSuperMoore(
 	uint16_t *const nextTileGrid16,
 	uint16_t *const colourTileGrid,
 	uint16_t *const colourTileHistoryGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const uint32_t tileGridWidth,
 	uint8_t *const colourGrid8,
 	uint8_t *const nextColourGrid8,
@@ -2161,6 +2500,7 @@ void nextGenerationSuperMoore(
 		uint16_t *tileGridRow = tileGrid + th * tileGridWidth;
 		uint16_t *colourTileRow = colourTileGrid + th * tileGridWidth;
 		uint16_t *colourTileHistoryRow = colourTileHistoryGrid + th * tileGridWidth;
+		uint16_t *colourTileDirtyRow = colourTileDirtyGrid + th * tileGridWidth;
 
 		// scan each set of tiles
 		for (uint32_t tw = 0; tw < tileCols16; tw++) {
@@ -2188,6 +2528,9 @@ void nextGenerationSuperMoore(
 				// clear type mask
 				uint32_t typeMask = 0;
 
+				// mark no cells changed in the tile
+				uint32_t tileChanged = 0;
+
 				// process each row
 				for (uint32_t h = bottomY; h < topY; h++) {
 					// get correct starting colour index
@@ -2383,6 +2726,7 @@ void nextGenerationSuperMoore(
 
 						// output new cell state
 						*destRow = value;
+						tileChanged |= value ^ c;
 						destRow++;
 
 						if (value > 0) {
@@ -2404,6 +2748,11 @@ void nextGenerationSuperMoore(
 					rowIndex >>= 1;
 				}
 
+				// if any cells changed then the tile is dirty
+				if (tileChanged) {
+					colourTileDirtyRow[tw] |= (1 << b);
+				}
+
 				columnOccupied16[leftX] |= colOccupied;
 				rowOccupied16[th] |= rowOccupied;
 				columnAliveOccupied16[leftX] |= colAliveOccupied;
@@ -2444,6 +2793,7 @@ void nextGenerationSuperHex(
 	uint16_t *const nextTileGrid16,
 	uint16_t *const colourTileGrid,
 	uint16_t *const colourTileHistoryGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const uint32_t tileGridWidth,
 	uint8_t *const colourGrid8,
 	uint8_t *const nextColourGrid8,
@@ -2522,6 +2872,7 @@ void nextGenerationSuperHex(
 		uint16_t *tileGridRow = tileGrid + th * tileGridWidth;
 		uint16_t *colourTileRow = colourTileGrid + th * tileGridWidth;
 		uint16_t *colourTileHistoryRow = colourTileHistoryGrid + th * tileGridWidth;
+		uint16_t *colourTileDirtyRow = colourTileDirtyGrid + th * tileGridWidth;
 
 		// scan each set of tiles
 		for (uint32_t tw = 0; tw < tileCols16; tw++) {
@@ -2549,6 +2900,9 @@ void nextGenerationSuperHex(
 				// clear type mask
 				uint32_t typeMask = 0;
 
+				// mark no cells changed in the tile
+				uint32_t tileChanged = 0;
+
 				// process each row
 				for (uint32_t h = bottomY; h < topY; h++) {
 					// get correct starting colour index
@@ -2740,6 +3094,7 @@ void nextGenerationSuperHex(
 
 						// output new cell state
 						*destRow = value;
+						tileChanged |= value ^ c;
 						destRow++;
 
 						if (value > 0) {
@@ -2766,6 +3121,11 @@ void nextGenerationSuperHex(
 					rowIndex >>= 1;
 				}
 
+				// if any cells changed then the tile is dirty
+				if (tileChanged) {
+					colourTileDirtyRow[tw] |= (1 << b);
+				}
+
 				columnOccupied16[leftX] |= colOccupied;
 				rowOccupied16[th] |= rowOccupied;
 				columnAliveOccupied16[leftX] |= colAliveOccupied;
@@ -2806,6 +3166,7 @@ void nextGenerationSuperVN(
 	uint16_t *const nextTileGrid16,
 	uint16_t *const colourTileGrid,
 	uint16_t *const colourTileHistoryGrid,
+	uint16_t *const colourTileDirtyGrid,
 	const uint32_t tileGridWidth,
 	uint8_t *const colourGrid8,
 	uint8_t *const nextColourGrid8,
@@ -2884,6 +3245,7 @@ void nextGenerationSuperVN(
 		uint16_t *tileGridRow = tileGrid + th * tileGridWidth;
 		uint16_t *colourTileRow = colourTileGrid + th * tileGridWidth;
 		uint16_t *colourTileHistoryRow = colourTileHistoryGrid + th * tileGridWidth;
+		uint16_t *colourTileDirtyRow = colourTileDirtyGrid + th * tileGridWidth;
 
 		// scan each set of tiles
 		for (uint32_t tw = 0; tw < tileCols16; tw++) {
@@ -2911,6 +3273,9 @@ void nextGenerationSuperVN(
 				// clear type mask
 				uint32_t typeMask = 0;
 
+				// mark no cells changed in the tile
+				uint32_t tileChanged = 0;
+
 				// process each row
 				for (uint32_t h = bottomY; h < topY; h++) {
 					// get correct starting colour index
@@ -3101,6 +3466,7 @@ void nextGenerationSuperVN(
 
 						// output new cell state
 						*destRow = value;
+						tileChanged |= value ^ c;
 						destRow++;
 
 						if (value > 0) {
@@ -3122,6 +3488,11 @@ void nextGenerationSuperVN(
 					rowIndex >>= 1;
 				}
 
+				// if any cells changed then the tile is dirty
+				if (tileChanged) {
+					colourTileDirtyRow[tw] |= (1 << b);
+				}
+
 				columnOccupied16[leftX] |= colOccupied;
 				rowOccupied16[th] |= rowOccupied;
 				columnAliveOccupied16[leftX] |= colAliveOccupied;
@@ -4713,9 +5084,76 @@ void nextGenerationInvestigatorVN(
 }
 
 
+// bit-slice 18 cells of an Investigator colour grid row (cell left of the tile, the 16 tile cells, cell right of the tile)
+// into 5 state bit-planes and a membership word for each state set used by the iterator
+static inline void investigatorRowBits(
+	const uint8_t *const row,
+	const uint32_t leftX,
+	const uint32_t width,
+	const uint32_t *const statesToSets,
+	const uint32_t numSets,
+	uint32_t *const planes,
+	uint32_t *const members
+) {
+	const v128_t zeroVec = wasm_u8x16_splat(0);
+	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// get the 16 tile cells with the leftmost cell in the last lane
+	v128_t cellsVec = wasm_i8x16_swizzle(wasm_v128_load(row + leftX), reverseVec);
+
+	// get the cells either side of the tile
+	uint32_t left = leftX > 0 ? row[leftX - 1] : 0;
+	uint32_t right = leftX + 16 < width ? row[leftX + 16] : 0;
+	uint32_t anySet = 0;
+
+	// create the bit-planes
+	for (uint32_t b = 0; b < 5; b++) {
+		v128_t bitVec = wasm_i8x16_splat(1 << b);
+		planes[b] = (wasm_i8x16_bitmask(wasm_i8x16_ne(wasm_v128_and(cellsVec, bitVec), zeroVec)) << 1) | (((left >> b) & 1) << 17) | ((right >> b) & 1);
+		anySet |= planes[b];
+	}
+
+	// clear the set memberships
+	for (uint32_t s = 0; s < numSets; s++) {
+		members[s] = 0;
+	}
+
+	// add each non-zero state to the sets it belongs to
+	if (anySet) {
+		for (uint32_t k = 1; k < 21; k++) {
+			uint32_t match = 262143;
+			for (uint32_t b = 0; b < 5; b++) {
+				match &= (k & (1 << b)) ? planes[b] : ~planes[b];
+			}
+
+			if (match) {
+				for (uint32_t s = 0; s < numSets; s++) {
+					if (statesToSets[k] & (1 << s)) {
+						members[s] |= match;
+					}
+				}
+			}
+		}
+	}
+}
+
+
+// return the 16 cells that have a neighbour in the set given the membership words for the row above, the row and the row below
+static inline uint32_t investigatorNeighbours(
+	const uint32_t member0,
+	const uint32_t member1,
+	const uint32_t member2,
+	const uint32_t *const neighbourMasks
+) {
+	return (((member0 >> 2) & neighbourMasks[0]) | ((member0 >> 1) & neighbourMasks[1]) | (member0 & neighbourMasks[2]) |
+		((member1 >> 2) & neighbourMasks[3]) | (member1 & neighbourMasks[4]) |
+		((member2 >> 2) & neighbourMasks[5]) | ((member2 >> 1) & neighbourMasks[6]) | (member2 & neighbourMasks[7])) & 65535;
+}
+
+
 EMSCRIPTEN_KEEPALIVE
-// compute RuleTree rule next generation for Moore neighbourhood
-void nextGenerationRuleTreeMoore(
+// compute Investigator rule next generation for any neighbourhood using bit-planes
+void nextGenerationInvestigatorBitSliced(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -4729,9 +5167,9 @@ void nextGenerationRuleTreeMoore(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint32_t *const a,
-	uint8_t *const b,
-	const uint32_t base,
+	uint8_t *const indexLookup631,
+	uint8_t *const indexLookup632,
+	const uint32_t neighbourMask,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -4739,8 +5177,9 @@ void nextGenerationRuleTreeMoore(
 	const uint32_t tileCols,
 	uint16_t *const blankTileRow,
 	const uint32_t blankTileRowWidth,
-	uint8_t *const blankColourRow,
 	const uint32_t counter,
+	const uint32_t altSpecified,
+	const uint8_t *nextStateInvestigator,
 	const uint32_t bottomRightSet,
 	const uint32_t bottomSet,
 	const uint32_t topRightSet,
@@ -4751,8 +5190,6 @@ void nextGenerationRuleTreeMoore(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint8_t n, e, s, w, c, ne, nw, se, sw;
-
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
 
@@ -4762,24 +5199,79 @@ void nextGenerationRuleTreeMoore(
 	// tile columns in 16 bit values
 	const uint32_t tileCols16 = tileCols >> 4;
 
+	// state sets
+	const uint32_t setAlive = 0, setState1 = 1, setTreatIfDead = 2, setTreatIfAlive = 3, setDeadForcer = 4, setBirthForcer = 5, setRequireState1 = 6, numSets = 7;
+	const uint32_t deadForcer = (1 << 2) | (1 << 3) | (1 << 6) | (1 << 7) | (1 << 14) | (1 << 16);
+	const uint32_t birthForcer = (1 << 8) | (1 << 9) | (1 << 12) | (1 << 13) | (1 << 14);
+	const uint32_t requireState1 = (1 << 15) | (1 << 16);
+	const uint32_t treatIfDead = (1 << 1) | (1 << 2) | (1 << 4) | (1 << 6) | (1 << 8) | (1 << 10) | (1 << 12) | (1 << 15) |  (1 << 16) | (1 << 17) | (1 << 19);
+	const uint32_t treatIfAlive = treatIfDead ^ ((1 << 17) | (1 << 18) | (1 << 19) | (1 << 20));
+
 	// constants
 	const v128_t zeroVec = wasm_u8x16_splat(0);
-	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// used to expand 16 bits into 16 cells with bit 15 in the first cell
+	const v128_t expandVec = wasm_u8x16_make(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+	const v128_t bitsVec = wasm_u8x16_make(128, 64, 32, 16, 8, 4, 2, 1, 128, 64, 32, 16, 8, 4, 2, 1);
 
 	// grid
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
 	uint16_t *nextTileGrid = tileGrid16;
+	uint8_t *indexLookup63 = indexLookup631;
 
 	// select the correct grid
-	if ((counter & 1) == 0) {
+	if (counter & 1) {
 		grid = colourGrid;
 		nextGrid = nextColourGrid;
 		tileGrid = tileGrid16;
 		nextTileGrid = nextTileGrid16;
+		if (altSpecified) {
+			indexLookup63 = indexLookup632;
+		}
+	}
+
+	// create the set membership for each state
+	uint32_t statesToSets[21];
+	for (uint32_t k = 0; k < 21; k++) {
+		uint32_t sets = 0;
+		if (k) {
+			sets |= 1 << setAlive;
+		}
+		if (k == 1) {
+			sets |= 1 << setState1;
+		}
+		sets |= ((treatIfDead >> k) & 1) << setTreatIfDead;
+		sets |= ((treatIfAlive >> k) & 1) << setTreatIfAlive;
+		sets |= ((deadForcer >> k) & 1) << setDeadForcer;
+		sets |= ((birthForcer >> k) & 1) << setBirthForcer;
+		sets |= ((requireState1 >> k) & 1) << setRequireState1;
+		statesToSets[k] = sets;
 	}
 
+	// create the fixed transitions for states 2 and above as the set of states that map to each output bit-plane
+	uint32_t nextStatePlanes[5];
+	for (uint32_t b = 0; b < 5; b++) {
+		nextStatePlanes[b] = 0;
+		for (uint32_t k = 2; k < 21; k++) {
+			if (nextStateInvestigator[k] & (1 << b)) {
+				nextStatePlanes[b] |= 1 << k;
+			}
+		}
+	}
+
+	// create the neighbour masks (nw, n, ne, w, e, sw, s, se) from the rule neighbourhood
+	uint32_t neighbourMasks[8];
+	neighbourMasks[0] = (neighbourMask & (1 << 2)) ? 65535 : 0;
+	neighbourMasks[1] = (neighbourMask & (1 << 1)) ? 65535 : 0;
+	neighbourMasks[2] = (neighbourMask & (1 << 0)) ? 65535 : 0;
+	neighbourMasks[3] = (neighbourMask & (1 << 5)) ? 65535 : 0;
+	neighbourMasks[4] = (neighbourMask & (1 << 3)) ? 65535 : 0;
+	neighbourMasks[5] = (neighbourMask & (1 << 8)) ? 65535 : 0;
+	neighbourMasks[6] = (neighbourMask & (1 << 7)) ? 65535 : 0;
+	neighbourMasks[7] = (neighbourMask & (1 << 6)) ? 65535 : 0;
+
 	// clear column occupied flags
 	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
 
@@ -4797,7 +5289,6 @@ void nextGenerationRuleTreeMoore(
 	for (uint32_t th = 0; th < tileRows; th++) {
 		// set initial tile column
 		uint32_t leftX = 0;
-		uint32_t rightX = leftX + xSize;
 
 		// get the colour tile rows
 		uint16_t *tileRow = tileGrid + th * tileGridWidth;
@@ -4849,102 +5340,98 @@ void nextGenerationRuleTreeMoore(
 						uint32_t y = bottomY;
 						uint32_t rowIndex = 32768;
 
-						// process each row of the tile
-						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
-						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
+						// bit-planes and set membership for the row above, the current row and the row below
+						uint32_t planes0[5], planes1[5], planes2[5];
+						uint32_t members0[7], members1[7], members2[7];
+						uint32_t *rowPlanes0 = planes0, *rowPlanes1 = planes1, *rowPlanes2 = planes2;
+						uint32_t *rowMembers0 = members0, *rowMembers1 = members1, *rowMembers2 = members2;
 
-						while (y < topY) {
-							uint8_t *gridRow0 = blankColourRow;
-							uint8_t *gridRow2 = blankColourRow;
+						uint8_t *gridRow1 = grid + y * colourGridWidth;
+						if (y > 0) {
+							investigatorRowBits(gridRow1 - colourGridWidth, leftX, width, statesToSets, numSets, rowPlanes0, rowMembers0);
+						} else {
+							memset(rowMembers0, 0, sizeof(members0));
+						}
+						investigatorRowBits(gridRow1, leftX, width, statesToSets, numSets, rowPlanes1, rowMembers1);
+						investigatorRowBits(gridRow1 + colourGridWidth, leftX, width, statesToSets, numSets, rowPlanes2, rowMembers2);
 
-							// deal with bottom row of the grid
-							if (y > 0) {
-								gridRow0 = gridRow1 - colourGridWidth;
+						// get pointer to destintation row
+						uint8_t *nextRow = nextGrid + y * colourGridWidth;
+
+						// process each row of the tile
+						while (y < topY) {
+							uint32_t output[5] = {0, 0, 0, 0, 0};
+
+							// get the alive and state 1 cells in the row
+							const uint32_t origAlive = (rowMembers1[setAlive] >> 1) & 65535;
+							const uint32_t isOne = (rowMembers1[setState1] >> 1) & 65535;
+
+							if (origAlive || rowMembers0[setAlive] || rowMembers2[setAlive]) {
+								// apply the rule to the cells with neighbours treated as dead or alive depending on the cell state
+								uint32_t val0 = rowMembers0[setTreatIfDead], val1 = rowMembers1[setTreatIfDead], val2 = rowMembers2[setTreatIfDead];
+								uint32_t ruleIfDead = indexLookup63[(val0 >> 12) | (val1 >> 12) << 6 | (val2 & 258048)] << 12;
+								ruleIfDead |= indexLookup63[((val0 >> 8) & 63) | ((val1 >> 2) & 4032) | ((val2 << 4) & 258048)] << 8;
+								ruleIfDead |= indexLookup63[((val0 >> 4) & 63) | ((val1 << 2) & 4032) | ((val2 << 8) & 258048)] << 4;
+								ruleIfDead |= indexLookup63[(val0 & 63) | (val1 & 63) << 6 | (val2 & 63) << 12];
+
+								val0 = rowMembers0[setTreatIfAlive];
+								val1 = rowMembers1[setTreatIfAlive];
+								val2 = rowMembers2[setTreatIfAlive];
+								uint32_t ruleIfAlive = indexLookup63[(val0 >> 12) | (val1 >> 12) << 6 | (val2 & 258048)] << 12;
+								ruleIfAlive |= indexLookup63[((val0 >> 8) & 63) | ((val1 >> 2) & 4032) | ((val2 << 4) & 258048)] << 8;
+								ruleIfAlive |= indexLookup63[((val0 >> 4) & 63) | ((val1 << 2) & 4032) | ((val2 << 8) & 258048)] << 4;
+								ruleIfAlive |= indexLookup63[(val0 & 63) | (val1 & 63) << 6 | (val2 & 63) << 12];
+
+								// dead cells stay dead with no live neighbours, are born next to a birth forcer
+								// and stay dead next to a state that requires state 1 without state 1
+								const uint32_t anyNeighbour = investigatorNeighbours(rowMembers0[setAlive], rowMembers1[setAlive], rowMembers2[setAlive], neighbourMasks);
+								const uint32_t birthForced = investigatorNeighbours(rowMembers0[setBirthForcer], rowMembers1[setBirthForcer], rowMembers2[setBirthForcer], neighbourMasks);
+								const uint32_t needsState1 = investigatorNeighbours(rowMembers0[setRequireState1], rowMembers1[setRequireState1], rowMembers2[setRequireState1], neighbourMasks) &
+									~investigatorNeighbours(rowMembers0[setState1], rowMembers1[setState1], rowMembers2[setState1], neighbourMasks);
+								const uint32_t nextIfDead = anyNeighbour & (birthForced | (~needsState1 & ruleIfDead));
+
+								// live cells die next to a death forcer
+								const uint32_t deathForced = investigatorNeighbours(rowMembers0[setDeadForcer], rowMembers1[setDeadForcer], rowMembers2[setDeadForcer], neighbourMasks);
+								const uint32_t nextIfAlive = ~deathForced & ruleIfAlive;
+
+								output[0] = ((~origAlive & nextIfDead) | (isOne & nextIfAlive)) & 65535;
+
+								// states 2 and above have a fixed next state
+								const uint32_t higher = origAlive & ~isOne;
+								if (higher) {
+									for (uint32_t k = 2; k < 21; k++) {
+										uint32_t match = higher;
+										for (uint32_t b = 0; b < 5; b++) {
+											match &= (k & (1 << b)) ? rowPlanes1[b] >> 1 : ~(rowPlanes1[b] >> 1);
+										}
+
+										if (match) {
+											for (uint32_t b = 0; b < 5; b++) {
+												if (nextStatePlanes[b] & (1 << k)) {
+													output[b] |= match;
+												}
+											}
+										}
+									}
+								}
 							}
-							// deal with top row of the grid
-							if (y < height - 1) {
-								gridRow2 = gridRow1 + colourGridWidth;
+
+							// expand the bit-planes into cells and write the new row
+							v128_t writeVec = zeroVec;
+							uint32_t newAlive = 0;
+							for (uint32_t b = 0; b < 5; b++) {
+								if (output[b]) {
+									v128_t planeVec = wasm_i8x16_swizzle(wasm_i16x8_splat(output[b]), expandVec);
+									planeVec = wasm_i8x16_ne(wasm_v128_and(planeVec, bitsVec), zeroVec);
+									writeVec = wasm_v128_or(writeVec, wasm_v128_and(planeVec, wasm_i8x16_splat(1 << b)));
+									newAlive |= output[b];
+								}
 							}
+							wasm_v128_store(nextRow + leftX, writeVec);
 
-							// process each column in the row
-							uint32_t x = leftX;
-
-							// get original 16 cells
-							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
-
-							// get initial neighbours
-							if (x == 0) {
-								n = 0;
-								c = 0;
-								s = 0;
-							} else {
-								n = *(gridRow0 + x - 1);
-								c = *(gridRow1 + x - 1);
-								s = *(gridRow2 + x - 1);
-							}
-							ne = *(gridRow0 + x);
-							e = *(gridRow1 + x);
-							se = *(gridRow2 + x);
-
-							while (x < rightX - 1) {
-								// shift neighbourhood left
-								nw = n;
-								n = ne;
-								ne = *(gridRow0 + x + 1);
-								w = c;
-								c = e;
-								e = *(gridRow1 + x + 1);
-								sw = s;
-								s = se;
-								se = *(gridRow2 + x + 1);
-
-								// check for higher states
-								uint8_t state = b[a[a[a[a[a[a[a[a[base + nw] + ne] + sw] + se] + n] + w] + e] + s] + c];
-								*(nextRow + x) = state;
-
-								// next column
-								x++;
-							}
-
-							// handle right edge
-							nw = n;
-							n = ne;
-							w = c;
-							c = e;
-							sw = s;
-							s = se;
-							if (x == width - 1) {
-								ne = 0;
-								e = 0;
-								se = 0;
-							} else {
-								ne = *(gridRow0 + x + 1);
-								e = *(gridRow1 + x + 1);
-								se = *(gridRow2 + x + 1);
-							}
-
-							// get the next state
-							uint8_t state = b[a[a[a[a[a[a[a[a[base + nw] + ne] + sw] + se] + n] + w] + e] + s] + c];
-							*(nextRow + x) = state;
-
-							// load new row
-							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
-
-							// get original alive cells
-							v128_t origAliveVec = wasm_u8x16_gt(origCellsVec, zeroVec);
-							uint32_t origAlive = wasm_i8x16_bitmask(origAliveVec);
-
-							// get new alive cells
-							v128_t newAliveVec = wasm_u8x16_gt(newCellsVec, zeroVec);
-							uint32_t newAlive = wasm_i8x16_bitmask(newAliveVec);
-
-							// update births and deaths
-							births += __builtin_popcount(newAlive & ~origAlive);
-							deaths += __builtin_popcount(origAlive & ~newAlive);
-
-							// get new alive cells in correct order
-							newAliveVec = wasm_i8x16_swizzle(newAliveVec, reverseVec);
-							newAlive = wasm_i8x16_bitmask(newAliveVec);
+							// update births and deaths
+							births += __builtin_popcount(newAlive & ~origAlive);
+							deaths += __builtin_popcount(origAlive & ~newAlive);
 
 							// update population
 							population += __builtin_popcount(newAlive);
@@ -4960,10 +5447,28 @@ void nextGenerationRuleTreeMoore(
 							// next row
 							y++;
 							rowIndex >>= 1;
+
+							// move the three source rows up
+							uint32_t *swap = rowPlanes0;
+							rowPlanes0 = rowPlanes1;
+							rowPlanes1 = rowPlanes2;
+							rowPlanes2 = swap;
+							swap = rowMembers0;
+							rowMembers0 = rowMembers1;
+							rowMembers1 = rowMembers2;
+							rowMembers2 = swap;
 							gridRow1 += colourGridWidth;
+
+							// handle bottom of grid
+							if (y < height - 1) {
+								investigatorRowBits(gridRow1 + colourGridWidth, leftX, width, statesToSets, numSets, rowPlanes2, rowMembers2);
+							} else {
+								memset(rowMembers2, 0, sizeof(members2));
+							}
+
+							// next destination row
 							nextRow += colourGridWidth;
 						}
-
 						// update the column and row occupied cells
 						columnOccupied16[leftX >> 4] |= colOccupied;
 
@@ -5096,7 +5601,6 @@ void nextGenerationRuleTreeMoore(
 
 					// next tile columns
 					leftX += xSize;
-					rightX += xSize;
 				}
 
 				// save the tile groups
@@ -5110,7 +5614,6 @@ void nextGenerationRuleTreeMoore(
 			} else {
 				// skip tile set
 				leftX += xSize << 4;
-				rightX += xSize << 4;
 			}
 
 			// update tiles where all cells died
@@ -5143,9 +5646,53 @@ void nextGenerationRuleTreeMoore(
 }
 
 
+// look up the next state for a Moore neighbourhood using a direct-mapped cache of recent neighbourhoods in front of the RuleTree walk
+// each cache entry is 4 words: nw n ne w, c e sw s, se plus a used flag and the resulting state
+static inline uint8_t ruleTreeMooreCached(
+	const uint32_t *const a,
+	const uint8_t *const b,
+	const uint32_t base,
+	uint32_t *const cache,
+	const uint32_t cacheMask,
+	const uint8_t zeroState,
+	const uint32_t nw,
+	const uint32_t n,
+	const uint32_t ne,
+	const uint32_t w,
+	const uint32_t c,
+	const uint32_t e,
+	const uint32_t sw,
+	const uint32_t s,
+	const uint32_t se
+) {
+	const uint32_t key0 = nw | (n << 8) | (ne << 16) | (w << 24);
+	const uint32_t key1 = c | (e << 8) | (sw << 16) | (s << 24);
+
+	// empty neighbourhoods are the most common so avoid the cache
+	if ((key0 | key1 | se) == 0) {
+		return zeroState;
+	}
+
+	// check the cache entry for this neighbourhood
+	const uint32_t key2 = se | 256;
+	uint32_t *const entry = cache + (((((key0 * 0x9e3779b1) ^ (key1 * 0x85ebca77) ^ (se * 0xc2b2ae3d)) >> 16) & cacheMask) << 2);
+	if (entry[0] == key0 && entry[1] == key1 && (entry[2] & 511) == key2) {
+		return entry[2] >> 9;
+	}
+
+	// walk the tree and save the result
+	const uint8_t state = b[a[a[a[a[a[a[a[a[base + nw] + ne] + sw] + se] + n] + w] + e] + s] + c];
+	entry[0] = key0;
+	entry[1] = key1;
+	entry[2] = key2 | (state << 9);
+
+	return state;
+}
+
+
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Moore neighbourhood using 1 bit lookup
-void nextGenerationRuleLoaderMooreLookup1(
+// compute RuleTree rule next generation for Moore neighbourhood
+void nextGenerationRuleTreeMoore(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -5159,7 +5706,11 @@ void nextGenerationRuleLoaderMooreLookup1(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint8_t *const lookup,
+	uint32_t *const a,
+	uint8_t *const b,
+	const uint32_t base,
+	uint32_t *const cache,
+	const uint32_t cacheMask,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -5179,6 +5730,8 @@ void nextGenerationRuleLoaderMooreLookup1(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
+	uint8_t n, e, s, w, c, ne, nw, se, sw;
+
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
 
@@ -5192,7 +5745,10 @@ void nextGenerationRuleLoaderMooreLookup1(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// switch buffers each generation
+	// next state for an empty neighbourhood
+	const uint8_t zeroState = b[a[a[a[a[a[a[a[a[base]]]]]]]]];
+
+	// grid
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -5223,6 +5779,7 @@ void nextGenerationRuleLoaderMooreLookup1(
 	for (uint32_t th = 0; th < tileRows; th++) {
 		// set initial tile column
 		uint32_t leftX = 0;
+		uint32_t rightX = leftX + xSize;
 
 		// get the colour tile rows
 		uint16_t *tileRow = tileGrid + th * tileGridWidth;
@@ -5274,140 +5831,108 @@ void nextGenerationRuleLoaderMooreLookup1(
 						uint32_t y = bottomY;
 						uint32_t rowIndex = 32768;
 
-						// get pointers to the current source row, the row above and row below
-						uint8_t *gridRow1 = grid + y * colourGridWidth;
-						v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
-
-						uint8_t *gridRow0 = y ? gridRow1 - colourGridWidth : blankColourRow;
-						v128_t aboveCellsVec = y ? wasm_v128_load(gridRow0 + leftX) : zeroVec;
-
-						uint8_t *gridRow2 = gridRow1 + colourGridWidth;
-						v128_t belowCellsVec = wasm_v128_load(gridRow2 + leftX);
+						// process each row of the tile
+						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
+						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
 
-						// combine the three rows with shifts since we can fit 3 x 1 bits in the 8 bit lane
-						v128_t combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 1));
-						combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 2));
+						while (y < topY) {
+							uint8_t *gridRow0 = blankColourRow;
+							uint8_t *gridRow2 = blankColourRow;
 
-						// get pointer to destintation row
-						uint8_t *nextRow = nextGrid + y * colourGridWidth;
+							// deal with bottom row of the grid
+							if (y > 0) {
+								gridRow0 = gridRow1 - colourGridWidth;
+							}
+							// deal with top row of the grid
+							if (y < height - 1) {
+								gridRow2 = gridRow1 + colourGridWidth;
+							}
 
-						// process each row of the tile
-						while (y < topY) {
 							// process each column in the row
-							uint32_t index;
+							uint32_t x = leftX;
 
-							// process each cell along the tile row
-							uint8_t ne = wasm_u8x16_extract_lane(combinedVec, 1);
-							uint8_t n = wasm_u8x16_extract_lane(combinedVec, 0);
+							// get original 16 cells
+							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							if (leftX == 0) {
-								// handle left edge of grid
-								index = (n << 3) | (ne << 6);
+							// get initial neighbours
+							if (x == 0) {
+								n = 0;
+								c = 0;
+								s = 0;
 							} else {
-								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 1) | (gridRow2[leftX - 1] << 2) | (n << 3) | (ne << 6);
+								n = *(gridRow0 + x - 1);
+								c = *(gridRow1 + x - 1);
+								s = *(gridRow2 + x - 1);
 							}
-							const uint8_t state0 = lookup[index];
+							ne = *(gridRow0 + x);
+							e = *(gridRow1 + x);
+							se = *(gridRow2 + x);
 
-							// process middle lanes
-							ne = wasm_u8x16_extract_lane(combinedVec, 2);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state1 = lookup[index];
+							while (x < rightX - 1) {
+								// shift neighbourhood left
+								nw = n;
+								n = ne;
+								ne = *(gridRow0 + x + 1);
+								w = c;
+								c = e;
+								e = *(gridRow1 + x + 1);
+								sw = s;
+								s = se;
+								se = *(gridRow2 + x + 1);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 3);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state2 = lookup[index];
+								// check for higher states
+								uint8_t state = ruleTreeMooreCached(a, b, base, cache, cacheMask, zeroState, nw, n, ne, w, c, e, sw, s, se);
+								*(nextRow + x) = state;
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 4);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state3 = lookup[index];
+								// next column
+								x++;
+							}
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 5);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state4 = lookup[index];
+							// handle right edge
+							nw = n;
+							n = ne;
+							w = c;
+							c = e;
+							sw = s;
+							s = se;
+							if (x == width - 1) {
+								ne = 0;
+								e = 0;
+								se = 0;
+							} else {
+								ne = *(gridRow0 + x + 1);
+								e = *(gridRow1 + x + 1);
+								se = *(gridRow2 + x + 1);
+							}
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 6);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state5 = lookup[index];
+							// get the next state
+							uint8_t state = ruleTreeMooreCached(a, b, base, cache, cacheMask, zeroState, nw, n, ne, w, c, e, sw, s, se);
+							*(nextRow + x) = state;
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 7);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state6 = lookup[index];
+							// load new row
+							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 8);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state7 = lookup[index];
+							// get original alive cells
+							v128_t origAliveVec = wasm_u8x16_gt(origCellsVec, zeroVec);
+							uint32_t origAlive = wasm_i8x16_bitmask(origAliveVec);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 9);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state8 = lookup[index];
+							// get new alive cells
+							v128_t newAliveVec = wasm_u8x16_gt(newCellsVec, zeroVec);
+							uint32_t newAlive = wasm_i8x16_bitmask(newAliveVec);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 10);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state9 = lookup[index];
+							// update births and deaths
+							births += __builtin_popcount(newAlive & ~origAlive);
+							deaths += __builtin_popcount(origAlive & ~newAlive);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 11);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state10 = lookup[index];
+							// get new alive cells in correct order
+							newAliveVec = wasm_i8x16_swizzle(newAliveVec, reverseVec);
+							newAlive = wasm_i8x16_bitmask(newAliveVec);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 12);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state11 = lookup[index];
+							// update population
+							population += __builtin_popcount(newAlive);
 
-							ne = wasm_u8x16_extract_lane(combinedVec, 13);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state12 = lookup[index];
-
-							ne = wasm_u8x16_extract_lane(combinedVec, 14);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state13 = lookup[index];
-
-							ne = wasm_u8x16_extract_lane(combinedVec, 15);
-							index = (index >> 3) | (ne << 6);
-							const uint8_t state14 = lookup[index];
-
-							// handle right edge
-							uint8_t e, se;
-							if (leftX + 15 == width - 1) {
-								ne = 0;
-								e = 0;
-								se = 0;
-							} else {
-								ne = *(gridRow0 + leftX + 16);
-								e = *(gridRow1 + leftX + 16);
-								se = *(gridRow2 + leftX + 16);
-							}
-							index = (index >> 3) | (ne << 6) | (e << 7) | (se << 8);
-							const uint8_t state15 = lookup[index];
-
-							// write the new cells
-							v128_t writeVec = wasm_u8x16_make(state0, state1, state2, state3, state4, state5, state6, state7,
-								state8, state9, state10, state11, state12, state13, state14, state15);
-							wasm_v128_store(nextRow + leftX, writeVec);
-
-							// load new row
-							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
-
-							// get original alive cells
-							v128_t origAliveVec = wasm_u8x16_gt(origCellsVec, zeroVec);
-							uint32_t origAlive = wasm_i8x16_bitmask(origAliveVec);
-
-							// get new alive cells
-							v128_t newAliveVec = wasm_u8x16_gt(newCellsVec, zeroVec);
-							uint32_t newAlive = wasm_i8x16_bitmask(newAliveVec);
-
-							// update births and deaths
-							births += __builtin_popcount(newAlive & ~origAlive);
-							deaths += __builtin_popcount(origAlive & ~newAlive);
-
-							// get new alive cells in correct order
-							newAliveVec = wasm_i8x16_swizzle(newAliveVec, reverseVec);
-							newAlive = wasm_i8x16_bitmask(newAliveVec);
-
-							// update population
-							population += __builtin_popcount(newAlive);
-
-							// check if any cell was alive in the source
-							anyAlive |= origAlive;
+							// check if any cell was alive in the source
+							anyAlive |= origAlive;
 
 							if (newAlive) {
 								colOccupied |= newAlive;
@@ -5417,21 +5942,7 @@ void nextGenerationRuleLoaderMooreLookup1(
 							// next row
 							y++;
 							rowIndex >>= 1;
-
-							// move the three source rows up
-							aboveCellsVec = origCellsVec;
-							origCellsVec = belowCellsVec;
-							gridRow0 = gridRow1;
 							gridRow1 += colourGridWidth;
-
-							// handle bottom of grid
-							gridRow2 = (y < height - 1) ? gridRow1 + colourGridWidth : blankColourRow;
-							belowCellsVec = (y < height - 1) ? wasm_v128_load(gridRow2 + leftX) : zeroVec;
-
-							combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 1));
-							combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 2));
-
-							// next destination row
 							nextRow += colourGridWidth;
 						}
 
@@ -5567,6 +6078,7 @@ void nextGenerationRuleLoaderMooreLookup1(
 
 					// next tile columns
 					leftX += xSize;
+					rightX += xSize;
 				}
 
 				// save the tile groups
@@ -5580,6 +6092,7 @@ void nextGenerationRuleLoaderMooreLookup1(
 			} else {
 				// skip tile set
 				leftX += xSize << 4;
+				rightX += xSize << 4;
 			}
 
 			// update tiles where all cells died
@@ -5613,8 +6126,8 @@ void nextGenerationRuleLoaderMooreLookup1(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Moore neighbourhood using 2 bit lookup
-void nextGenerationRuleLoaderMooreLookup2(
+// compute RuleLoader rule next generation for Moore neighbourhood using 1 bit lookup
+void nextGenerationRuleLoaderMooreLookup1(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -5753,9 +6266,9 @@ void nextGenerationRuleLoaderMooreLookup2(
 						uint8_t *gridRow2 = gridRow1 + colourGridWidth;
 						v128_t belowCellsVec = wasm_v128_load(gridRow2 + leftX);
 
-						// combine the three rows with shifts since we can fit 3 x 2 bits in the 8 bit lane
-						v128_t combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 2));
-						combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 4));
+						// combine the three rows with shifts since we can fit 3 x 1 bits in the 8 bit lane
+						v128_t combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 1));
+						combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 2));
 
 						// get pointer to destintation row
 						uint8_t *nextRow = nextGrid + y * colourGridWidth;
@@ -5771,67 +6284,67 @@ void nextGenerationRuleLoaderMooreLookup2(
 
 							if (leftX == 0) {
 								// handle left edge of grid
-								index = (n << 6) | (ne << 12);
+								index = (n << 3) | (ne << 6);
 							} else {
-								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 2) | (gridRow2[leftX - 1] << 4) | (n << 6) | (ne << 12);
+								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 1) | (gridRow2[leftX - 1] << 2) | (n << 3) | (ne << 6);
 							}
 							const uint8_t state0 = lookup[index];
 
 							// process middle lanes
 							ne = wasm_u8x16_extract_lane(combinedVec, 2);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state1 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 3);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state2 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 4);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state3 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 5);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state4 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 6);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state5 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 7);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state6 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 8);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state7 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 9);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state8 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 10);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state9 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 11);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state10 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 12);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state11 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 13);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state12 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 14);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state13 = lookup[index];
 
 							ne = wasm_u8x16_extract_lane(combinedVec, 15);
-							index = (index >> 6) | (ne << 12);
+							index = (index >> 3) | (ne << 6);
 							const uint8_t state14 = lookup[index];
 
 							// handle right edge
@@ -5845,7 +6358,7 @@ void nextGenerationRuleLoaderMooreLookup2(
 								e = *(gridRow1 + leftX + 16);
 								se = *(gridRow2 + leftX + 16);
 							}
-							index = (index >> 6) | (ne << 12) | (e << 14) | (se << 16);
+							index = (index >> 3) | (ne << 6) | (e << 7) | (se << 8);
 							const uint8_t state15 = lookup[index];
 
 							// write the new cells
@@ -5897,8 +6410,8 @@ void nextGenerationRuleLoaderMooreLookup2(
 							gridRow2 = (y < height - 1) ? gridRow1 + colourGridWidth : blankColourRow;
 							belowCellsVec = (y < height - 1) ? wasm_v128_load(gridRow2 + leftX) : zeroVec;
 
-							combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 2));
-							combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 4));
+							combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 1));
+							combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 2));
 
 							// next destination row
 							nextRow += colourGridWidth;
@@ -6082,8 +6595,8 @@ void nextGenerationRuleLoaderMooreLookup2(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Moore neighbourhood using 3 bit lookup
-void nextGenerationRuleLoaderMooreLookup3(
+// compute RuleLoader rule next generation for Moore neighbourhood using 2 bit lookup
+void nextGenerationRuleLoaderMooreLookup2(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -6222,8 +6735,9 @@ void nextGenerationRuleLoaderMooreLookup3(
 						uint8_t *gridRow2 = gridRow1 + colourGridWidth;
 						v128_t belowCellsVec = wasm_v128_load(gridRow2 + leftX);
 
-						// combine the middle and bottom row with a shift since we can fit 2 x 3 bits in the 8 bit lane
-						v128_t botTwoVec = wasm_v128_or(origCellsVec, wasm_i8x16_shl(belowCellsVec, 3));
+						// combine the three rows with shifts since we can fit 3 x 2 bits in the 8 bit lane
+						v128_t combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 2));
+						combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 4));
 
 						// get pointer to destintation row
 						uint8_t *nextRow = nextGrid + y * colourGridWidth;
@@ -6234,92 +6748,76 @@ void nextGenerationRuleLoaderMooreLookup3(
 							uint32_t index;
 
 							// process each cell along the tile row
-							uint8_t ne = wasm_u8x16_extract_lane(aboveCellsVec, 1);
-							uint8_t e = wasm_u8x16_extract_lane(botTwoVec, 1);
-							uint8_t n = wasm_u8x16_extract_lane(aboveCellsVec, 0);
-							uint8_t c = wasm_u8x16_extract_lane(botTwoVec, 0);
+							uint8_t ne = wasm_u8x16_extract_lane(combinedVec, 1);
+							uint8_t n = wasm_u8x16_extract_lane(combinedVec, 0);
 
 							if (leftX == 0) {
 								// handle left edge of grid
-								index = (n << 9) | (c << 12) | (ne << 18) | (e << 21);
+								index = (n << 6) | (ne << 12);
 							} else {
-								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 3) | (gridRow2[leftX - 1] << 6) | (n << 9) | (c << 12) | (ne << 18) | (e << 21);
+								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 2) | (gridRow2[leftX - 1] << 4) | (n << 6) | (ne << 12);
 							}
 							const uint8_t state0 = lookup[index];
 
 							// process middle lanes
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 2);
-							e = wasm_u8x16_extract_lane(botTwoVec, 2);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 2);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state1 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 3);
-							e = wasm_u8x16_extract_lane(botTwoVec, 3);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 3);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state2 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 4);
-							e = wasm_u8x16_extract_lane(botTwoVec, 4);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 4);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state3 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 5);
-							e = wasm_u8x16_extract_lane(botTwoVec, 5);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 5);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state4 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 6);
-							e = wasm_u8x16_extract_lane(botTwoVec, 6);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 6);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state5 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 7);
-							e = wasm_u8x16_extract_lane(botTwoVec, 7);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 7);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state6 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 8);
-							e = wasm_u8x16_extract_lane(botTwoVec, 8);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 8);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state7 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 9);
-							e = wasm_u8x16_extract_lane(botTwoVec, 9);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 9);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state8 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 10);
-							e = wasm_u8x16_extract_lane(botTwoVec, 10);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 10);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state9 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 11);
-							e = wasm_u8x16_extract_lane(botTwoVec, 11);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 11);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state10 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 12);
-							e = wasm_u8x16_extract_lane(botTwoVec, 12);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 12);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state11 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 13);
-							e = wasm_u8x16_extract_lane(botTwoVec, 13);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 13);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state12 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 14);
-							e = wasm_u8x16_extract_lane(botTwoVec, 14);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 14);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state13 = lookup[index];
 
-							ne = wasm_u8x16_extract_lane(aboveCellsVec, 15);
-							e = wasm_u8x16_extract_lane(botTwoVec, 15);
-							index = (index >> 9) | (ne << 18) | (e << 21);
+							ne = wasm_u8x16_extract_lane(combinedVec, 15);
+							index = (index >> 6) | (ne << 12);
 							const uint8_t state14 = lookup[index];
 
 							// handle right edge
-							uint8_t se;
+							uint8_t e, se;
 							if (leftX + 15 == width - 1) {
 								ne = 0;
 								e = 0;
@@ -6329,7 +6827,7 @@ void nextGenerationRuleLoaderMooreLookup3(
 								e = *(gridRow1 + leftX + 16);
 								se = *(gridRow2 + leftX + 16);
 							}
-							index = (index >> 9) | (ne << 18) | (e << 21) | (se << 24);
+							index = (index >> 6) | (ne << 12) | (e << 14) | (se << 16);
 							const uint8_t state15 = lookup[index];
 
 							// write the new cells
@@ -6381,7 +6879,8 @@ void nextGenerationRuleLoaderMooreLookup3(
 							gridRow2 = (y < height - 1) ? gridRow1 + colourGridWidth : blankColourRow;
 							belowCellsVec = (y < height - 1) ? wasm_v128_load(gridRow2 + leftX) : zeroVec;
 
-							botTwoVec = wasm_v128_or(origCellsVec, wasm_i8x16_shl(belowCellsVec, 3));
+							combinedVec = wasm_v128_or(aboveCellsVec, wasm_i8x16_shl(origCellsVec, 2));
+							combinedVec = wasm_v128_or(combinedVec, wasm_i8x16_shl(belowCellsVec, 4));
 
 							// next destination row
 							nextRow += colourGridWidth;
@@ -6565,8 +7064,8 @@ void nextGenerationRuleLoaderMooreLookup3(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Moore neighbourhood using 4 bit lookup
-void nextGenerationRuleTreeMoorePartial4(
+// compute RuleLoader rule next generation for Moore neighbourhood using 3 bit lookup
+void nextGenerationRuleLoaderMooreLookup3(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -6580,9 +7079,7 @@ void nextGenerationRuleTreeMoorePartial4(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint32_t *const a,
-	uint8_t *const b,
-	uint32_t *const lookup,
+	uint8_t *const lookup,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -6602,8 +7099,6 @@ void nextGenerationRuleTreeMoorePartial4(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t nw, n, ne, w, c, e, sw, s, se;
-
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
 
@@ -6648,7 +7143,6 @@ void nextGenerationRuleTreeMoorePartial4(
 	for (uint32_t th = 0; th < tileRows; th++) {
 		// set initial tile column
 		uint32_t leftX = 0;
-		uint32_t rightX = leftX + xSize;
 
 		// get the colour tile rows
 		uint16_t *tileRow = tileGrid + th * tileGridWidth;
@@ -6700,87 +7194,130 @@ void nextGenerationRuleTreeMoorePartial4(
 						uint32_t y = bottomY;
 						uint32_t rowIndex = 32768;
 
-						// process each row of the tile
-						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
-						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
+						// get pointers to the current source row, the row above and row below
+						uint8_t *gridRow1 = grid + y * colourGridWidth;
+						v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-						while (y < topY) {
-							uint8_t *gridRow0 = blankColourRow;
-							uint8_t *gridRow2 = blankColourRow;
+						uint8_t *gridRow0 = y ? gridRow1 - colourGridWidth : blankColourRow;
+						v128_t aboveCellsVec = y ? wasm_v128_load(gridRow0 + leftX) : zeroVec;
 
-							// deal with bottom row of the grid
-							if (y > 0) {
-								gridRow0 = gridRow1 - colourGridWidth;
-							}
-							// deal with top row of the grid
-							if (y < height - 1) {
-								gridRow2 = gridRow1 + colourGridWidth;
-							}
+						uint8_t *gridRow2 = gridRow1 + colourGridWidth;
+						v128_t belowCellsVec = wasm_v128_load(gridRow2 + leftX);
+
+						// combine the middle and bottom row with a shift since we can fit 2 x 3 bits in the 8 bit lane
+						v128_t botTwoVec = wasm_v128_or(origCellsVec, wasm_i8x16_shl(belowCellsVec, 3));
 
+						// get pointer to destintation row
+						uint8_t *nextRow = nextGrid + y * colourGridWidth;
+
+						// process each row of the tile
+						while (y < topY) {
 							// process each column in the row
-							uint32_t x = leftX;
 							uint32_t index;
 
-							// get original 16 cells
-							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
-
 							// process each cell along the tile row
-							if (x == 0) {
-								// handle left edge of grid
-								n = 0;
-								c = 0;
-								s = 0;
+							uint8_t ne = wasm_u8x16_extract_lane(aboveCellsVec, 1);
+							uint8_t e = wasm_u8x16_extract_lane(botTwoVec, 1);
+							uint8_t n = wasm_u8x16_extract_lane(aboveCellsVec, 0);
+							uint8_t c = wasm_u8x16_extract_lane(botTwoVec, 0);
+
+							if (leftX == 0) {
+								// handle left edge of grid
+								index = (n << 9) | (c << 12) | (ne << 18) | (e << 21);
 							} else {
-								n = *(gridRow0 + x - 1);
-								c = *(gridRow1 + x - 1);
-								s = *(gridRow2 + x - 1);
+								index = gridRow0[leftX - 1] | (gridRow1[leftX - 1] << 3) | (gridRow2[leftX - 1] << 6) | (n << 9) | (c << 12) | (ne << 18) | (e << 21);
 							}
-							ne = *(gridRow0 + x);
-							e = *(gridRow1 + x);
-							se = *(gridRow2 + x);
+							const uint8_t state0 = lookup[index];
 
-							// handle middle cells
-							while (x < rightX - 1) {
-								// shift neighbourhood left
-								nw = n;
-								n = ne;
-								ne = *(gridRow0 + x + 1);
-								w = c;
-								c = e;
-								e = *(gridRow1 + x + 1);
-								sw = s;
-								s = se;
-								se = *(gridRow2 + x + 1);
+							// process middle lanes
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 2);
+							e = wasm_u8x16_extract_lane(botTwoVec, 2);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state1 = lookup[index];
 
-								index = w | (n << 4) | (se << 8) | (sw << 12) | (ne << 16) | (nw << 20);
-								uint8_t state = b[a[a[lookup[index] + e] + s] + c];
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 3);
+							e = wasm_u8x16_extract_lane(botTwoVec, 3);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state2 = lookup[index];
 
-								*(nextRow + x) = state;
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 4);
+							e = wasm_u8x16_extract_lane(botTwoVec, 4);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state3 = lookup[index];
 
-								// next column
-								x++;
-							}
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 5);
+							e = wasm_u8x16_extract_lane(botTwoVec, 5);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state4 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 6);
+							e = wasm_u8x16_extract_lane(botTwoVec, 6);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state5 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 7);
+							e = wasm_u8x16_extract_lane(botTwoVec, 7);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state6 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 8);
+							e = wasm_u8x16_extract_lane(botTwoVec, 8);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state7 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 9);
+							e = wasm_u8x16_extract_lane(botTwoVec, 9);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state8 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 10);
+							e = wasm_u8x16_extract_lane(botTwoVec, 10);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state9 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 11);
+							e = wasm_u8x16_extract_lane(botTwoVec, 11);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state10 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 12);
+							e = wasm_u8x16_extract_lane(botTwoVec, 12);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state11 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 13);
+							e = wasm_u8x16_extract_lane(botTwoVec, 13);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state12 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 14);
+							e = wasm_u8x16_extract_lane(botTwoVec, 14);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state13 = lookup[index];
+
+							ne = wasm_u8x16_extract_lane(aboveCellsVec, 15);
+							e = wasm_u8x16_extract_lane(botTwoVec, 15);
+							index = (index >> 9) | (ne << 18) | (e << 21);
+							const uint8_t state14 = lookup[index];
 
 							// handle right edge
-							nw = n;
-							n = ne;
-							w = c;
-							c = e;
-							sw = s;
-							s = se;
-							if (x == width - 1) {
+							uint8_t se;
+							if (leftX + 15 == width - 1) {
 								ne = 0;
 								e = 0;
 								se = 0;
 							} else {
-								ne = *(gridRow0 + x + 1);
-								e = *(gridRow1 + x + 1);
-								se = *(gridRow2 + x + 1);
+								ne = *(gridRow0 + leftX + 16);
+								e = *(gridRow1 + leftX + 16);
+								se = *(gridRow2 + leftX + 16);
 							}
+							index = (index >> 9) | (ne << 18) | (e << 21) | (se << 24);
+							const uint8_t state15 = lookup[index];
 
-							index = w | (n << 4) | (se << 8) | (sw << 12) | (ne << 16) | (nw << 20);
-							uint8_t state = b[a[a[lookup[index] + e] + s] + c];
-							*(nextRow + x) = state;
+							// write the new cells
+							v128_t writeVec = wasm_u8x16_make(state0, state1, state2, state3, state4, state5, state6, state7,
+								state8, state9, state10, state11, state12, state13, state14, state15);
+							wasm_v128_store(nextRow + leftX, writeVec);
 
 							// load new row
 							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
@@ -6815,7 +7352,20 @@ void nextGenerationRuleTreeMoorePartial4(
 							// next row
 							y++;
 							rowIndex >>= 1;
+
+							// move the three source rows up
+							aboveCellsVec = origCellsVec;
+							origCellsVec = belowCellsVec;
+							gridRow0 = gridRow1;
 							gridRow1 += colourGridWidth;
+
+							// handle bottom of grid
+							gridRow2 = (y < height - 1) ? gridRow1 + colourGridWidth : blankColourRow;
+							belowCellsVec = (y < height - 1) ? wasm_v128_load(gridRow2 + leftX) : zeroVec;
+
+							botTwoVec = wasm_v128_or(origCellsVec, wasm_i8x16_shl(belowCellsVec, 3));
+
+							// next destination row
 							nextRow += colourGridWidth;
 						}
 
@@ -6951,7 +7501,6 @@ void nextGenerationRuleTreeMoorePartial4(
 
 					// next tile columns
 					leftX += xSize;
-					rightX += xSize;
 				}
 
 				// save the tile groups
@@ -6965,7 +7514,6 @@ void nextGenerationRuleTreeMoorePartial4(
 			} else {
 				// skip tile set
 				leftX += xSize << 4;
-				rightX += xSize << 4;
 			}
 
 			// update tiles where all cells died
@@ -6999,8 +7547,8 @@ void nextGenerationRuleTreeMoorePartial4(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleTree rule next generation for von Neumann neighbourhood
-void nextGenerationRuleTreeVN(
+// compute RuleLoader rule next generation for Moore neighbourhood using 4 bit lookup
+void nextGenerationRuleTreeMoorePartial4(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -7016,7 +7564,7 @@ void nextGenerationRuleTreeVN(
 	const uint32_t rowOccupiedWidth,
 	uint32_t *const a,
 	uint8_t *const b,
-	const uint32_t base,
+	uint32_t *const lookup,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -7036,7 +7584,7 @@ void nextGenerationRuleTreeVN(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t n, e, s, w, c;
+	uint32_t nw, n, ne, w, c, e, sw, s, se;
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -7051,7 +7599,7 @@ void nextGenerationRuleTreeVN(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// grid
+	// switch buffers each generation
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -7153,28 +7701,42 @@ void nextGenerationRuleTreeVN(
 
 							// process each column in the row
 							uint32_t x = leftX;
+							uint32_t index;
 
 							// get original 16 cells
 							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							// get initial neighbours
+							// process each cell along the tile row
 							if (x == 0) {
+								// handle left edge of grid
+								n = 0;
 								c = 0;
+								s = 0;
 							} else {
+								n = *(gridRow0 + x - 1);
 								c = *(gridRow1 + x - 1);
+								s = *(gridRow2 + x - 1);
 							}
+							ne = *(gridRow0 + x);
 							e = *(gridRow1 + x);
+							se = *(gridRow2 + x);
 
+							// handle middle cells
 							while (x < rightX - 1) {
 								// shift neighbourhood left
+								nw = n;
+								n = ne;
+								ne = *(gridRow0 + x + 1);
 								w = c;
 								c = e;
-								n = *(gridRow0 + x);
 								e = *(gridRow1 + x + 1);
-								s = *(gridRow2 + x);
+								sw = s;
+								s = se;
+								se = *(gridRow2 + x + 1);
+
+								index = w | (n << 4) | (se << 8) | (sw << 12) | (ne << 16) | (nw << 20);
+								uint8_t state = b[a[a[lookup[index] + e] + s] + c];
 
-								// lookup state
-								uint8_t state = b[a[a[a[a[base + n] + w] + e] + s] + c];
 								*(nextRow + x) = state;
 
 								// next column
@@ -7182,18 +7744,24 @@ void nextGenerationRuleTreeVN(
 							}
 
 							// handle right edge
+							nw = n;
+							n = ne;
 							w = c;
 							c = e;
-							n = *(gridRow0 + x);
+							sw = s;
+							s = se;
 							if (x == width - 1) {
+								ne = 0;
 								e = 0;
+								se = 0;
 							} else {
+								ne = *(gridRow0 + x + 1);
 								e = *(gridRow1 + x + 1);
+								se = *(gridRow2 + x + 1);
 							}
-							s = *(gridRow2 + x);
 
-							// get the next state
-							uint8_t state = b[a[a[a[a[base + n] + w] + e] + s] + c];
+							index = w | (n << 4) | (se << 8) | (sw << 12) | (ne << 16) | (nw << 20);
+							uint8_t state = b[a[a[lookup[index] + e] + s] + c];
 							*(nextRow + x) = state;
 
 							// load new row
@@ -7413,8 +7981,8 @@ void nextGenerationRuleTreeVN(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for von Neumann neighbourhood using 1 bit lookup
-void nextGenerationRuleLoaderVNLookup1(
+// compute RuleTree rule next generation for von Neumann neighbourhood
+void nextGenerationRuleTreeVN(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -7428,7 +7996,9 @@ void nextGenerationRuleLoaderVNLookup1(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint8_t *const lookup,
+	uint32_t *const a,
+	uint8_t *const b,
+	const uint32_t base,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -7448,7 +8018,7 @@ void nextGenerationRuleLoaderVNLookup1(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t e, n, s;
+	uint32_t n, e, s, w, c;
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -7463,7 +8033,7 @@ void nextGenerationRuleLoaderVNLookup1(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// switch buffers each generation
+	// grid
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -7565,34 +8135,28 @@ void nextGenerationRuleLoaderVNLookup1(
 
 							// process each column in the row
 							uint32_t x = leftX;
-							uint32_t index;
 
 							// get original 16 cells
 							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							// process each cell along the tile row
-							e = gridRow1[x + 1];
+							// get initial neighbours
 							if (x == 0) {
-								// handle left edge of grid
-								index = (gridRow1[x] << 3) | (e << 2) | (gridRow0[x] << 1) | gridRow2[x];
+								c = 0;
 							} else {
-								index = (gridRow1[x - 1] << 4) | (gridRow1[x] << 3) | (e << 2) | (gridRow0[x] << 1) | gridRow2[x];
+								c = *(gridRow1 + x - 1);
 							}
-							uint8_t state = lookup[index];
-							*(nextRow + x) = state;
-
-							// next column
-							x++;
+							e = *(gridRow1 + x);
 
-							// handle middle cells
 							while (x < rightX - 1) {
 								// shift neighbourhood left
-								n = gridRow0[x];
-								e = gridRow1[x + 1];
-								s = gridRow2[x];
-								index = ((index << 1) & 24) | (e << 2) | (n << 1) | s;
+								w = c;
+								c = e;
+								n = *(gridRow0 + x);
+								e = *(gridRow1 + x + 1);
+								s = *(gridRow2 + x);
 
-								state = lookup[index];
+								// lookup state
+								uint8_t state = b[a[a[a[a[base + n] + w] + e] + s] + c];
 								*(nextRow + x) = state;
 
 								// next column
@@ -7600,16 +8164,18 @@ void nextGenerationRuleLoaderVNLookup1(
 							}
 
 							// handle right edge
-							n = gridRow0[x];
+							w = c;
+							c = e;
+							n = *(gridRow0 + x);
 							if (x == width - 1) {
 								e = 0;
 							} else {
 								e = *(gridRow1 + x + 1);
 							}
-							s = gridRow2[x];
-							index = ((index << 1) & 24) | (e << 2) | (n << 1) | s;
+							s = *(gridRow2 + x);
 
-							state = lookup[index];
+							// get the next state
+							uint8_t state = b[a[a[a[a[base + n] + w] + e] + s] + c];
 							*(nextRow + x) = state;
 
 							// load new row
@@ -7829,8 +8395,8 @@ void nextGenerationRuleLoaderVNLookup1(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for von Neumann neighbourhood using 2 bit lookup
-void nextGenerationRuleLoaderVNLookup2(
+// compute RuleLoader rule next generation for von Neumann neighbourhood using 1 bit lookup
+void nextGenerationRuleLoaderVNLookup1(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -7990,9 +8556,9 @@ void nextGenerationRuleLoaderVNLookup2(
 							e = gridRow1[x + 1];
 							if (x == 0) {
 								// handle left edge of grid
-								index = (gridRow1[x] << 6) | (e << 4) | (gridRow0[x] << 2) | gridRow2[x];
+								index = (gridRow1[x] << 3) | (e << 2) | (gridRow0[x] << 1) | gridRow2[x];
 							} else {
-								index = (gridRow1[x - 1] << 8) | (gridRow1[x] << 6) | (e << 4) | (gridRow0[x] << 2) | gridRow2[x];
+								index = (gridRow1[x - 1] << 4) | (gridRow1[x] << 3) | (e << 2) | (gridRow0[x] << 1) | gridRow2[x];
 							}
 							uint8_t state = lookup[index];
 							*(nextRow + x) = state;
@@ -8006,7 +8572,7 @@ void nextGenerationRuleLoaderVNLookup2(
 								n = gridRow0[x];
 								e = gridRow1[x + 1];
 								s = gridRow2[x];
-								index = ((index << 2) & 960) | (e << 4) | (n << 2) | s;
+								index = ((index << 1) & 24) | (e << 2) | (n << 1) | s;
 
 								state = lookup[index];
 								*(nextRow + x) = state;
@@ -8023,7 +8589,7 @@ void nextGenerationRuleLoaderVNLookup2(
 								e = *(gridRow1 + x + 1);
 							}
 							s = gridRow2[x];
-							index = ((index << 2) & 960) | (e << 4) | (n << 2) | s;
+							index = ((index << 1) & 24) | (e << 2) | (n << 1) | s;
 
 							state = lookup[index];
 							*(nextRow + x) = state;
@@ -8245,8 +8811,8 @@ void nextGenerationRuleLoaderVNLookup2(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for von Neumann neighbourhood using 3 bit lookup
-void nextGenerationRuleLoaderVNLookup3(
+// compute RuleLoader rule next generation for von Neumann neighbourhood using 2 bit lookup
+void nextGenerationRuleLoaderVNLookup2(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -8406,9 +8972,9 @@ void nextGenerationRuleLoaderVNLookup3(
 							e = gridRow1[x + 1];
 							if (x == 0) {
 								// handle left edge of grid
-								index = (gridRow1[x] << 9) | (e << 6) | (gridRow0[x] << 3) | gridRow2[x];
+								index = (gridRow1[x] << 6) | (e << 4) | (gridRow0[x] << 2) | gridRow2[x];
 							} else {
-								index = (gridRow1[x - 1] << 12) | (gridRow1[x] << 9) | (e << 6) | (gridRow0[x] << 3) | gridRow2[x];
+								index = (gridRow1[x - 1] << 8) | (gridRow1[x] << 6) | (e << 4) | (gridRow0[x] << 2) | gridRow2[x];
 							}
 							uint8_t state = lookup[index];
 							*(nextRow + x) = state;
@@ -8422,7 +8988,7 @@ void nextGenerationRuleLoaderVNLookup3(
 								n = gridRow0[x];
 								e = gridRow1[x + 1];
 								s = gridRow2[x];
-								index = ((index << 3) & 32256) | (e << 6) | (n << 3) | s;
+								index = ((index << 2) & 960) | (e << 4) | (n << 2) | s;
 
 								state = lookup[index];
 								*(nextRow + x) = state;
@@ -8439,7 +9005,7 @@ void nextGenerationRuleLoaderVNLookup3(
 								e = *(gridRow1 + x + 1);
 							}
 							s = gridRow2[x];
-							index = ((index << 3) & 32256) | (e << 6) | (n << 3) | s;
+							index = ((index << 2) & 960) | (e << 4) | (n << 2) | s;
 
 							state = lookup[index];
 							*(nextRow + x) = state;
@@ -8661,8 +9227,8 @@ void nextGenerationRuleLoaderVNLookup3(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for von Neumann neighbourhood using 4 bit lookup
-void nextGenerationRuleLoaderVNLookup4(
+// compute RuleLoader rule next generation for von Neumann neighbourhood using 3 bit lookup
+void nextGenerationRuleLoaderVNLookup3(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -8822,9 +9388,9 @@ void nextGenerationRuleLoaderVNLookup4(
 							e = gridRow1[x + 1];
 							if (x == 0) {
 								// handle left edge of grid
-								index = (gridRow1[x] << 12) | (e << 8) | (gridRow0[x] << 4) | gridRow2[x];
+								index = (gridRow1[x] << 9) | (e << 6) | (gridRow0[x] << 3) | gridRow2[x];
 							} else {
-								index = (gridRow1[x - 1] << 16) | (gridRow1[x] << 12) | (e << 8) | (gridRow0[x] << 4) | gridRow2[x];
+								index = (gridRow1[x - 1] << 12) | (gridRow1[x] << 9) | (e << 6) | (gridRow0[x] << 3) | gridRow2[x];
 							}
 							uint8_t state = lookup[index];
 							*(nextRow + x) = state;
@@ -8838,7 +9404,7 @@ void nextGenerationRuleLoaderVNLookup4(
 								n = gridRow0[x];
 								e = gridRow1[x + 1];
 								s = gridRow2[x];
-								index = ((index << 4) & 1044480) | (e << 8) | (n << 4) | s;
+								index = ((index << 3) & 32256) | (e << 6) | (n << 3) | s;
 
 								state = lookup[index];
 								*(nextRow + x) = state;
@@ -8855,7 +9421,7 @@ void nextGenerationRuleLoaderVNLookup4(
 								e = *(gridRow1 + x + 1);
 							}
 							s = gridRow2[x];
-							index = ((index << 4) & 1044480) | (e << 8) | (n << 4) | s;
+							index = ((index << 3) & 32256) | (e << 6) | (n << 3) | s;
 
 							state = lookup[index];
 							*(nextRow + x) = state;
@@ -9077,8 +9643,8 @@ void nextGenerationRuleLoaderVNLookup4(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for von Neumann neighbourhood using 5 bit lookup
-void nextGenerationRuleLoaderVNLookup5(
+// compute RuleLoader rule next generation for von Neumann neighbourhood using 4 bit lookup
+void nextGenerationRuleLoaderVNLookup4(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -9238,9 +9804,9 @@ void nextGenerationRuleLoaderVNLookup5(
 							e = gridRow1[x + 1];
 							if (x == 0) {
 								// handle left edge of grid
-								index = (gridRow1[x] << 15) | (e << 10) | (gridRow0[x] << 5) | gridRow2[x];
+								index = (gridRow1[x] << 12) | (e << 8) | (gridRow0[x] << 4) | gridRow2[x];
 							} else {
-								index = (gridRow1[x - 1] << 20) | (gridRow1[x] << 15) | (e << 10) | (gridRow0[x] << 5) | gridRow2[x];
+								index = (gridRow1[x - 1] << 16) | (gridRow1[x] << 12) | (e << 8) | (gridRow0[x] << 4) | gridRow2[x];
 							}
 							uint8_t state = lookup[index];
 							*(nextRow + x) = state;
@@ -9254,7 +9820,7 @@ void nextGenerationRuleLoaderVNLookup5(
 								n = gridRow0[x];
 								e = gridRow1[x + 1];
 								s = gridRow2[x];
-								index = ((index << 5) & 33521664) | (e << 10) | (n << 5) | s;
+								index = ((index << 4) & 1044480) | (e << 8) | (n << 4) | s;
 
 								state = lookup[index];
 								*(nextRow + x) = state;
@@ -9271,7 +9837,7 @@ void nextGenerationRuleLoaderVNLookup5(
 								e = *(gridRow1 + x + 1);
 							}
 							s = gridRow2[x];
-							index = ((index << 5) & 33521664) | (e << 10) | (n << 5) | s;
+							index = ((index << 4) & 1044480) | (e << 8) | (n << 4) | s;
 
 							state = lookup[index];
 							*(nextRow + x) = state;
@@ -9493,8 +10059,8 @@ void nextGenerationRuleLoaderVNLookup5(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleTable rule next generation for Moore neighbourhood
-void nextGenerationRuleTableMoore(
+// compute RuleLoader rule next generation for von Neumann neighbourhood using 5 bit lookup
+void nextGenerationRuleLoaderVNLookup5(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -9508,10 +10074,7 @@ void nextGenerationRuleTableMoore(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint32_t *const lut,
-	const uint32_t lutSize,
-	uint8_t *const output,
-	const uint32_t nCompressed,
+	uint8_t *const lookup,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -9531,21 +10094,7 @@ void nextGenerationRuleTableMoore(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t n, e, s, w, c, ne, nw, se, sw;
-
-	// compute the offsets in the LUT array
-	uint32_t nOffset = lutSize / 9;
-
-	// get the pointers to the per neighbour LUTs
-	uint32_t *const lut0 = lut;
-	uint32_t *const lut1 = lut + nOffset;
-	uint32_t *const lut2 = lut + nOffset * 2;
-	uint32_t *const lut3 = lut + nOffset * 3;
-	uint32_t *const lut4 = lut + nOffset * 4;
-	uint32_t *const lut5 = lut + nOffset * 5;
-	uint32_t *const lut6 = lut + nOffset * 6;
-	uint32_t *const lut7 = lut + nOffset * 7;
-	uint32_t *const lut8 = lut + nOffset * 8;
+	uint32_t e, n, s;
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -9560,7 +10109,7 @@ void nextGenerationRuleTableMoore(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// grid
+	// switch buffers each generation
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -9662,75 +10211,34 @@ void nextGenerationRuleTableMoore(
 
 							// process each column in the row
 							uint32_t x = leftX;
+							uint32_t index;
 
 							// get original 16 cells
 							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							// get initial neighbours
+							// process each cell along the tile row
+							e = gridRow1[x + 1];
 							if (x == 0) {
-								n = 0;
-								c = 0;
-								s = 0;
+								// handle left edge of grid
+								index = (gridRow1[x] << 15) | (e << 10) | (gridRow0[x] << 5) | gridRow2[x];
 							} else {
-								n = *(gridRow0 + x - 1);
-								c = *(gridRow1 + x - 1);
-								s = *(gridRow2 + x - 1);
+								index = (gridRow1[x - 1] << 20) | (gridRow1[x] << 15) | (e << 10) | (gridRow0[x] << 5) | gridRow2[x];
 							}
-							ne = *(gridRow0 + x);
-							e = *(gridRow1 + x);
-							se = *(gridRow2 + x);
+							uint8_t state = lookup[index];
+							*(nextRow + x) = state;
+
+							// next column
+							x++;
 
+							// handle middle cells
 							while (x < rightX - 1) {
 								// shift neighbourhood left
-								nw = n;
-								n = ne;
-								ne = *(gridRow0 + x + 1);
-								w = c;
-								c = e;
-								e = *(gridRow1 + x + 1);
-								sw = s;
-								s = se;
-								se = *(gridRow2 + x + 1);
-								uint8_t state = c;
-
-								uint32_t *lutc = lut0 + c * nCompressed;
-								uint32_t *lutn = lut1 + n * nCompressed;
-								uint32_t *lutne = lut2 + ne * nCompressed;
-								uint32_t *lute = lut3 + e * nCompressed;
-								uint32_t *lutse = lut4 + se * nCompressed;
-								uint32_t *luts = lut5 + s * nCompressed;
-								uint32_t *lutsw = lut6+ sw * nCompressed;
-								uint32_t *lutw = lut7 + w * nCompressed;
-								uint32_t *lutnw = lut8 + nw * nCompressed;
-
-								for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-									uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-									if (isMatch) {
-										isMatch &= lutne[iRuleC] & lute[iRuleC];
-										if (isMatch) {
-											isMatch &= lutse[iRuleC] & luts[iRuleC];
-											if (isMatch) {
-												isMatch &= lutsw[iRuleC] & lutw[iRuleC] & lutnw[iRuleC];
-												if (isMatch) {
-													uint32_t iBit = 0;
-													//uint32_t mask = 1;
-													//while (!(isMatch & mask)) {
-														//iBit++;
-														//mask <<= 1;
-													//}
-													uint32_t v = isMatch;
-													while ((v & 1) == 0) {
-														iBit++;
-														v >>= 1;
-													}
-													state = output[(iRuleC << 5) + iBit];
-													break;
-												}
-											}
-										}
-									}
-								}
+								n = gridRow0[x];
+								e = gridRow1[x + 1];
+								s = gridRow2[x];
+								index = ((index << 5) & 33521664) | (e << 10) | (n << 5) | s;
 
+								state = lookup[index];
 								*(nextRow + x) = state;
 
 								// next column
@@ -9738,62 +10246,16 @@ void nextGenerationRuleTableMoore(
 							}
 
 							// handle right edge
-							nw = n;
-							n = ne;
-							w = c;
-							c = e;
-							sw = s;
-							s = se;
+							n = gridRow0[x];
 							if (x == width - 1) {
-								ne = 0;
 								e = 0;
-								se = 0;
 							} else {
-								ne = *(gridRow0 + x + 1);
 								e = *(gridRow1 + x + 1);
-								se = *(gridRow2 + x + 1);
 							}
+							s = gridRow2[x];
+							index = ((index << 5) & 33521664) | (e << 10) | (n << 5) | s;
 
-							// get the next state
-							uint32_t *lutc = lut0 + c * nCompressed;
-							uint32_t *lutn = lut1 + n * nCompressed;
-							uint32_t *lutne = lut2 + ne * nCompressed;
-							uint32_t *lute = lut3 + e * nCompressed;
-							uint32_t *lutse = lut4 + se * nCompressed;
-							uint32_t *luts = lut5 + s * nCompressed;
-							uint32_t *lutsw = lut6+ sw * nCompressed;
-							uint32_t *lutw = lut7 + w * nCompressed;
-							uint32_t *lutnw = lut8 + nw * nCompressed;
-
-							uint32_t state = c;
-
-							for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-								uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-								if (isMatch) {
-									isMatch &= lutne[iRuleC] & lute[iRuleC];
-									if (isMatch) {
-										isMatch &= lutse[iRuleC] & luts[iRuleC];
-										if (isMatch) {
-											isMatch &= lutsw[iRuleC] & lutw[iRuleC] & lutnw[iRuleC];
-											if (isMatch) {
-												uint32_t iBit = 0;
-												//uint32_t mask = 1;
-												//while (!(isMatch & mask)) {
-													//iBit++;
-													//mask <<= 1;
-												//}
-												uint32_t v = isMatch;
-												while ((v & 1) == 0) {
-													iBit++;
-													v >>= 1;
-												}
-												state = output[(iRuleC << 5) + iBit];
-												break;
-											}
-										}
-									}
-								}
-							}
+							state = lookup[index];
 							*(nextRow + x) = state;
 
 							// load new row
@@ -10012,9 +10474,63 @@ void nextGenerationRuleTableMoore(
 }
 
 
+// return the output of the first RuleTable rule matched by every neighbour LUT row or the current state if none match
+// rules are checked 128 compressed rules (4 words) at a time stopping as soon as the intersection is empty
+static inline uint8_t ruleTableNextState(
+	const uint32_t *const *const luts,
+	const uint32_t numLuts,
+	const uint8_t *const output,
+	const uint32_t nCompressed,
+	const uint8_t state
+) {
+	uint32_t iRuleC = 0;
+
+	// check four rule words at a time
+	while (iRuleC + 4 <= nCompressed) {
+		v128_t isMatch = wasm_v128_and(wasm_v128_load(luts[0] + iRuleC), wasm_v128_load(luts[1] + iRuleC));
+		uint32_t i = 2;
+
+		while (i < numLuts && wasm_v128_any_true(isMatch)) {
+			isMatch = wasm_v128_and(isMatch, wasm_v128_load(luts[i] + iRuleC));
+			i++;
+		}
+
+		if (wasm_v128_any_true(isMatch)) {
+			// find the first word with a match and then the first rule in it
+			uint32_t words[4];
+			wasm_v128_store(words, isMatch);
+			uint32_t lane = __builtin_ctz(wasm_i32x4_bitmask(wasm_i32x4_ne(isMatch, wasm_i32x4_splat(0))));
+
+			return output[((iRuleC + lane) << 5) + __builtin_ctz(words[lane])];
+		}
+
+		iRuleC += 4;
+	}
+
+	// check any remaining rule words
+	while (iRuleC < nCompressed) {
+		uint32_t isMatch = luts[0][iRuleC] & luts[1][iRuleC];
+		uint32_t i = 2;
+
+		while (i < numLuts && isMatch) {
+			isMatch &= luts[i][iRuleC];
+			i++;
+		}
+
+		if (isMatch) {
+			return output[(iRuleC << 5) + __builtin_ctz(isMatch)];
+		}
+
+		iRuleC++;
+	}
+
+	return state;
+}
+
+
 EMSCRIPTEN_KEEPALIVE
-// compute RuleTable rule next generation for Hexagonal neighbourhood
-void nextGenerationRuleTableHex(
+// compute RuleTable rule next generation for Moore neighbourhood
+void nextGenerationRuleTableMoore(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -10051,10 +10567,10 @@ void nextGenerationRuleTableHex(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t n, e, s, w, c, nw, se;
+	uint32_t n, e, s, w, c, ne, nw, se, sw;
 
 	// compute the offsets in the LUT array
-	uint32_t nOffset = lutSize / 7;
+	uint32_t nOffset = lutSize / 9;
 
 	// get the pointers to the per neighbour LUTs
 	uint32_t *const lut0 = lut;
@@ -10064,6 +10580,12 @@ void nextGenerationRuleTableHex(
 	uint32_t *const lut4 = lut + nOffset * 4;
 	uint32_t *const lut5 = lut + nOffset * 5;
 	uint32_t *const lut6 = lut + nOffset * 6;
+	uint32_t *const lut7 = lut + nOffset * 7;
+	uint32_t *const lut8 = lut + nOffset * 8;
+
+	// compute the next state for an empty neighbourhood once since most cells in occupied tiles are empty
+	const uint32_t *const zeroLuts[9] = {lut0, lut1, lut2, lut3, lut4, lut5, lut6, lut7, lut8};
+	const uint8_t zeroState = ruleTableNextState(zeroLuts, 9, output, nCompressed, 0);
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -10194,46 +10716,29 @@ void nextGenerationRuleTableHex(
 								c = *(gridRow1 + x - 1);
 								s = *(gridRow2 + x - 1);
 							}
+							ne = *(gridRow0 + x);
 							e = *(gridRow1 + x);
 							se = *(gridRow2 + x);
 
 							while (x < rightX - 1) {
 								// shift neighbourhood left
 								nw = n;
-								n = *(gridRow0 + x);
+								n = ne;
+								ne = *(gridRow0 + x + 1);
 								w = c;
 								c = e;
 								e = *(gridRow1 + x + 1);
+								sw = s;
 								s = se;
 								se = *(gridRow2 + x + 1);
 								uint8_t state = c;
 
-								uint32_t *lutc = lut0 + c * nCompressed;
-								uint32_t *lutn = lut1 + n * nCompressed;
-								uint32_t *lute = lut2 + e * nCompressed;
-								uint32_t *lutse = lut3 + se * nCompressed;
-								uint32_t *luts = lut4 + s * nCompressed;
-								uint32_t *lutw = lut5 + w * nCompressed;
-								uint32_t *lutnw = lut6 + nw * nCompressed;
-
-								for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-									uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-									if (isMatch) {
-										isMatch &= lute[iRuleC] & lutse[iRuleC];
-										if (isMatch) {
-											isMatch &= luts[iRuleC] & lutw[iRuleC] & lutnw[iRuleC];
-											if (isMatch) {
-												uint32_t iBit = 0;
-												uint32_t mask = 1;
-												while (!(isMatch & mask)) {
-													iBit++;
-													mask <<= 1;
-												}
-												state = output[(iRuleC << 5) + iBit];
-												break;
-											}
-										}
-									}
+								if (c | n | ne | e | se | s | sw | w | nw) {
+									const uint32_t *const neighbourLuts[9] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + ne * nCompressed, lut3 + e * nCompressed, lut4 + se * nCompressed, lut5 + s * nCompressed, lut6 + sw * nCompressed, lut7 + w * nCompressed, lut8 + nw * nCompressed};
+									state = ruleTableNextState(neighbourLuts, 9, output, nCompressed, state);
+								} else {
+									// empty neighbourhood
+									state = zeroState;
 								}
 
 								*(nextRow + x) = state;
@@ -10244,47 +10749,31 @@ void nextGenerationRuleTableHex(
 
 							// handle right edge
 							nw = n;
-							n = gridRow0[x];
+							n = ne;
 							w = c;
 							c = e;
+							sw = s;
 							s = se;
 							if (x == width - 1) {
+								ne = 0;
 								e = 0;
 								se = 0;
 							} else {
-								e = gridRow1[x + 1];
-								se = gridRow2[x + 1];
+								ne = *(gridRow0 + x + 1);
+								e = *(gridRow1 + x + 1);
+								se = *(gridRow2 + x + 1);
 							}
 
-							uint32_t *lutc = lut0 + c * nCompressed;
-							uint32_t *lutn = lut1 + n * nCompressed;
-							uint32_t *lute = lut2 + e * nCompressed;
-							uint32_t *lutse = lut3 + se * nCompressed;
-							uint32_t *luts = lut4 + s * nCompressed;
-							uint32_t *lutw = lut5 + w * nCompressed;
-							uint32_t *lutnw = lut6 + nw * nCompressed;
-							uint8_t state = c;
+							// get the next state
+							uint32_t state = c;
 
-							for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-								uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-								if (isMatch) {
-									isMatch &= lute[iRuleC] & lutse[iRuleC];
-									if (isMatch) {
-										isMatch &= luts[iRuleC] & lutw[iRuleC] & lutnw[iRuleC];
-										if (isMatch) {
-											uint32_t iBit = 0;
-											uint32_t mask = 1;
-											while (!(isMatch & mask)) {
-												iBit++;
-												mask <<= 1;
-											}
-											state = output[(iRuleC << 5) + iBit];
-											break;
-										}
-									}
-								}
+							if (c | n | ne | e | se | s | sw | w | nw) {
+								const uint32_t *const neighbourLuts[9] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + ne * nCompressed, lut3 + e * nCompressed, lut4 + se * nCompressed, lut5 + s * nCompressed, lut6 + sw * nCompressed, lut7 + w * nCompressed, lut8 + nw * nCompressed};
+								state = ruleTableNextState(neighbourLuts, 9, output, nCompressed, state);
+							} else {
+								// empty neighbourhood
+								state = zeroState;
 							}
-
 							*(nextRow + x) = state;
 
 							// load new row
@@ -10504,8 +10993,8 @@ void nextGenerationRuleTableHex(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleTable rule next generation for von Neumann neighbourhood
-void nextGenerationRuleTableVN(
+// compute RuleTable rule next generation for Hexagonal neighbourhood
+void nextGenerationRuleTableHex(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -10542,10 +11031,10 @@ void nextGenerationRuleTableVN(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t n, e, s, w, c;
+	uint32_t n, e, s, w, c, nw, se;
 
 	// compute the offsets in the LUT array
-	uint32_t nOffset = lutSize / 5;
+	uint32_t nOffset = lutSize / 7;
 
 	// get the pointers to the per neighbour LUTs
 	uint32_t *const lut0 = lut;
@@ -10553,6 +11042,12 @@ void nextGenerationRuleTableVN(
 	uint32_t *const lut2 = lut + nOffset * 2;
 	uint32_t *const lut3 = lut + nOffset * 3;
 	uint32_t *const lut4 = lut + nOffset * 4;
+	uint32_t *const lut5 = lut + nOffset * 5;
+	uint32_t *const lut6 = lut + nOffset * 6;
+
+	// compute the next state for an empty neighbourhood once since most cells in occupied tiles are empty
+	const uint32_t *const zeroLuts[7] = {lut0, lut1, lut2, lut3, lut4, lut5, lut6};
+	const uint8_t zeroState = ruleTableNextState(zeroLuts, 7, output, nCompressed, 0);
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -10675,42 +11170,34 @@ void nextGenerationRuleTableVN(
 
 							// get initial neighbours
 							if (x == 0) {
+								n = 0;
 								c = 0;
+								s = 0;
 							} else {
+								n = *(gridRow0 + x - 1);
 								c = *(gridRow1 + x - 1);
+								s = *(gridRow2 + x - 1);
 							}
 							e = *(gridRow1 + x);
+							se = *(gridRow2 + x);
 
 							while (x < rightX - 1) {
 								// shift neighbourhood left
+								nw = n;
 								n = *(gridRow0 + x);
 								w = c;
 								c = e;
 								e = *(gridRow1 + x + 1);
-								s = *(gridRow2 + x);
+								s = se;
+								se = *(gridRow2 + x + 1);
 								uint8_t state = c;
 
-								uint32_t *lutc = lut0 + c * nCompressed;
-								uint32_t *lutn = lut1 + n * nCompressed;
-								uint32_t *lute = lut2 + e * nCompressed;
-								uint32_t *luts = lut3 + s * nCompressed;
-								uint32_t *lutw = lut4 + w * nCompressed;
-
-								for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-									uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-									if (isMatch) {
-										isMatch &= lute[iRuleC] & luts[iRuleC] & lutw[iRuleC];
-										if (isMatch) {
-											uint32_t iBit = 0;
-											uint32_t mask = 1;
-											while (!(isMatch & mask)) {
-												iBit++;
-												mask <<= 1;
-											}
-											state = output[(iRuleC << 5) + iBit];
-											break;
-										}
-									}
+								if (c | n | e | se | s | w | nw) {
+									const uint32_t *const neighbourLuts[7] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + e * nCompressed, lut3 + se * nCompressed, lut4 + s * nCompressed, lut5 + w * nCompressed, lut6 + nw * nCompressed};
+									state = ruleTableNextState(neighbourLuts, 7, output, nCompressed, state);
+								} else {
+									// empty neighbourhood
+									state = zeroState;
 								}
 
 								*(nextRow + x) = state;
@@ -10720,37 +11207,27 @@ void nextGenerationRuleTableVN(
 							}
 
 							// handle right edge
+							nw = n;
+							n = gridRow0[x];
 							w = c;
 							c = e;
-							n = gridRow0[x];
+							s = se;
 							if (x == width - 1) {
 								e = 0;
+								se = 0;
 							} else {
 								e = gridRow1[x + 1];
+								se = gridRow2[x + 1];
 							}
 
-							uint32_t *lutc = lut0 + c * nCompressed;
-							uint32_t *lutn = lut1 + n * nCompressed;
-							uint32_t *lute = lut2 + e * nCompressed;
-							uint32_t *luts = lut3 + s * nCompressed;
-							uint32_t *lutw = lut4 + w * nCompressed;
 							uint8_t state = c;
 
-							for (uint32_t iRuleC = 0; iRuleC < nCompressed; iRuleC++) {
-								uint32_t isMatch = lutc[iRuleC] & lutn[iRuleC];
-								if (isMatch) {
-									isMatch &= lute[iRuleC] & luts[iRuleC] & lutw[iRuleC];
-									if (isMatch) {
-										uint32_t iBit = 0;
-										uint32_t mask = 1;
-										while (!(isMatch & mask)) {
-											iBit++;
-											mask <<= 1;
-										}
-										state = output[(iRuleC << 5) + iBit];
-										break;
-									}
-								}
+							if (c | n | e | se | s | w | nw) {
+								const uint32_t *const neighbourLuts[7] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + e * nCompressed, lut3 + se * nCompressed, lut4 + s * nCompressed, lut5 + w * nCompressed, lut6 + nw * nCompressed};
+								state = ruleTableNextState(neighbourLuts, 7, output, nCompressed, state);
+							} else {
+								// empty neighbourhood
+								state = zeroState;
 							}
 
 							*(nextRow + x) = state;
@@ -10972,8 +11449,8 @@ void nextGenerationRuleTableVN(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Hexagonal neighbourhood using 1 bit lookup
-void nextGenerationRuleLoaderHexLookup1(
+// compute RuleTable rule next generation for von Neumann neighbourhood
+void nextGenerationRuleTableVN(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -10987,7 +11464,10 @@ void nextGenerationRuleLoaderHexLookup1(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint8_t *const lookup,
+	uint32_t *const lut,
+	const uint32_t lutSize,
+	uint8_t *const output,
+	const uint32_t nCompressed,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -11007,7 +11487,21 @@ void nextGenerationRuleLoaderHexLookup1(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t nw, n, w, c, e, s, se;
+	uint32_t n, e, s, w, c;
+
+	// compute the offsets in the LUT array
+	uint32_t nOffset = lutSize / 5;
+
+	// get the pointers to the per neighbour LUTs
+	uint32_t *const lut0 = lut;
+	uint32_t *const lut1 = lut + nOffset;
+	uint32_t *const lut2 = lut + nOffset * 2;
+	uint32_t *const lut3 = lut + nOffset * 3;
+	uint32_t *const lut4 = lut + nOffset * 4;
+
+	// compute the next state for an empty neighbourhood once since most cells in occupied tiles are empty
+	const uint32_t *const zeroLuts[5] = {lut0, lut1, lut2, lut3, lut4};
+	const uint8_t zeroState = ruleTableNextState(zeroLuts, 5, output, nCompressed, 0);
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -11022,7 +11516,7 @@ void nextGenerationRuleLoaderHexLookup1(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// switch buffers each generation
+	// grid
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -11124,43 +11618,35 @@ void nextGenerationRuleLoaderHexLookup1(
 
 							// process each column in the row
 							uint32_t x = leftX;
-							uint32_t index;
 
 							// get original 16 cells
 							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							// process each cell along the tile row
-							e = gridRow1[x + 1];
-							se = gridRow2[x + 1];
-							n = gridRow0[x];
-							c = gridRow1[x];
-							s = gridRow2[x];
+							// get initial neighbours
 							if (x == 0) {
-								// handle left edge of grid
-								index = c | (s << 1) | (e << 2) | (n << 4) | (se << 5);
+								c = 0;
 							} else {
-								index = (gridRow0[x - 1] << 6) | (gridRow1[x - 1] << 3) | c | (s << 1) | (e << 2) | (n << 4) | (se << 5);
+								c = *(gridRow1 + x - 1);
 							}
+							e = *(gridRow1 + x);
 
-							uint8_t state = lookup[index];
-							*(nextRow + x) = state;
-
-							// next column
-							x++;
-
-							// handle middle cells
 							while (x < rightX - 1) {
 								// shift neighbourhood left
-								nw = n;
 								n = *(gridRow0 + x);
 								w = c;
 								c = e;
 								e = *(gridRow1 + x + 1);
-								s = se;
-								se = *(gridRow2 + x + 1);
-								index = c | (s << 1) | (e << 2) | (w << 3) | (n << 4) | (se << 5) | (nw << 6);
+								s = *(gridRow2 + x);
+								uint8_t state = c;
+
+								if (c | n | e | s | w) {
+									const uint32_t *const neighbourLuts[5] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + e * nCompressed, lut3 + s * nCompressed, lut4 + w * nCompressed};
+									state = ruleTableNextState(neighbourLuts, 5, output, nCompressed, state);
+								} else {
+									// empty neighbourhood
+									state = zeroState;
+								}
 
-								state = lookup[index];
 								*(nextRow + x) = state;
 
 								// next column
@@ -11168,22 +11654,25 @@ void nextGenerationRuleLoaderHexLookup1(
 							}
 
 							// handle right edge
-							nw = n;
-							n = *(gridRow0 + x);
 							w = c;
 							c = e;
-							s = se;
+							n = gridRow0[x];
 							if (x == width - 1) {
 								e = 0;
-								se = 0;
 							} else {
-								e = *(gridRow1 + x + 1);
-								se = *(gridRow2 + x + 1);
+								e = gridRow1[x + 1];
 							}
 
-							index = c | (s << 1) | (e << 2) | (w << 3) | (n << 4) | (se << 5) | (nw << 6);
+							uint8_t state = c;
+
+							if (c | n | e | s | w) {
+								const uint32_t *const neighbourLuts[5] = {lut0 + c * nCompressed, lut1 + n * nCompressed, lut2 + e * nCompressed, lut3 + s * nCompressed, lut4 + w * nCompressed};
+								state = ruleTableNextState(neighbourLuts, 5, output, nCompressed, state);
+							} else {
+								// empty neighbourhood
+								state = zeroState;
+							}
 
-							state = lookup[index];
 							*(nextRow + x) = state;
 
 							// load new row
@@ -11403,8 +11892,8 @@ void nextGenerationRuleLoaderHexLookup1(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Hexagonal neighbourhood using 2 bit lookup
-void nextGenerationRuleLoaderHexLookup2(
+// compute RuleTable rule next generation for 1D neighbourhood
+void nextGenerationRuleTable1D(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -11418,7 +11907,10 @@ void nextGenerationRuleLoaderHexLookup2(
 	const uint32_t columnOccupiedWidth,
 	uint16_t *const rowOccupied16,
 	const uint32_t rowOccupiedWidth,
-	uint8_t *const lookup,
+	uint32_t *const lut,
+	const uint32_t lutSize,
+	uint8_t *const output,
+	const uint32_t nCompressed,
 	const uint32_t width,
 	const uint32_t height,
 	const uint32_t ySize,
@@ -11426,7 +11918,6 @@ void nextGenerationRuleLoaderHexLookup2(
 	const uint32_t tileCols,
 	uint16_t *const blankTileRow,
 	const uint32_t blankTileRowWidth,
-	uint8_t *const blankColourRow,
 	const uint32_t counter,
 	const uint32_t bottomRightSet,
 	const uint32_t bottomSet,
@@ -11438,7 +11929,19 @@ void nextGenerationRuleLoaderHexLookup2(
 	const uint32_t rightSet,
 	uint32_t *shared
 ) {
-	uint32_t nw, n, w, c, e, s, se;
+	uint32_t e, w, c;
+
+	// compute the offsets in the LUT array
+	uint32_t nOffset = lutSize / 3;
+
+	// get the pointers to the per neighbour LUTs (centre, west, east)
+	uint32_t *const lut0 = lut;
+	uint32_t *const lut1 = lut + nOffset;
+	uint32_t *const lut2 = lut + nOffset * 2;
+
+	// compute the next state for an empty neighbourhood once since most cells in occupied tiles are empty
+	const uint32_t *const zeroLuts[3] = {lut0, lut1, lut2};
+	const uint8_t zeroState = ruleTableNextState(zeroLuts, 3, output, nCompressed, 0);
 
 	// population statistics
 	uint32_t population = 0, births = 0, deaths = 0;
@@ -11453,7 +11956,7 @@ void nextGenerationRuleLoaderHexLookup2(
 	const v128_t zeroVec = wasm_u8x16_splat(0);
 	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
 
-	// switch buffers each generation
+	// grid
 	uint8_t *grid = nextColourGrid;
 	uint8_t *nextGrid = colourGrid;
 	uint16_t *tileGrid = nextTileGrid16;
@@ -11540,58 +12043,37 @@ void nextGenerationRuleLoaderHexLookup2(
 						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
 						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
 
+						// each row is independent so only cells on the same row are neighbours
 						while (y < topY) {
-							uint8_t *gridRow0 = blankColourRow;
-							uint8_t *gridRow2 = blankColourRow;
-
-							// deal with bottom row of the grid
-							if (y > 0) {
-								gridRow0 = gridRow1 - colourGridWidth;
-							}
-							// deal with top row of the grid
-							if (y < height - 1) {
-								gridRow2 = gridRow1 + colourGridWidth;
-							}
-
 							// process each column in the row
 							uint32_t x = leftX;
-							uint32_t index;
 
 							// get original 16 cells
 							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
 
-							// process each cell along the tile row
-							e = gridRow1[x + 1];
-							se = gridRow2[x + 1];
-							n = gridRow0[x];
-							c = gridRow1[x];
-							s = gridRow2[x];
+							// get initial neighbours
 							if (x == 0) {
-								// handle left edge of grid
-								index = c | (s << 2) | (e << 4) | (n << 8) | (se << 10);
+								c = 0;
 							} else {
-								index = (gridRow0[x - 1] << 12) | (gridRow1[x - 1] << 6) | c | (s << 2) | (e << 4) | (n << 8) | (se << 10);
+								c = *(gridRow1 + x - 1);
 							}
+							e = *(gridRow1 + x);
 
-							uint8_t state = lookup[index];
-							*(nextRow + x) = state;
-
-							// next column
-							x++;
-
-							// handle middle cells
 							while (x < rightX - 1) {
 								// shift neighbourhood left
-								nw = n;
-								n = *(gridRow0 + x);
 								w = c;
 								c = e;
 								e = *(gridRow1 + x + 1);
-								s = se;
-								se = *(gridRow2 + x + 1);
-								index = c | (s << 2) | (e << 4) | (w << 6) | (n << 8) | (se << 10) | (nw << 12);
+								uint8_t state = c;
+
+								if (c | e | w) {
+									const uint32_t *const neighbourLuts[3] = {lut0 + c * nCompressed, lut1 + w * nCompressed, lut2 + e * nCompressed};
+									state = ruleTableNextState(neighbourLuts, 3, output, nCompressed, state);
+								} else {
+									// empty neighbourhood
+									state = zeroState;
+								}
 
-								state = lookup[index];
 								*(nextRow + x) = state;
 
 								// next column
@@ -11599,22 +12081,24 @@ void nextGenerationRuleLoaderHexLookup2(
 							}
 
 							// handle right edge
-							nw = n;
-							n = *(gridRow0 + x);
 							w = c;
 							c = e;
-							s = se;
 							if (x == width - 1) {
 								e = 0;
-								se = 0;
 							} else {
-								e = *(gridRow1 + x + 1);
-								se = *(gridRow2 + x + 1);
+								e = gridRow1[x + 1];
 							}
 
-							index = c | (s << 2) | (e << 4) | (w << 6) | (n << 8) | (se << 10) | (nw << 12);
+							uint8_t state = c;
+
+							if (c | e | w) {
+								const uint32_t *const neighbourLuts[3] = {lut0 + c * nCompressed, lut1 + w * nCompressed, lut2 + e * nCompressed};
+								state = ruleTableNextState(neighbourLuts, 3, output, nCompressed, state);
+							} else {
+								// empty neighbourhood
+								state = zeroState;
+							}
 
-							state = lookup[index];
 							*(nextRow + x) = state;
 
 							// load new row
@@ -11834,8 +12318,8 @@ void nextGenerationRuleLoaderHexLookup2(
 
 
 EMSCRIPTEN_KEEPALIVE
-// compute RuleLoader rule next generation for Hexagonal neighbourhood using 3 bit lookup
-void nextGenerationRuleLoaderHexLookup3(
+// compute RuleLoader rule next generation for Hexagonal neighbourhood using 1 bit lookup
+void nextGenerationRuleLoaderHexLookup1(
 	uint8_t *const colourGrid,
 	uint8_t *const nextColourGrid,
 	const uint32_t colourGridWidth,
@@ -11999,9 +12483,9 @@ void nextGenerationRuleLoaderHexLookup3(
 							s = gridRow2[x];
 							if (x == 0) {
 								// handle left edge of grid
-								index = c | (s << 3) | (e << 6) | (n << 12) | (se << 15);
+								index = c | (s << 1) | (e << 2) | (n << 4) | (se << 5);
 							} else {
-								index = (gridRow0[x - 1] << 18) | (gridRow1[x - 1] << 9) | c | (s << 3) | (e << 6) | (n << 12) | (se << 15);
+								index = (gridRow0[x - 1] << 6) | (gridRow1[x - 1] << 3) | c | (s << 1) | (e << 2) | (n << 4) | (se << 5);
 							}
 
 							uint8_t state = lookup[index];
@@ -12020,7 +12504,7 @@ void nextGenerationRuleLoaderHexLookup3(
 								e = *(gridRow1 + x + 1);
 								s = se;
 								se = *(gridRow2 + x + 1);
-								index = c | (s << 3) | (e << 6) | (w << 9) | (n << 12) | (se << 15) | (nw << 18);
+								index = c | (s << 1) | (e << 2) | (w << 3) | (n << 4) | (se << 5) | (nw << 6);
 
 								state = lookup[index];
 								*(nextRow + x) = state;
@@ -12043,7 +12527,7 @@ void nextGenerationRuleLoaderHexLookup3(
 								se = *(gridRow2 + x + 1);
 							}
 
-							index = c | (s << 3) | (e << 6) | (w << 9) | (n << 12) | (se << 15) | (nw << 18);
+							index = c | (s << 1) | (e << 2) | (w << 3) | (n << 4) | (se << 5) | (nw << 6);
 
 							state = lookup[index];
 							*(nextRow + x) = state;
@@ -12262,3 +12746,2408 @@ void nextGenerationRuleLoaderHexLookup3(
 	// update bounding box
 	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
 }
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute RuleLoader rule next generation for Hexagonal neighbourhood using 2 bit lookup
+void nextGenerationRuleLoaderHexLookup2(
+	uint8_t *const colourGrid,
+	uint8_t *const nextColourGrid,
+	const uint32_t colourGridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	uint16_t *const colourTileHistoryGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileGridSize,
+	uint16_t *const diedGrid,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	uint8_t *const lookup,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t tileRows,
+	const uint32_t tileCols,
+	uint16_t *const blankTileRow,
+	const uint32_t blankTileRowWidth,
+	uint8_t *const blankColourRow,
+	const uint32_t counter,
+	const uint32_t bottomRightSet,
+	const uint32_t bottomSet,
+	const uint32_t topRightSet,
+	const uint32_t topSet,
+	const uint32_t bottomLeftSet,
+	const uint32_t topLeftSet,
+	const uint32_t leftSet,
+	const uint32_t rightSet,
+	uint32_t *shared
+) {
+	uint32_t nw, n, w, c, e, s, se;
+
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// tile width
+	const uint32_t xSize = ySize;
+
+	// tile columns in 16 bit values
+	const uint32_t tileCols16 = tileCols >> 4;
+
+	// constants
+	const v128_t zeroVec = wasm_u8x16_splat(0);
+	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// switch buffers each generation
+	uint8_t *grid = nextColourGrid;
+	uint8_t *nextGrid = colourGrid;
+	uint16_t *tileGrid = nextTileGrid16;
+	uint16_t *nextTileGrid = tileGrid16;
+
+	// select the correct grid
+	if ((counter & 1) == 0) {
+		grid = colourGrid;
+		nextGrid = nextColourGrid;
+		tileGrid = tileGrid16;
+		nextTileGrid = nextTileGrid16;
+	}
+
+	// clear column occupied flags
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+
+	// clear row occupied flags
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+
+	// clear the next tile grid
+	memset(nextTileGrid, 0, tileGridSize * sizeof(*nextTileGrid));
+
+	// set the initial tile row
+	uint32_t bottomY = 0;
+	uint32_t topY = bottomY + ySize;
+
+	// scan each row of tiles
+	for (uint32_t th = 0; th < tileRows; th++) {
+		// set initial tile column
+		uint32_t leftX = 0;
+		uint32_t rightX = leftX + xSize;
+
+		// get the colour tile rows
+		uint16_t *tileRow = tileGrid + th * tileGridWidth;
+		uint16_t *nextTileRow = nextTileGrid + th * tileGridWidth;
+		uint16_t *diedRow = diedGrid + th * tileGridWidth;
+		uint16_t *belowNextTileRow = blankTileRow;
+		uint16_t *aboveNextTileRow = blankTileRow;
+
+		// get the tile row below
+		if (th > 0) {
+			belowNextTileRow = nextTileRow - tileGridWidth;
+		}
+
+		// get the tile row above
+		if (th < tileRows - 1) {
+			aboveNextTileRow = nextTileRow + tileGridWidth;
+		}
+
+		// scan each set of tiles
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group (16 tiles)
+			uint32_t tiles = *(tileRow + tw);
+			uint32_t diedTiles = 0;
+
+			// check if any are occupied
+			if (tiles) {
+				// get the destination
+				uint32_t nextTiles = *(nextTileRow + tw);
+				uint32_t belowNextTiles = *(belowNextTileRow + tw);
+				uint32_t aboveNextTiles = *(aboveNextTileRow + tw);
+
+				// compute next colour for each tile in the set
+				for (int32_t bit = 15; bit >= 0; bit--) {
+					// check if this tile is occupied
+					if (tiles & (1 << bit)) {
+						// mark no cells alive in the source tile
+						uint32_t anyAlive = 0;
+
+						// mark no cells in this column
+						uint32_t colOccupied = 0;
+
+						// mark no cells in the tile rows
+						uint32_t rowOccupied = 0;
+
+						// clear the edge flags
+						uint32_t neighbours = 0;
+
+						// process the bottom row of the tile
+						uint32_t y = bottomY;
+						uint32_t rowIndex = 32768;
+
+						// process each row of the tile
+						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
+						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
+
+						while (y < topY) {
+							uint8_t *gridRow0 = blankColourRow;
+							uint8_t *gridRow2 = blankColourRow;
+
+							// deal with bottom row of the grid
+							if (y > 0) {
+								gridRow0 = gridRow1 - colourGridWidth;
+							}
+							// deal with top row of the grid
+							if (y < height - 1) {
+								gridRow2 = gridRow1 + colourGridWidth;
+							}
+
+							// process each column in the row
+							uint32_t x = leftX;
+							uint32_t index;
+
+							// get original 16 cells
+							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
+
+							// process each cell along the tile row
+							e = gridRow1[x + 1];
+							se = gridRow2[x + 1];
+							n = gridRow0[x];
+							c = gridRow1[x];
+							s = gridRow2[x];
+							if (x == 0) {
+								// handle left edge of grid
+								index = c | (s << 2) | (e << 4) | (n << 8) | (se << 10);
+							} else {
+								index = (gridRow0[x - 1] << 12) | (gridRow1[x - 1] << 6) | c | (s << 2) | (e << 4) | (n << 8) | (se << 10);
+							}
+
+							uint8_t state = lookup[index];
+							*(nextRow + x) = state;
+
+							// next column
+							x++;
+
+							// handle middle cells
+							while (x < rightX - 1) {
+								// shift neighbourhood left
+								nw = n;
+								n = *(gridRow0 + x);
+								w = c;
+								c = e;
+								e = *(gridRow1 + x + 1);
+								s = se;
+								se = *(gridRow2 + x + 1);
+								index = c | (s << 2) | (e << 4) | (w << 6) | (n << 8) | (se << 10) | (nw << 12);
+
+								state = lookup[index];
+								*(nextRow + x) = state;
+
+								// next column
+								x++;
+							}
+
+							// handle right edge
+							nw = n;
+							n = *(gridRow0 + x);
+							w = c;
+							c = e;
+							s = se;
+							if (x == width - 1) {
+								e = 0;
+								se = 0;
+							} else {
+								e = *(gridRow1 + x + 1);
+								se = *(gridRow2 + x + 1);
+							}
+
+							index = c | (s << 2) | (e << 4) | (w << 6) | (n << 8) | (se << 10) | (nw << 12);
+
+							state = lookup[index];
+							*(nextRow + x) = state;
+
+							// load new row
+							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
+
+							// get original alive cells
+							v128_t origAliveVec = wasm_u8x16_gt(origCellsVec, zeroVec);
+							uint32_t origAlive = wasm_i8x16_bitmask(origAliveVec);
+
+							// get new alive cells
+							v128_t newAliveVec = wasm_u8x16_gt(newCellsVec, zeroVec);
+							uint32_t newAlive = wasm_i8x16_bitmask(newAliveVec);
+
+							// update births and deaths
+							births += __builtin_popcount(newAlive & ~origAlive);
+							deaths += __builtin_popcount(origAlive & ~newAlive);
+
+							// get new alive cells in correct order
+							newAliveVec = wasm_i8x16_swizzle(newAliveVec, reverseVec);
+							newAlive = wasm_i8x16_bitmask(newAliveVec);
+
+							// update population
+							population += __builtin_popcount(newAlive);
+
+							// check if any cell was alive in the source
+							anyAlive |= origAlive;
+
+							if (newAlive) {
+								colOccupied |= newAlive;
+								rowOccupied |= rowIndex;
+							}
+
+							// next row
+							y++;
+							rowIndex >>= 1;
+							gridRow1 += colourGridWidth;
+							nextRow += colourGridWidth;
+						}
+
+						// update the column and row occupied cells
+						columnOccupied16[leftX >> 4] |= colOccupied;
+
+						// update tile grid if any cells are set
+						if (colOccupied) {
+							// set this tile
+							nextTiles |= (1 << bit);
+
+							// check for neighbours
+							if (rowOccupied & 1) {
+								neighbours |= topSet;
+								if (colOccupied & 32768) {
+									neighbours |= topLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= topRightSet;
+								}
+							}
+
+							if (rowOccupied & 32768) {
+								neighbours |= bottomSet;
+								if (colOccupied & 32768) {
+									neighbours |= bottomLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= bottomRightSet;
+								}
+							}
+
+							if (colOccupied & 32768) {
+								neighbours |= leftSet;
+							}
+
+							if (colOccupied & 1) {
+								neighbours |= rightSet;
+							}
+
+							// update any neighbouring tiles
+							if (neighbours) {
+								// check whether left edge occupied
+								if (neighbours & leftSet) {
+									if (bit < 15) {
+										nextTiles |= (1 << (bit + 1));
+									} else {
+										// set in previous set if not at left edge
+										if ((tw > 0) && (leftX > 0)) {
+											nextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether right edge occupied
+								if (neighbours & rightSet) {
+									if (bit > 0) {
+										nextTiles |= (1 << (bit - 1));
+									} else {
+										// set carry over to go into next set if not at right edge
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											nextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether bottom edge occupied
+								if (neighbours & bottomSet) {
+									// set in lower tile set
+									belowNextTiles |= (1 << bit);
+								}
+
+								// check whether top edge occupied
+								if (neighbours & topSet) {
+									// set in upper tile set
+									aboveNextTiles |= (1 << bit);
+								}
+
+								// check whether bottom left occupied
+								if (neighbours & bottomLeftSet) {
+									if (bit < 15) {
+										belowNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											belowNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether bottom right occupied
+								if (neighbours & bottomRightSet) {
+									if (bit > 0) {
+										belowNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											belowNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether top left occupied
+								if (neighbours & topLeftSet) {
+									if (bit < 15) {
+										aboveNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											aboveNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether top right occupied
+								if (neighbours & topRightSet) {
+									if (bit > 0) {
+										aboveNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											aboveNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+							}
+						} else {
+							// all the cells in the tile died so check if any source cells were alive
+							if (anyAlive) {
+								diedTiles |= 1 << bit;
+							}
+						}
+
+						// save the row occupied falgs
+						rowOccupied16[th] |= rowOccupied;
+					}
+
+					// next tile columns
+					leftX += xSize;
+					rightX += xSize;
+				}
+
+				// save the tile groups
+				nextTileRow[tw] |= nextTiles;
+				if (th > 0) {
+					belowNextTileRow[tw] |= belowNextTiles;
+				}
+				if (th < tileRows - 1) {
+					aboveNextTileRow[tw] |= aboveNextTiles;
+				}
+			} else {
+				// skip tile set
+				leftX += xSize << 4;
+				rightX += xSize << 4;
+			}
+
+			// update tiles where all cells died
+			diedRow[tw] = diedTiles;
+		}
+
+		// next tile rows
+		bottomY += ySize;
+		topY += ySize;
+	}
+
+	// clear the blank tile row since it may have been written to at top and bottom
+	memset(blankTileRow, 0, blankTileRowWidth * sizeof(*blankTileRow));
+
+	// clear tiles in source that died
+	clearTilesThatDied(grid, colourGridWidth, diedGrid, tileRows, tileGridWidth, xSize, ySize, tileCols16);
+
+	// set the history tile grid to the colour tile grid
+	for (uint32_t y = 0; y < tileGridSize; y++) {
+		colourTileHistoryGrid[y] |= tileGrid[y] | nextTileGrid[y];
+	}
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute RuleLoader rule next generation for Hexagonal neighbourhood using 3 bit lookup
+void nextGenerationRuleLoaderHexLookup3(
+	uint8_t *const colourGrid,
+	uint8_t *const nextColourGrid,
+	const uint32_t colourGridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	uint16_t *const colourTileHistoryGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileGridSize,
+	uint16_t *const diedGrid,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	uint8_t *const lookup,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t tileRows,
+	const uint32_t tileCols,
+	uint16_t *const blankTileRow,
+	const uint32_t blankTileRowWidth,
+	uint8_t *const blankColourRow,
+	const uint32_t counter,
+	const uint32_t bottomRightSet,
+	const uint32_t bottomSet,
+	const uint32_t topRightSet,
+	const uint32_t topSet,
+	const uint32_t bottomLeftSet,
+	const uint32_t topLeftSet,
+	const uint32_t leftSet,
+	const uint32_t rightSet,
+	uint32_t *shared
+) {
+	uint32_t nw, n, w, c, e, s, se;
+
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// tile width
+	const uint32_t xSize = ySize;
+
+	// tile columns in 16 bit values
+	const uint32_t tileCols16 = tileCols >> 4;
+
+	// constants
+	const v128_t zeroVec = wasm_u8x16_splat(0);
+	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// switch buffers each generation
+	uint8_t *grid = nextColourGrid;
+	uint8_t *nextGrid = colourGrid;
+	uint16_t *tileGrid = nextTileGrid16;
+	uint16_t *nextTileGrid = tileGrid16;
+
+	// select the correct grid
+	if ((counter & 1) == 0) {
+		grid = colourGrid;
+		nextGrid = nextColourGrid;
+		tileGrid = tileGrid16;
+		nextTileGrid = nextTileGrid16;
+	}
+
+	// clear column occupied flags
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+
+	// clear row occupied flags
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+
+	// clear the next tile grid
+	memset(nextTileGrid, 0, tileGridSize * sizeof(*nextTileGrid));
+
+	// set the initial tile row
+	uint32_t bottomY = 0;
+	uint32_t topY = bottomY + ySize;
+
+	// scan each row of tiles
+	for (uint32_t th = 0; th < tileRows; th++) {
+		// set initial tile column
+		uint32_t leftX = 0;
+		uint32_t rightX = leftX + xSize;
+
+		// get the colour tile rows
+		uint16_t *tileRow = tileGrid + th * tileGridWidth;
+		uint16_t *nextTileRow = nextTileGrid + th * tileGridWidth;
+		uint16_t *diedRow = diedGrid + th * tileGridWidth;
+		uint16_t *belowNextTileRow = blankTileRow;
+		uint16_t *aboveNextTileRow = blankTileRow;
+
+		// get the tile row below
+		if (th > 0) {
+			belowNextTileRow = nextTileRow - tileGridWidth;
+		}
+
+		// get the tile row above
+		if (th < tileRows - 1) {
+			aboveNextTileRow = nextTileRow + tileGridWidth;
+		}
+
+		// scan each set of tiles
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group (16 tiles)
+			uint32_t tiles = *(tileRow + tw);
+			uint32_t diedTiles = 0;
+
+			// check if any are occupied
+			if (tiles) {
+				// get the destination
+				uint32_t nextTiles = *(nextTileRow + tw);
+				uint32_t belowNextTiles = *(belowNextTileRow + tw);
+				uint32_t aboveNextTiles = *(aboveNextTileRow + tw);
+
+				// compute next colour for each tile in the set
+				for (int32_t bit = 15; bit >= 0; bit--) {
+					// check if this tile is occupied
+					if (tiles & (1 << bit)) {
+						// mark no cells alive in the source tile
+						uint32_t anyAlive = 0;
+
+						// mark no cells in this column
+						uint32_t colOccupied = 0;
+
+						// mark no cells in the tile rows
+						uint32_t rowOccupied = 0;
+
+						// clear the edge flags
+						uint32_t neighbours = 0;
+
+						// process the bottom row of the tile
+						uint32_t y = bottomY;
+						uint32_t rowIndex = 32768;
+
+						// process each row of the tile
+						uint8_t *gridRow1 = grid + bottomY * colourGridWidth;
+						uint8_t *nextRow = nextGrid + bottomY * colourGridWidth;
+
+						while (y < topY) {
+							uint8_t *gridRow0 = blankColourRow;
+							uint8_t *gridRow2 = blankColourRow;
+
+							// deal with bottom row of the grid
+							if (y > 0) {
+								gridRow0 = gridRow1 - colourGridWidth;
+							}
+							// deal with top row of the grid
+							if (y < height - 1) {
+								gridRow2 = gridRow1 + colourGridWidth;
+							}
+
+							// process each column in the row
+							uint32_t x = leftX;
+							uint32_t index;
+
+							// get original 16 cells
+							v128_t origCellsVec = wasm_v128_load(gridRow1 + leftX);
+
+							// process each cell along the tile row
+							e = gridRow1[x + 1];
+							se = gridRow2[x + 1];
+							n = gridRow0[x];
+							c = gridRow1[x];
+							s = gridRow2[x];
+							if (x == 0) {
+								// handle left edge of grid
+								index = c | (s << 3) | (e << 6) | (n << 12) | (se << 15);
+							} else {
+								index = (gridRow0[x - 1] << 18) | (gridRow1[x - 1] << 9) | c | (s << 3) | (e << 6) | (n << 12) | (se << 15);
+							}
+
+							uint8_t state = lookup[index];
+							*(nextRow + x) = state;
+
+							// next column
+							x++;
+
+							// handle middle cells
+							while (x < rightX - 1) {
+								// shift neighbourhood left
+								nw = n;
+								n = *(gridRow0 + x);
+								w = c;
+								c = e;
+								e = *(gridRow1 + x + 1);
+								s = se;
+								se = *(gridRow2 + x + 1);
+								index = c | (s << 3) | (e << 6) | (w << 9) | (n << 12) | (se << 15) | (nw << 18);
+
+								state = lookup[index];
+								*(nextRow + x) = state;
+
+								// next column
+								x++;
+							}
+
+							// handle right edge
+							nw = n;
+							n = *(gridRow0 + x);
+							w = c;
+							c = e;
+							s = se;
+							if (x == width - 1) {
+								e = 0;
+								se = 0;
+							} else {
+								e = *(gridRow1 + x + 1);
+								se = *(gridRow2 + x + 1);
+							}
+
+							index = c | (s << 3) | (e << 6) | (w << 9) | (n << 12) | (se << 15) | (nw << 18);
+
+							state = lookup[index];
+							*(nextRow + x) = state;
+
+							// load new row
+							v128_t newCellsVec = wasm_v128_load(nextRow + leftX);
+
+							// get original alive cells
+							v128_t origAliveVec = wasm_u8x16_gt(origCellsVec, zeroVec);
+							uint32_t origAlive = wasm_i8x16_bitmask(origAliveVec);
+
+							// get new alive cells
+							v128_t newAliveVec = wasm_u8x16_gt(newCellsVec, zeroVec);
+							uint32_t newAlive = wasm_i8x16_bitmask(newAliveVec);
+
+							// update births and deaths
+							births += __builtin_popcount(newAlive & ~origAlive);
+							deaths += __builtin_popcount(origAlive & ~newAlive);
+
+							// get new alive cells in correct order
+							newAliveVec = wasm_i8x16_swizzle(newAliveVec, reverseVec);
+							newAlive = wasm_i8x16_bitmask(newAliveVec);
+
+							// update population
+							population += __builtin_popcount(newAlive);
+
+							// check if any cell was alive in the source
+							anyAlive |= origAlive;
+
+							if (newAlive) {
+								colOccupied |= newAlive;
+								rowOccupied |= rowIndex;
+							}
+
+							// next row
+							y++;
+							rowIndex >>= 1;
+							gridRow1 += colourGridWidth;
+							nextRow += colourGridWidth;
+						}
+
+						// update the column and row occupied cells
+						columnOccupied16[leftX >> 4] |= colOccupied;
+
+						// update tile grid if any cells are set
+						if (colOccupied) {
+							// set this tile
+							nextTiles |= (1 << bit);
+
+							// check for neighbours
+							if (rowOccupied & 1) {
+								neighbours |= topSet;
+								if (colOccupied & 32768) {
+									neighbours |= topLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= topRightSet;
+								}
+							}
+
+							if (rowOccupied & 32768) {
+								neighbours |= bottomSet;
+								if (colOccupied & 32768) {
+									neighbours |= bottomLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= bottomRightSet;
+								}
+							}
+
+							if (colOccupied & 32768) {
+								neighbours |= leftSet;
+							}
+
+							if (colOccupied & 1) {
+								neighbours |= rightSet;
+							}
+
+							// update any neighbouring tiles
+							if (neighbours) {
+								// check whether left edge occupied
+								if (neighbours & leftSet) {
+									if (bit < 15) {
+										nextTiles |= (1 << (bit + 1));
+									} else {
+										// set in previous set if not at left edge
+										if ((tw > 0) && (leftX > 0)) {
+											nextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether right edge occupied
+								if (neighbours & rightSet) {
+									if (bit > 0) {
+										nextTiles |= (1 << (bit - 1));
+									} else {
+										// set carry over to go into next set if not at right edge
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											nextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether bottom edge occupied
+								if (neighbours & bottomSet) {
+									// set in lower tile set
+									belowNextTiles |= (1 << bit);
+								}
+
+								// check whether top edge occupied
+								if (neighbours & topSet) {
+									// set in upper tile set
+									aboveNextTiles |= (1 << bit);
+								}
+
+								// check whether bottom left occupied
+								if (neighbours & bottomLeftSet) {
+									if (bit < 15) {
+										belowNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											belowNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether bottom right occupied
+								if (neighbours & bottomRightSet) {
+									if (bit > 0) {
+										belowNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											belowNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether top left occupied
+								if (neighbours & topLeftSet) {
+									if (bit < 15) {
+										aboveNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											aboveNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether top right occupied
+								if (neighbours & topRightSet) {
+									if (bit > 0) {
+										aboveNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											aboveNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+							}
+						} else {
+							// all the cells in the tile died so check if any source cells were alive
+							if (anyAlive) {
+								diedTiles |= 1 << bit;
+							}
+						}
+
+						// save the row occupied falgs
+						rowOccupied16[th] |= rowOccupied;
+					}
+
+					// next tile columns
+					leftX += xSize;
+					rightX += xSize;
+				}
+
+				// save the tile groups
+				nextTileRow[tw] |= nextTiles;
+				if (th > 0) {
+					belowNextTileRow[tw] |= belowNextTiles;
+				}
+				if (th < tileRows - 1) {
+					aboveNextTileRow[tw] |= aboveNextTiles;
+				}
+			} else {
+				// skip tile set
+				leftX += xSize << 4;
+				rightX += xSize << 4;
+			}
+
+			// update tiles where all cells died
+			diedRow[tw] = diedTiles;
+		}
+
+		// next tile rows
+		bottomY += ySize;
+		topY += ySize;
+	}
+
+	// clear the blank tile row since it may have been written to at top and bottom
+	memset(blankTileRow, 0, blankTileRowWidth * sizeof(*blankTileRow));
+
+	// clear tiles in source that died
+	clearTilesThatDied(grid, colourGridWidth, diedGrid, tileRows, tileGridWidth, xSize, ySize, tileCols16);
+
+	// set the history tile grid to the colour tile grid
+	for (uint32_t y = 0; y < tileGridSize; y++) {
+		colourTileHistoryGrid[y] |= tileGrid[y] | nextTileGrid[y];
+	}
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
+
+
+// pack 18 cells of a 2-state colour grid row into bits (cell left of the tile, the 16 tile cells, cell right of the tile)
+static inline uint32_t packColourRow18(
+	const uint8_t *const row,
+	const uint32_t leftX,
+	const uint32_t width,
+	const v128_t zeroVec,
+	const v128_t reverseVec
+) {
+	// get the 16 tile cells with the leftmost cell in bit 15
+	v128_t aliveVec = wasm_i8x16_ne(wasm_v128_load(row + leftX), zeroVec);
+	uint32_t result = wasm_i8x16_bitmask(wasm_i8x16_swizzle(aliveVec, reverseVec)) << 1;
+
+	// add the cell left of the tile
+	if (leftX > 0 && row[leftX - 1]) {
+		result |= 1 << 17;
+	}
+
+	// add the cell right of the tile
+	if (leftX + 16 < width && row[leftX + 16]) {
+		result |= 1;
+	}
+
+	return result;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute 2-state RuleLoader rule next generation using the compiled Life-like bit lookup
+// (each row is packed from and expanded back to the colour grid so memory traffic is the same as the lookup iterators)
+void nextGenerationRuleLoaderBits(
+	uint8_t *const colourGrid,
+	uint8_t *const nextColourGrid,
+	const uint32_t colourGridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	uint16_t *const colourTileHistoryGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileGridSize,
+	uint16_t *const diedGrid,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	uint8_t *const indexLookup63,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t tileRows,
+	const uint32_t tileCols,
+	uint16_t *const blankTileRow,
+	const uint32_t blankTileRowWidth,
+	const uint32_t counter,
+	const uint32_t bottomRightSet,
+	const uint32_t bottomSet,
+	const uint32_t topRightSet,
+	const uint32_t topSet,
+	const uint32_t bottomLeftSet,
+	const uint32_t topLeftSet,
+	const uint32_t leftSet,
+	const uint32_t rightSet,
+	uint32_t *shared
+) {
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// tile width
+	const uint32_t xSize = ySize;
+
+	// tile columns in 16 bit values
+	const uint32_t tileCols16 = tileCols >> 4;
+
+	// constants
+	const v128_t zeroVec = wasm_u8x16_splat(0);
+	const v128_t oneVec = wasm_u8x16_splat(1);
+	const v128_t reverseVec = wasm_u8x16_make(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+	// used to expand 16 output bits into 16 cells with bit 15 in the first cell
+	const v128_t expandVec = wasm_u8x16_make(1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0);
+	const v128_t bitsVec = wasm_u8x16_make(128, 64, 32, 16, 8, 4, 2, 1, 128, 64, 32, 16, 8, 4, 2, 1);
+
+	// switch buffers each generation
+	uint8_t *grid = nextColourGrid;
+	uint8_t *nextGrid = colourGrid;
+	uint16_t *tileGrid = nextTileGrid16;
+	uint16_t *nextTileGrid = tileGrid16;
+
+	// select the correct grid
+	if ((counter & 1) == 0) {
+		grid = colourGrid;
+		nextGrid = nextColourGrid;
+		tileGrid = tileGrid16;
+		nextTileGrid = nextTileGrid16;
+	}
+
+	// clear column occupied flags
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+
+	// clear row occupied flags
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+
+	// clear the next tile grid
+	memset(nextTileGrid, 0, tileGridSize * sizeof(*nextTileGrid));
+
+	// set the initial tile row
+	uint32_t bottomY = 0;
+	uint32_t topY = bottomY + ySize;
+
+	// scan each row of tiles
+	for (uint32_t th = 0; th < tileRows; th++) {
+		// set initial tile column
+		uint32_t leftX = 0;
+
+		// get the colour tile rows
+		uint16_t *tileRow = tileGrid + th * tileGridWidth;
+		uint16_t *nextTileRow = nextTileGrid + th * tileGridWidth;
+		uint16_t *diedRow = diedGrid + th * tileGridWidth;
+		uint16_t *belowNextTileRow = blankTileRow;
+		uint16_t *aboveNextTileRow = blankTileRow;
+
+		// get the tile row below
+		if (th > 0) {
+			belowNextTileRow = nextTileRow - tileGridWidth;
+		}
+
+		// get the tile row above
+		if (th < tileRows - 1) {
+			aboveNextTileRow = nextTileRow + tileGridWidth;
+		}
+
+		// scan each set of tiles
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group (16 tiles)
+			uint32_t tiles = *(tileRow + tw);
+			uint32_t diedTiles = 0;
+
+			// check if any are occupied
+			if (tiles) {
+				// get the destination
+				uint32_t nextTiles = *(nextTileRow + tw);
+				uint32_t belowNextTiles = *(belowNextTileRow + tw);
+				uint32_t aboveNextTiles = *(aboveNextTileRow + tw);
+
+				// compute next colour for each tile in the set
+				for (int32_t bit = 15; bit >= 0; bit--) {
+					// check if this tile is occupied
+					if (tiles & (1 << bit)) {
+						// mark no cells alive in the source tile
+						uint32_t anyAlive = 0;
+
+						// mark no cells in this column
+						uint32_t colOccupied = 0;
+
+						// mark no cells in the tile rows
+						uint32_t rowOccupied = 0;
+
+						// clear the edge flags
+						uint32_t neighbours = 0;
+
+						// process the bottom row of the tile
+						uint32_t y = bottomY;
+						uint32_t rowIndex = 32768;
+
+						// pack the row above, the current row and the row below into bits
+						uint8_t *gridRow1 = grid + y * colourGridWidth;
+						uint32_t val0 = y ? packColourRow18(gridRow1 - colourGridWidth, leftX, width, zeroVec, reverseVec) : 0;
+						uint32_t val1 = packColourRow18(gridRow1, leftX, width, zeroVec, reverseVec);
+						uint32_t val2 = packColourRow18(gridRow1 + colourGridWidth, leftX, width, zeroVec, reverseVec);
+
+						// get pointer to destintation row
+						uint8_t *nextRow = nextGrid + y * colourGridWidth;
+
+						// process each row of the tile
+						while (y < topY) {
+							// compute the 16 new cells 4 at a time using the Life-like lookup
+							uint32_t output = indexLookup63[(val0 >> 12) | (val1 >> 12) << 6 | (val2 & 258048)] << 12;
+							output |= indexLookup63[((val0 >> 8) & 63) | ((val1 >> 2) & 4032) | ((val2 << 4) & 258048)] << 8;
+							output |= indexLookup63[((val0 >> 4) & 63) | ((val1 << 2) & 4032) | ((val2 << 8) & 258048)] << 4;
+							output |= indexLookup63[(val0 & 63) | (val1 & 63) << 6 | (val2 & 63) << 12];
+
+							// expand the bits into cells and write the new row
+							v128_t writeVec = wasm_i8x16_swizzle(wasm_i16x8_splat(output), expandVec);
+							writeVec = wasm_v128_and(wasm_i8x16_ne(wasm_v128_and(writeVec, bitsVec), zeroVec), oneVec);
+							wasm_v128_store(nextRow + leftX, writeVec);
+
+							// get original alive cells
+							uint32_t origAlive = (val1 >> 1) & 65535;
+
+							// update births and deaths
+							births += __builtin_popcount(output & ~origAlive);
+							deaths += __builtin_popcount(origAlive & ~output);
+
+							// update population
+							population += __builtin_popcount(output);
+
+							// check if any cell was alive in the source
+							anyAlive |= origAlive;
+
+							if (output) {
+								colOccupied |= output;
+								rowOccupied |= rowIndex;
+							}
+
+							// next row
+							y++;
+							rowIndex >>= 1;
+
+							// move the three source rows up
+							val0 = val1;
+							val1 = val2;
+							gridRow1 += colourGridWidth;
+
+							// handle bottom of grid
+							val2 = (y < height - 1) ? packColourRow18(gridRow1 + colourGridWidth, leftX, width, zeroVec, reverseVec) : 0;
+
+							// next destination row
+							nextRow += colourGridWidth;
+						}
+
+						// update the column and row occupied cells
+						columnOccupied16[leftX >> 4] |= colOccupied;
+
+						// update tile grid if any cells are set
+						if (colOccupied) {
+							// set this tile
+							nextTiles |= (1 << bit);
+
+							// check for neighbours
+							if (rowOccupied & 1) {
+								neighbours |= topSet;
+								if (colOccupied & 32768) {
+									neighbours |= topLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= topRightSet;
+								}
+							}
+
+							if (rowOccupied & 32768) {
+								neighbours |= bottomSet;
+								if (colOccupied & 32768) {
+									neighbours |= bottomLeftSet;
+								}
+								if (colOccupied & 1) {
+									neighbours |= bottomRightSet;
+								}
+							}
+
+							if (colOccupied & 32768) {
+								neighbours |= leftSet;
+							}
+
+							if (colOccupied & 1) {
+								neighbours |= rightSet;
+							}
+
+							// update any neighbouring tiles
+							if (neighbours) {
+								// check whether left edge occupied
+								if (neighbours & leftSet) {
+									if (bit < 15) {
+										nextTiles |= (1 << (bit + 1));
+									} else {
+										// set in previous set if not at left edge
+										if ((tw > 0) && (leftX > 0)) {
+											nextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether right edge occupied
+								if (neighbours & rightSet) {
+									if (bit > 0) {
+										nextTiles |= (1 << (bit - 1));
+									} else {
+										// set carry over to go into next set if not at right edge
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											nextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether bottom edge occupied
+								if (neighbours & bottomSet) {
+									// set in lower tile set
+									belowNextTiles |= (1 << bit);
+								}
+
+								// check whether top edge occupied
+								if (neighbours & topSet) {
+									// set in upper tile set
+									aboveNextTiles |= (1 << bit);
+								}
+
+								// check whether bottom left occupied
+								if (neighbours & bottomLeftSet) {
+									if (bit < 15) {
+										belowNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											belowNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether bottom right occupied
+								if (neighbours & bottomRightSet) {
+									if (bit > 0) {
+										belowNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											belowNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+
+								// check whether top left occupied
+								if (neighbours & topLeftSet) {
+									if (bit < 15) {
+										aboveNextTiles |= (1 << (bit + 1));
+									} else {
+										if ((tw > 0) && (leftX > 0)) {
+											aboveNextTileRow[tw - 1] |= 1;
+										}
+									}
+								}
+
+								// check whether top right occupied
+								if (neighbours & topRightSet) {
+									if (bit > 0) {
+										aboveNextTiles |= (1 << (bit - 1));
+									} else {
+										if ((tw < tileCols16 - 1) && (leftX < width - 1)) {
+											aboveNextTileRow[tw + 1] |= (1 << 15);
+										}
+									}
+								}
+							}
+						} else {
+							// all the cells in the tile died so check if any source cells were alive
+							if (anyAlive) {
+								diedTiles |= 1 << bit;
+							}
+						}
+
+						// save the row occupied falgs
+						rowOccupied16[th] |= rowOccupied;
+					}
+
+					// next tile columns
+					leftX += xSize;
+				}
+
+				// save the tile groups
+				nextTileRow[tw] |= nextTiles;
+				if (th > 0) {
+					belowNextTileRow[tw] |= belowNextTiles;
+				}
+				if (th < tileRows - 1) {
+					aboveNextTileRow[tw] |= aboveNextTiles;
+				}
+			} else {
+				// skip tile set
+				leftX += xSize << 4;
+			}
+
+			// update tiles where all cells died
+			diedRow[tw] = diedTiles;
+		}
+
+		// next tile rows
+		bottomY += ySize;
+		topY += ySize;
+	}
+
+	// clear the blank tile row since it may have been written to at top and bottom
+	memset(blankTileRow, 0, blankTileRowWidth * sizeof(*blankTileRow));
+
+	// clear tiles in source that died
+	clearTilesThatDied(grid, colourGridWidth, diedGrid, tileRows, tileGridWidth, xSize, ySize, tileCols16);
+
+	// set the history tile grid to the colour tile grid
+	for (uint32_t y = 0; y < tileGridSize; y++) {
+		colourTileHistoryGrid[y] |= tileGrid[y] | nextTileGrid[y];
+	}
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
+
+
+// apply a Margolus or PCA 16 bit block lookup to a pair of rows
+static inline void margolusRows(
+	const uint16_t *const indexLookup,
+	const uint32_t val0,
+	const uint32_t val1,
+	uint32_t *const output0,
+	uint32_t *const output1
+) {
+	uint32_t output = indexLookup[(val0 & 65280) | (val1 >> 8)];
+	uint32_t out0 = output & 65280;
+	uint32_t out1 = (output & 255) << 8;
+
+	output = indexLookup[((val0 & 255) << 8) | (val1 & 255)];
+	*output0 = out0 | (output >> 8);
+	*output1 = out1 | (output & 255);
+}
+
+
+// clear bit grid tiles that died
+static inline void clearTilesThatDied16(
+	uint16_t *const grid,
+	const uint32_t gridWidth,
+	const uint16_t *const diedGrid,
+	const uint32_t diedGridHeight,
+	const uint32_t diedGridWidth,
+	const uint32_t ySize,
+	const uint32_t tileCols16
+) {
+	for (uint32_t th = 0; th < diedGridHeight; th++) {
+		const uint16_t *diedRow = diedGrid + th * diedGridWidth;
+
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			uint32_t diedTiles = diedRow[tw];
+
+			while (diedTiles) {
+				// get the next tile that died
+				uint32_t bit = 31 - __builtin_clz(diedTiles);
+				uint16_t *gridCell = grid + th * ySize * gridWidth + (tw << 4) + (15 - bit);
+
+				// clear 16 cells in each row of the tile
+				for (uint32_t y = 0; y < ySize; y++) {
+					*gridCell = 0;
+					gridCell += gridWidth;
+				}
+
+				diedTiles &= ~(1 << bit);
+			}
+		}
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute Margolus rule next generation
+// the 2x2 blocks start on even cells in the even phase and odd cells in the odd phase so the odd phase shifts each row left by one cell
+void nextGenerationMargolus(
+	uint16_t *const grid16,
+	uint16_t *const nextGrid16,
+	const uint32_t gridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	const uint32_t tileGridWidth,
+	uint16_t *const diedGrid,
+	uint16_t *const indexLookup,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t tileRows,
+	const uint32_t tileCols,
+	uint16_t *const blankTileRow,
+	const uint32_t blankTileWidth,
+	const uint32_t counter,
+	const uint32_t phase,
+	const uint32_t bottomRightSet,
+	const uint32_t bottomSet,
+	const uint32_t topRightSet,
+	const uint32_t topSet,
+	const uint32_t bottomLeftSet,
+	const uint32_t topLeftSet,
+	const uint32_t leftSet,
+	const uint32_t rightSet,
+	const uint32_t tileGridWholeBytes,
+	uint32_t *shared
+) {
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// width in 16 bit chunks
+	const uint32_t width16 = width >> 4;
+
+	// tile columns in 16 bit values
+	const uint32_t tileCols16 = tileCols >> 4;
+
+	// grid
+	uint16_t *grid = grid16;
+	uint16_t *nextGrid = nextGrid16;
+	uint16_t *tileGrid = tileGrid16;
+	uint16_t *nextTileGrid = nextTileGrid16;
+
+	// switch buffers each generation
+	if ((counter & 1) != 0) {
+		grid = nextGrid16;
+		nextGrid = grid16;
+		tileGrid = nextTileGrid16;
+		nextTileGrid = tileGrid16;
+	}
+
+	// clear column and row occupied flags
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+
+	// clear the next tile grid
+	memset(nextTileGrid, 0, tileGridWholeBytes);
+
+	// set the initial tile row
+	uint32_t bottomY = 1 - phase;
+	uint32_t topY = bottomY + ySize;
+
+	// scan each row of tiles
+	for (uint32_t th = 0; th < tileRows; th++) {
+		// set initial tile column
+		uint32_t leftX = 0;
+
+		// get the tile rows
+		uint16_t *tileRow = tileGrid + th * tileGridWidth;
+		uint16_t *nextTileRow = nextTileGrid + th * tileGridWidth;
+		uint16_t *diedRow = diedGrid + th * tileGridWidth;
+		uint16_t *belowNextTileRow = blankTileRow;
+		uint16_t *aboveNextTileRow = blankTileRow;
+
+		if (th > 0) {
+			belowNextTileRow = nextTileRow - tileGridWidth;
+		}
+		if (th < tileRows - 1) {
+			aboveNextTileRow = nextTileRow + tileGridWidth;
+		}
+
+		// scan each set of tiles
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group (16 tiles)
+			uint32_t tiles = tileRow[tw];
+			uint32_t diedTiles = 0;
+
+			// check if any are occupied
+			if (tiles) {
+				// get the destination (with any set because of edges)
+				uint32_t nextTiles = nextTileRow[tw];
+				uint32_t belowNextTiles = belowNextTileRow[tw];
+				uint32_t aboveNextTiles = aboveNextTileRow[tw];
+
+				// compute next generation for each set tile
+				for (int32_t b = 15; b >= 0; b--) {
+					// check if this tile needs computing
+					if (tiles & (1 << b)) {
+						// check if on right tile
+						const uint32_t rightTile = (b == 0 && tw == tileCols16 - 1);
+						uint32_t colOccupied = 0;
+						uint32_t origValue = 0;
+						uint32_t neighbours = 0;
+						uint32_t val0, val1, output0, output1, output;
+
+						// process each pair of rows in the tile
+						uint32_t h = bottomY;
+						uint32_t firstRow = 1;
+						uint32_t lastRow = 0;
+
+						while (!lastRow) {
+							lastRow = (!firstRow && h >= topY - 2);
+
+							uint16_t *row0 = grid + h * gridWidth + leftX;
+							uint16_t *row1 = row0 + gridWidth;
+							uint16_t *nextRow0 = nextGrid + h * gridWidth + leftX;
+							uint16_t *nextRow1 = nextRow0 + gridWidth;
+
+							// get original value for next two rows
+							if (phase != 0) {
+								val0 = row0[0];
+								val1 = row1[0];
+							} else {
+								if (rightTile) {
+									val0 = (row0[0] << 1) & 65535;
+									val1 = (row1[0] << 1) & 65535;
+								} else {
+									val0 = ((row0[0] << 1) | (row0[1] >> 15)) & 65535;
+									val1 = ((row1[0] << 1) | (row1[1] >> 15)) & 65535;
+								}
+							}
+							origValue |= val0 | val1;
+
+							// get output
+							margolusRows(indexLookup, val0, val1, &output0, &output1);
+
+							// save output 16bits
+							if (phase != 0) {
+								nextRow0[0] = output0;
+								nextRow1[0] = output1;
+							} else {
+								nextRow0[0] = (nextRow0[0] & 32768) | (output0 >> 1);
+								nextRow1[0] = (nextRow1[0] & 32768) | (output1 >> 1);
+								if (!rightTile) {
+									nextRow0[1] = (nextRow0[1] & 32767) | ((output0 & 1) << 15);
+									nextRow1[1] = (nextRow1[1] & 32767) | ((output1 & 1) << 15);
+								}
+							}
+
+							// update statistics
+							population += __builtin_popcount(output0) + __builtin_popcount(output1);
+							births += __builtin_popcount(output0 & ~val0) + __builtin_popcount(output1 & ~val1);
+							deaths += __builtin_popcount(val0 & ~output0) + __builtin_popcount(val1 & ~output1);
+
+							// check if any cells are set
+							output = output0 | output1;
+							if (output) {
+								// update column occupied flag
+								colOccupied |= output;
+
+								// update occupied rows
+								if (output0) {
+									rowOccupied16[h >> 4] |= 32768 >> (h & 15);
+								}
+								if (output1) {
+									rowOccupied16[(h + 1) >> 4] |= 32768 >> ((h + 1) & 15);
+								}
+
+								// update edge flags
+								if (phase != 0) {
+									if (firstRow) {
+										if (output & 49152) {
+											neighbours |= bottomLeftSet;
+										}
+										if (output & 3) {
+											neighbours |= bottomRightSet;
+										}
+										neighbours |= bottomSet;
+									}
+									if (lastRow) {
+										if (output & 49152) {
+											neighbours |= topLeftSet;
+										}
+										if (output & 3) {
+											neighbours |= topRightSet;
+										}
+										neighbours |= topSet;
+									}
+								} else {
+									// there is no neighbour below since this is the odd phase
+									if (lastRow) {
+										if (output & 3) {
+											neighbours |= topRightSet;
+										}
+										neighbours |= topSet;
+									}
+								}
+							}
+
+							// in the odd phase the top row source cells are also carried up
+							if (phase == 0 && lastRow && (val0 | val1)) {
+								if ((val0 | val1) & 3) {
+									neighbours |= topRightSet;
+								}
+								neighbours |= topSet;
+							}
+
+							// next pair of rows
+							firstRow = 0;
+							h += 2;
+						}
+
+						// check which columns contained cells
+						if (phase != 0) {
+							if (colOccupied) {
+								if (colOccupied & 49152) {
+									neighbours |= leftSet;
+								}
+								if (colOccupied & 3) {
+									neighbours |= rightSet;
+								}
+
+								// save the column occupied cells
+								columnOccupied16[leftX] |= colOccupied;
+							}
+
+							// if there were new cells or original cells then ensure right and top right get processed next generation
+							if (colOccupied || origValue) {
+								neighbours |= topRightSet | rightSet;
+							}
+						} else {
+							if (colOccupied) {
+								if (colOccupied & 3) {
+									neighbours |= rightSet;
+								}
+
+								// save the column occupied cells
+								columnOccupied16[leftX] |= colOccupied >> 1;
+								if (leftX + 1 < columnOccupiedWidth) {
+									columnOccupied16[leftX + 1] |= (colOccupied & 1) << 15;
+								}
+							}
+
+							if (origValue & 3) {
+								neighbours |= rightSet;
+							}
+						}
+
+						// check if the source or output were alive
+						if (colOccupied || origValue) {
+							// update
+							nextTiles |= (1 << b);
+
+							// check whether left edge occupied
+							if (neighbours & leftSet) {
+								if (b < 15) {
+									nextTiles |= (1 << (b + 1));
+								} else {
+									// set in previous set if not at left edge
+									if ((tw > 0) && (leftX > 0)) {
+										nextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether right edge occupied
+							if (neighbours & rightSet) {
+								if (b > 0) {
+									nextTiles |= (1 << (b - 1));
+								} else {
+									// set carry over to go into next set if not at right edge
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										nextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+
+							// check whether bottom edge occupied
+							if (neighbours & bottomSet) {
+								belowNextTiles |= (1 << b);
+							}
+
+							// check whether top edge occupied
+							if (neighbours & topSet) {
+								aboveNextTiles |= (1 << b);
+							}
+
+							// check whether bottom left occupied
+							if (neighbours & bottomLeftSet) {
+								if (b < 15) {
+									belowNextTiles |= (1 << (b + 1));
+								} else {
+									if ((tw > 0) && (leftX > 0)) {
+										belowNextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether bottom right occupied
+							if (neighbours & bottomRightSet) {
+								if (b > 0) {
+									belowNextTiles |= (1 << (b - 1));
+								} else {
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										belowNextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+
+							// check whether top left occupied
+							if (neighbours & topLeftSet) {
+								if (b < 15) {
+									aboveNextTiles |= (1 << (b + 1));
+								} else {
+									if ((tw > 0) && (leftX > 0)) {
+										aboveNextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether top right occupied
+							if (neighbours & topRightSet) {
+								if (b > 0) {
+									aboveNextTiles |= (1 << (b - 1));
+								} else {
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										aboveNextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+						}
+
+						// update tiles that died
+						if (colOccupied == 0 && origValue) {
+							diedTiles |= 1 << b;
+						}
+					}
+
+					// next tile column
+					leftX++;
+				}
+
+				// save the tile groups
+				nextTileRow[tw] |= nextTiles;
+				if (th > 0) {
+					belowNextTileRow[tw] |= belowNextTiles;
+				}
+				if (th < tileRows - 1) {
+					aboveNextTileRow[tw] |= aboveNextTiles;
+				}
+			} else {
+				// skip tile set
+				leftX += 16;
+			}
+
+			// update tiles where all cells died
+			diedRow[tw] = diedTiles;
+		}
+
+		// next tile rows
+		bottomY += ySize;
+		topY += ySize;
+		if (topY >= height) {
+			topY = height - 1;
+		}
+	}
+
+	// clear the blank tile row since it may have been written to at top and bottom
+	memset(blankTileRow, 0, blankTileWidth * sizeof(*blankTileRow));
+
+	// clear tiles in source that died
+	clearTilesThatDied16(grid, gridWidth, diedGrid, tileRows, tileGridWidth, ySize, tileCols16);
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute PCA rule next generation
+// each cell holds 4 bits (n, e, s, w) and the lookup maps the facing bits of the four orthogonal neighbours to the new cell
+void nextGenerationPCA(
+	uint8_t *const colourGrid,
+	uint8_t *const nextColourGrid,
+	const uint32_t colourGridWidth,
+	uint16_t *const colourTileHistoryGrid,
+	const uint32_t tileGridWidth,
+	uint16_t *const indexLookup,
+	const uint32_t counter,
+	const uint32_t deadState,
+	const uint32_t minDeadState,
+	const int32_t width,
+	const int32_t height,
+	const int32_t leftX,
+	const int32_t bottomY,
+	const int32_t rightX,
+	const int32_t topY,
+	uint32_t *shared
+) {
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// new history and alive bounding boxes
+	int32_t nLeftX = width, nBottomY = height, nRightX = 0, nTopY = 0;
+	int32_t zLeftX = width, zBottomY = height, zRightX = 0, zTopY = 0;
+
+	// select the correct grid
+	uint8_t *grid = colourGrid;
+	uint8_t *nextGrid = nextColourGrid;
+
+	if ((counter & 1) != 0) {
+		grid = nextColourGrid;
+		nextGrid = colourGrid;
+	}
+
+	// process each cell in the bounding box
+	for (int32_t y = bottomY - 1; y <= topY + 1; y++) {
+		const uint8_t *aboveRow = grid + (y - 1) * colourGridWidth;
+		const uint8_t *gridRow = grid + y * colourGridWidth;
+		const uint8_t *belowRow = grid + (y + 1) * colourGridWidth;
+		uint16_t *tileRow = colourTileHistoryGrid + (y >> 4) * tileGridWidth;
+		uint8_t *nextRow = nextGrid + y * colourGridWidth;
+		uint32_t rowAlive = 0;
+		uint32_t zAlive = 0;
+
+		uint32_t w = (leftX >= 2 ? gridRow[leftX - 2] : 0);
+
+		for (int32_t x = leftX - 1; x <= rightX + 1; x++) {
+			uint32_t n = belowRow[x];
+			uint32_t e = gridRow[x + 1];
+			uint32_t s = aboveRow[x];
+
+			if (deadState > 0) {
+				n = (n <= deadState ? 0 : n - deadState);
+				e = (e <= deadState ? 0 : e - deadState);
+				s = (s <= deadState ? 0 : s - deadState);
+				w = (w <= deadState ? 0 : w - deadState);
+			}
+
+			uint32_t state = indexLookup[w | (n << 4) | (e << 8) | (s << 12)];
+			w = gridRow[x];
+
+			// check if state is alive
+			if (state > 0) {
+				population += __builtin_popcount(state);
+				nextRow[x] = state + deadState;
+				rowAlive = 1;
+				tileRow[x >> 8] = 65535;
+
+				// update bounding box
+				if (x < nLeftX) {
+					nLeftX = x;
+				}
+				if (x > nRightX) {
+					nRightX = x;
+				}
+			} else {
+				// check for death
+				state = w;
+				if (state > deadState) {
+					state = deadState;
+				} else {
+					// check for dying
+					if (state > minDeadState) {
+						state--;
+					}
+				}
+				nextRow[x] = state;
+				if (state > 0) {
+					rowAlive = 1;
+					if (x < nLeftX) {
+						nLeftX = x;
+					}
+					if (x > nRightX) {
+						nRightX = x;
+					}
+				}
+				state = 0;
+			}
+
+			// updates births and deaths from the 4 cell bitmap
+			if (w > deadState) {
+				uint32_t alive = w - deadState;
+				births += __builtin_popcount(state & ~alive);
+				deaths += __builtin_popcount(alive & ~state);
+			} else {
+				births += __builtin_popcount(state);
+			}
+
+			// check for alive states
+			if (state > 0) {
+				if (x < zLeftX) {
+					zLeftX = x;
+				}
+				if (x > zRightX) {
+					zRightX = x;
+				}
+				zAlive = 1;
+			}
+		}
+
+		// if any cells alive in the row then update bounding box
+		if (rowAlive) {
+			if (y < nBottomY) {
+				nBottomY = y;
+			}
+			if (y > nTopY) {
+				nTopY = y;
+			}
+		}
+		if (zAlive) {
+			if (y < zBottomY) {
+				zBottomY = y;
+			}
+			if (y > zTopY) {
+				zTopY = y;
+			}
+		}
+	}
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+	*shared++ = nLeftX;
+	*shared++ = nBottomY;
+	*shared++ = nRightX;
+	*shared++ = nTopY;
+	*shared++ = zLeftX;
+	*shared++ = zBottomY;
+	*shared++ = zRightX;
+	*shared++ = zTopY;
+}
+
+
+// read 16 cells from a triangular grid row with two cells either side
+static inline uint32_t triangularCells(
+	const uint16_t *const row,
+	const uint32_t leftX,
+	const uint32_t gridWidth
+) {
+	uint32_t result = row[leftX] << 2;
+
+	if (leftX > 0) {
+		result |= (uint32_t)row[leftX - 1] << 18;
+	}
+	if (leftX + 1 < gridWidth) {
+		result |= row[leftX + 1] >> 14;
+	}
+
+	return result;
+}
+
+
+// compute the next 16 cells of a triangular row from the rows below, current and above
+// pointing up and down triangles alternate so val0 and val2 swap roles every other cell
+static inline uint32_t triangularRow(
+	const uint8_t *const indexLookup,
+	const uint32_t val0,
+	const uint32_t val1,
+	const uint32_t val2
+) {
+	const uint32_t maskL = (1 << 12) | (1 << 11) | (1 << 10) | (1 << 9) | (1 << 8);
+	const uint32_t maskC = (1 << 7) | (1 << 6) | (1 << 5);
+	const uint32_t maskR = (1 << 4) | (1 << 3) | (1 << 2) | (1 << 1) | (1 << 0);
+
+	uint32_t output = indexLookup[((val0 >> 7) & maskL) | ((val2 >> 11) & maskC) | ((val1 >> 15) & maskR)] << 15;
+	output |= indexLookup[((val2 >> 6) & maskL) | ((val0 >> 10) & maskC) | ((val1 >> 14) & maskR)] << 14;
+	output |= indexLookup[((val0 >> 5) & maskL) | ((val2 >> 9) & maskC) | ((val1 >> 13) & maskR)] << 13;
+	output |= indexLookup[((val2 >> 4) & maskL) | ((val0 >> 8) & maskC) | ((val1 >> 12) & maskR)] << 12;
+	output |= indexLookup[((val0 >> 3) & maskL) | ((val2 >> 7) & maskC) | ((val1 >> 11) & maskR)] << 11;
+	output |= indexLookup[((val2 >> 2) & maskL) | ((val0 >> 6) & maskC) | ((val1 >> 10) & maskR)] << 10;
+	output |= indexLookup[((val0 >> 1) & maskL) | ((val2 >> 5) & maskC) | ((val1 >> 9) & maskR)] << 9;
+	output |= indexLookup[(val2 & maskL) | ((val0 >> 4) & maskC) | ((val1 >> 8) & maskR)] << 8;
+	output |= indexLookup[((val0 << 1) & maskL) | ((val2 >> 3) & maskC) | ((val1 >> 7) & maskR)] << 7;
+	output |= indexLookup[((val2 << 2) & maskL) | ((val0 >> 2) & maskC) | ((val1 >> 6) & maskR)] << 6;
+	output |= indexLookup[((val0 << 3) & maskL) | ((val2 >> 1) & maskC) | ((val1 >> 5) & maskR)] << 5;
+	output |= indexLookup[((val2 << 4) & maskL) | (val0 & maskC) | ((val1 >> 4) & maskR)] << 4;
+	output |= indexLookup[((val0 << 5) & maskL) | ((val2 << 1) & maskC) | ((val1 >> 3) & maskR)] << 3;
+	output |= indexLookup[((val2 << 6) & maskL) | ((val0 << 2) & maskC) | ((val1 >> 2) & maskR)] << 2;
+	output |= indexLookup[((val0 << 7) & maskL) | ((val2 << 3) & maskC) | ((val1 >> 1) & maskR)] << 1;
+	output |= indexLookup[((val2 << 8) & maskL) | ((val0 << 4) & maskC) | (val1 & maskR)];
+
+	return output;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute 2-state triangular rule next generation
+// rows with odd y swap the roles of the rows below and above since their triangles point the other way
+void nextGenerationTriangularLife(
+	uint16_t *const grid16,
+	uint16_t *const nextGrid16,
+	const uint32_t gridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	const uint32_t tileGridWidth,
+	uint8_t *const indexLookupTri1,
+	uint8_t *const indexLookupTri2,
+	const uint32_t altSpecified,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t tileRows,
+	const uint32_t tileCols,
+	uint16_t *const blankTileRow,
+	const uint32_t blankTileWidth,
+	uint16_t *const blankRow16,
+	const uint32_t counter,
+	const uint32_t bottomRightSet,
+	const uint32_t bottomSet,
+	const uint32_t topRightSet,
+	const uint32_t topSet,
+	const uint32_t bottomLeftSet,
+	const uint32_t topLeftSet,
+	const uint32_t leftSet,
+	const uint32_t rightSet,
+	const uint32_t tileGridWholeBytes,
+	uint32_t *shared
+) {
+	// population statistics
+	uint32_t population = 0, births = 0, deaths = 0;
+
+	// width in 16 bit chunks
+	const uint32_t width16 = width >> 4;
+
+	// tile columns in 16 bit values
+	const uint32_t tileCols16 = tileCols >> 4;
+
+	// grid
+	uint16_t *grid = grid16;
+	uint16_t *nextGrid = nextGrid16;
+	uint16_t *tileGrid = tileGrid16;
+	uint16_t *nextTileGrid = nextTileGrid16;
+	uint8_t *indexLookup = indexLookupTri1;
+
+	// switch buffers each generation
+	if ((counter & 1) != 0) {
+		grid = nextGrid16;
+		nextGrid = grid16;
+		tileGrid = nextTileGrid16;
+		nextTileGrid = tileGrid16;
+
+		// get alternate lookup buffer if specified
+		if (altSpecified) {
+			indexLookup = indexLookupTri2;
+		}
+	}
+
+	// clear column and row occupied flags
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+
+	// clear the next tile grid
+	memset(nextTileGrid, 0, tileGridWholeBytes);
+
+	// set the initial tile row
+	uint32_t bottomY = 0;
+	uint32_t topY = bottomY + ySize;
+
+	// scan each row of tiles
+	for (uint32_t th = 0; th < tileRows; th++) {
+		// set initial tile column
+		uint32_t leftX = 0;
+
+		// get the tile rows
+		uint16_t *tileRow = tileGrid + th * tileGridWidth;
+		uint16_t *nextTileRow = nextTileGrid + th * tileGridWidth;
+		uint16_t *belowNextTileRow = blankTileRow;
+		uint16_t *aboveNextTileRow = blankTileRow;
+
+		if (th > 0) {
+			belowNextTileRow = nextTileRow - tileGridWidth;
+		}
+		if (th < tileRows - 1) {
+			aboveNextTileRow = nextTileRow + tileGridWidth;
+		}
+
+		// scan each set of tiles
+		for (uint32_t tw = 0; tw < tileCols16; tw++) {
+			// get the next tile group (16 tiles)
+			uint32_t tiles = tileRow[tw];
+
+			// check if any are occupied
+			if (tiles) {
+				// get the destination (with any set because of edges)
+				uint32_t nextTiles = nextTileRow[tw];
+				uint32_t belowNextTiles = belowNextTileRow[tw];
+				uint32_t aboveNextTiles = aboveNextTileRow[tw];
+
+				// compute next generation for each set tile
+				for (int32_t b = 15; b >= 0; b--) {
+					// check if this tile needs computing
+					if (tiles & (1 << b)) {
+						uint32_t colOccupied = 0;
+						uint32_t neighbours = 0;
+						uint32_t tileCells = 0;
+
+						// get the row below the tile
+						const uint16_t *gridRow0 = blankRow16;
+						if (bottomY > 0) {
+							gridRow0 = grid + (bottomY - 1) * gridWidth;
+						}
+
+						// read the rows below and bottom row of the tile
+						uint32_t val1 = triangularCells(gridRow0, leftX, gridWidth);
+						uint32_t val2 = triangularCells(grid + bottomY * gridWidth, leftX, gridWidth);
+
+						// process each row of the tile
+						for (uint32_t h = bottomY; h < topY; h++) {
+							// get original value
+							uint32_t origValue = grid[h * gridWidth + leftX];
+							tileCells |= origValue;
+
+							// get the row above (blank at the top of the grid)
+							const uint16_t *gridRow2 = blankRow16;
+							if (h < height - 1) {
+								gridRow2 = grid + (h + 1) * gridWidth;
+							}
+
+							// read three rows
+							uint32_t val0 = val1;
+							val1 = val2;
+							val2 = triangularCells(gridRow2, leftX, gridWidth);
+
+							// get output
+							uint32_t output;
+							if (h & 1) {
+								output = triangularRow(indexLookup, val2, val1, val0);
+							} else {
+								output = triangularRow(indexLookup, val0, val1, val2);
+							}
+
+							// save output 16bits
+							nextGrid[h * gridWidth + leftX] = output;
+
+							// update statistics
+							population += __builtin_popcount(output);
+							births += __builtin_popcount(output & ~origValue);
+							deaths += __builtin_popcount(origValue & ~output);
+
+							// check if any cells are set
+							if (output) {
+								// update column occupied flag
+								colOccupied |= output;
+
+								// update occupied rows
+								rowOccupied16[h >> 4] |= 32768 >> (h & 15);
+
+								// check for bottom row set
+								if (h == bottomY) {
+									if (output & 49152) {
+										neighbours |= bottomLeftSet;
+									}
+									if (output & 3) {
+										neighbours |= bottomRightSet;
+									}
+									neighbours |= bottomSet;
+								}
+
+								// check for top row set
+								if (h == topY - 1) {
+									if (output & 49152) {
+										neighbours |= topLeftSet;
+									}
+									if (output & 3) {
+										neighbours |= topRightSet;
+									}
+									neighbours |= topSet;
+								}
+							}
+						}
+
+						// check which columns contained cells
+						if (colOccupied & 49152) {
+							neighbours |= leftSet;
+						}
+						if (colOccupied & 3) {
+							neighbours |= rightSet;
+						}
+
+						// save the column occupied cells
+						columnOccupied16[leftX] |= colOccupied;
+
+						// check if the source or output were alive
+						if (colOccupied || tileCells) {
+							// update
+							nextTiles |= (1 << b);
+
+							// check whether left edge occupied
+							if (neighbours & leftSet) {
+								if (b < 15) {
+									nextTiles |= (1 << (b + 1));
+								} else {
+									// set in previous set if not at left edge
+									if ((tw > 0) && (leftX > 0)) {
+										nextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether right edge occupied
+							if (neighbours & rightSet) {
+								if (b > 0) {
+									nextTiles |= (1 << (b - 1));
+								} else {
+									// set carry over to go into next set if not at right edge
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										nextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+
+							// check whether bottom edge occupied
+							if (neighbours & bottomSet) {
+								belowNextTiles |= (1 << b);
+							}
+
+							// check whether top edge occupied
+							if (neighbours & topSet) {
+								aboveNextTiles |= (1 << b);
+							}
+
+							// check whether bottom left occupied
+							if (neighbours & bottomLeftSet) {
+								if (b < 15) {
+									belowNextTiles |= (1 << (b + 1));
+								} else {
+									if ((tw > 0) && (leftX > 0)) {
+										belowNextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether bottom right occupied
+							if (neighbours & bottomRightSet) {
+								if (b > 0) {
+									belowNextTiles |= (1 << (b - 1));
+								} else {
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										belowNextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+
+							// check whether top left occupied
+							if (neighbours & topLeftSet) {
+								if (b < 15) {
+									aboveNextTiles |= (1 << (b + 1));
+								} else {
+									if ((tw > 0) && (leftX > 0)) {
+										aboveNextTileRow[tw - 1] |= 1;
+									}
+								}
+							}
+
+							// check whether top right occupied
+							if (neighbours & topRightSet) {
+								if (b > 0) {
+									aboveNextTiles |= (1 << (b - 1));
+								} else {
+									if ((tw < tileCols16 - 1) && (leftX < width16 - 1)) {
+										aboveNextTileRow[tw + 1] |= (1 << 15);
+									}
+								}
+							}
+						}
+					}
+
+					// next tile column
+					leftX++;
+				}
+
+				// save the tile groups
+				nextTileRow[tw] |= nextTiles;
+				if (th > 0) {
+					belowNextTileRow[tw] |= belowNextTiles;
+				}
+				if (th < tileRows - 1) {
+					aboveNextTileRow[tw] |= aboveNextTiles;
+				}
+			} else {
+				// skip tile set
+				leftX += 16;
+			}
+		}
+
+		// next tile rows
+		bottomY += ySize;
+		topY += ySize;
+	}
+
+	// clear the blank tile row since it may have been written to at top and bottom
+	memset(blankTileRow, 0, blankTileWidth * sizeof(*blankTileRow));
+
+	// return data to JS
+	*shared++ = population;
+	*shared++ = births;
+	*shared++ = deaths;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
+
+
+// compute the Wolfram rule output for a 16 cell word given the words either side
+static inline uint32_t wolframWord(
+	const uint32_t rule,
+	const uint32_t prev,
+	const uint32_t cur,
+	const uint32_t next
+) {
+	// left and right neighbours of each cell (bit 15 is the leftmost cell)
+	const uint32_t l = ((cur >> 1) | (prev << 15)) & 65535;
+	const uint32_t r = ((cur << 1) | (next >> 15)) & 65535;
+	uint32_t result = 0;
+
+	// combine the neighbourhoods that are set in the rule (rule is even so the empty neighbourhood is never included)
+	for (uint32_t k = 1; k < 8; k++) {
+		if (rule & (1 << k)) {
+			result |= ((k & 4) ? l : ~l) & ((k & 2) ? cur : ~cur) & ((k & 1) ? r : ~r);
+		}
+	}
+
+	return result & 65535;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// compute the next generation for a settled Wolfram pattern by stepping only the frontier row
+void nextGenerationWolfram1D(
+	uint16_t *const grid16,
+	uint16_t *const nextGrid16,
+	const uint32_t gridWidth,
+	uint16_t *const tileGrid16,
+	uint16_t *const nextTileGrid16,
+	const uint32_t tileGridWidth,
+	const uint32_t tileGridSize,
+	uint16_t *const columnOccupied16,
+	const uint32_t columnOccupiedWidth,
+	uint16_t *const rowOccupied16,
+	const uint32_t rowOccupiedWidth,
+	const uint32_t rule,
+	const uint32_t population,
+	const uint32_t leftX,
+	const uint32_t rightX,
+	const uint32_t bottomY,
+	const uint32_t frontierY,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t ySize,
+	const uint32_t counter,
+	uint32_t *shared
+) {
+	// grid
+	uint16_t *grid = nextGrid16;
+	uint16_t *nextGrid = grid16;
+	uint16_t *tileGrid = nextTileGrid16;
+	uint16_t *nextTileGrid = tileGrid16;
+
+	// select the correct grid
+	if ((counter & 1) == 0) {
+		grid = grid16;
+		nextGrid = nextGrid16;
+		tileGrid = tileGrid16;
+		nextTileGrid = nextTileGrid16;
+	}
+
+	// the frontier row and the row it generates
+	const uint16_t *frontierRow = grid + frontierY * gridWidth;
+	const uint32_t targetY = frontierY + 1;
+	uint16_t *targetRow = grid + targetY * gridWidth;
+	uint16_t *nextTargetRow = nextGrid + targetY * gridWidth;
+
+	// both buffers hold the full history so make the next buffer match the current one
+	memcpy(nextGrid + frontierY * gridWidth, frontierRow, gridWidth * sizeof(*frontierRow));
+	memcpy(nextTileGrid, tileGrid, tileGridSize * sizeof(*tileGrid));
+
+	// the new row can extend at most one cell beyond the current extent on each side
+	const uint32_t leftW = (leftX >> 4) > 0 ? (leftX >> 4) - 1 : 0;
+	const uint32_t rightW = (rightX >> 4) + 1 < gridWidth ? (rightX >> 4) + 1 : gridWidth - 1;
+
+	uint32_t births = 0;
+	uint32_t w = leftW;
+
+	// rebuild the occupancy from the current bounding box (only its edges matter) so it does not depend on the previous step
+	memset(columnOccupied16, 0, columnOccupiedWidth * sizeof(*columnOccupied16));
+	memset(rowOccupied16, 0, rowOccupiedWidth * sizeof(*rowOccupied16));
+	columnOccupied16[leftX >> 4] |= 32768 >> (leftX & 15);
+	columnOccupied16[rightX >> 4] |= 32768 >> (rightX & 15);
+	rowOccupied16[bottomY >> 4] |= 32768 >> (bottomY & 15);
+	rowOccupied16[frontierY >> 4] |= 32768 >> (frontierY & 15);
+
+	while (w <= rightW) {
+		if (w > 0 && w + 8 < gridWidth && w + 7 <= rightW) {
+			// process 8 words at once
+			const v128_t cur = wasm_v128_load(frontierRow + w);
+			const v128_t prev = wasm_v128_load(frontierRow + w - 1);
+			const v128_t next = wasm_v128_load(frontierRow + w + 1);
+			const v128_t l = wasm_v128_or(wasm_u16x8_shr(cur, 1), wasm_i16x8_shl(prev, 15));
+			const v128_t r = wasm_v128_or(wasm_i16x8_shl(cur, 1), wasm_u16x8_shr(next, 15));
+			const v128_t nl = wasm_v128_not(l);
+			const v128_t nc = wasm_v128_not(cur);
+			const v128_t nr = wasm_v128_not(r);
+			v128_t result = wasm_i16x8_splat(0);
+
+			for (uint32_t k = 1; k < 8; k++) {
+				if (rule & (1 << k)) {
+					result = wasm_v128_or(result, wasm_v128_and(wasm_v128_and((k & 4) ? l : nl, (k & 2) ? cur : nc), (k & 1) ? r : nr));
+				}
+			}
+
+			wasm_v128_store(targetRow + w, result);
+			wasm_v128_store(nextTargetRow + w, result);
+
+			// update population and column occupied flags for any set words
+			if (wasm_v128_any_true(result)) {
+				for (uint32_t i = 0; i < 8; i++) {
+					const uint32_t value = targetRow[w + i];
+					if (value) {
+						births += __builtin_popcount(value);
+						columnOccupied16[w + i] |= value;
+					}
+				}
+			}
+			w += 8;
+		} else {
+			// process a single word
+			const uint32_t value = wolframWord(rule, w > 0 ? frontierRow[w - 1] : 0, frontierRow[w], w + 1 < gridWidth ? frontierRow[w + 1] : 0);
+
+			targetRow[w] = value;
+			nextTargetRow[w] = value;
+			if (value) {
+				births += __builtin_popcount(value);
+				columnOccupied16[w] |= value;
+			}
+			w++;
+		}
+	}
+
+	// mark the tiles containing the new row and their neighbours in both tile grids
+	if (births) {
+		const uint32_t tileCols = tileGridWidth << 4;
+		const uint32_t tileRows = tileGridSize / tileGridWidth;
+		const uint32_t th = targetY / ySize;
+
+		rowOccupied16[targetY >> 4] |= 32768 >> (targetY & 15);
+
+		for (w = leftW; w <= rightW; w++) {
+			if (targetRow[w]) {
+				const uint32_t first = w > 0 ? w - 1 : 0;
+				const uint32_t last = w + 1 < tileCols ? w + 1 : tileCols - 1;
+
+				for (uint32_t tc = first; tc <= last; tc++) {
+					const uint32_t bit = 32768 >> (tc & 15);
+
+					tileGrid[th * tileGridWidth + (tc >> 4)] |= bit;
+					nextTileGrid[th * tileGridWidth + (tc >> 4)] |= bit;
+
+					// if the new row is the top of the tile then the tile above is also needed
+					if ((targetY % ySize) == ySize - 1 && th + 1 < tileRows) {
+						tileGrid[(th + 1) * tileGridWidth + (tc >> 4)] |= bit;
+						nextTileGrid[(th + 1) * tileGridWidth + (tc >> 4)] |= bit;
+					}
+				}
+			}
+		}
+	}
+
+	// return data to JS
+	*shared++ = population + births;
+	*shared++ = births;
+	*shared++ = 0;
+
+	// update bounding box
+	shared = updateBoundingBox(columnOccupied16, columnOccupiedWidth, rowOccupied16, rowOccupiedWidth, width, height, shared);
+}
@@ -9,13 +9,15 @@ fi
 
 repo=$1
 base64=$2
+wasmurl=$3
 
 # Generate the Javascript file
 echo "// LifeViewer WASM definitions"
 echo "// This file is autogenerated during the build process"
 echo ""
 echo "var wasmBase64 = \"`cat ${base64}`\";"
+echo "var wasmURL = \"${wasmurl}\";"
 echo ""
 echo "var WASM = {"
 egrep "(^void|^uint32_t)" ${repo}/wasm/*.c | sed "s/.* /\t/" | sed "s/(/: null,/"
-echo -e "\tmemory: null,\n\tallocator: null\n};"
+echo -e "\tmodule: null,\n\tmemory: null,\n\tallocator: null\n};"
@@ -6,9 +6,15 @@
 //	createNxNColourGrid (N = 2, 4, 8, 16, 32)
 //	createNxNColourGridSuper (N = 2, 4, 8, 16, 32)
 //	renderGridNoClipNoRotate (single layer, square or triangular)
+//	renderGridNoClipNoRotateInteger (single layer, square, integer zoom)
 //	renderGridClipNoRotate (single layer, square or triangular)
 //	renderOverlayNoClipNoRotate (single layer [R]History)
 //	renderOverlayClipNoRotate (single layer [R]History)
+//	renderHexCells (hexagonal cells at polygon zoom)
+//	renderTriangleCells (triangular cells at polygon zoom)
+//	renderIconGrid (RuleLoader icons and Pretty cells)
+//	renderStars (starfield)
+//	updateSnow (snowflake update and draw)
 
 /*
 This file is part of LifeViewer
@@ -1311,6 +1317,175 @@ void renderGridNoClipNoRotate(
 }
 
 
+EMSCRIPTEN_KEEPALIVE
+// render the grid with no clipping or rotation at integer zoom (single layer, square)
+void renderGridNoClipNoRotateInteger(
+	uint8_t *const grid,
+	const uint32_t *const pixelColours,
+	uint32_t *data32,
+	const uint32_t displayWidth,
+	const uint32_t displayHeight,
+	const double camXOff,
+	const double camYOff,
+	const uint32_t widthMask,
+	const uint32_t heightMask,
+	const uint32_t gridWidth,
+	const uint32_t zoom
+) {
+	const double dyx = 1.0f / zoom;
+	double sy = -((double)displayHeight / 2) * dyx + camYOff;
+	const double sx = -((double)displayWidth / 2) * dyx + camXOff;
+
+	// the first cell on each row may be partially visible
+	const uint32_t firstCell = (uint32_t)sx;
+	uint32_t firstRun = (uint32_t)ceil(((double)firstCell + 1 - sx) * zoom);
+
+	if (firstRun < 1) {
+		firstRun = 1;
+	}
+	if (firstRun > zoom) {
+		firstRun = zoom;
+	}
+
+	// split the first 16 pixel colours into byte planes for in-register lookup
+	uint8_t planes[64];
+
+	for (uint32_t i = 0; i < 16; i++) {
+		const uint32_t colour = pixelColours[i];
+
+		planes[i] = colour & 255;
+		planes[i + 16] = (colour >> 8) & 255;
+		planes[i + 32] = (colour >> 16) & 255;
+		planes[i + 48] = colour >> 24;
+	}
+
+	const v128_t plane0 = wasm_v128_load(planes);
+	const v128_t plane1 = wasm_v128_load(planes + 16);
+	const v128_t plane2 = wasm_v128_load(planes + 32);
+	const v128_t plane3 = wasm_v128_load(planes + 48);
+	const v128_t sixteen = wasm_i8x16_splat(16);
+
+	uint32_t colours[16];
+	uint32_t lastGridY = 0xffffffff;
+
+	// process each row
+	for (uint32_t h = 0; h < displayHeight; h++) {
+		const uint32_t gridY = (uint32_t)sy & heightMask;
+
+		// if the row shows the same cells as the previous row then copy it
+		if (gridY == lastGridY) {
+			memcpy(data32, data32 - displayWidth, displayWidth * sizeof(uint32_t));
+		} else {
+			const uint8_t *const gridRow = grid + gridY * gridWidth;
+			uint32_t x = 0;
+			uint32_t cellX = firstCell;
+			uint32_t run = firstRun;
+
+			// process 16 cells at a time
+			while (x < displayWidth) {
+				const uint32_t cellOffset = cellX & widthMask;
+				v128_t c0, c1, c2, c3;
+
+				// check if the 16 cells are contiguous on the grid row
+				if (cellOffset + 16 <= gridWidth) {
+					const v128_t cells = wasm_v128_load(gridRow + cellOffset);
+
+					// check if all cell states fit in the swizzle palette
+					if (wasm_i8x16_all_true(wasm_u8x16_lt(cells, sixteen))) {
+						// lookup each colour byte
+						const v128_t p0 = wasm_i8x16_swizzle(plane0, cells);
+						const v128_t p1 = wasm_i8x16_swizzle(plane1, cells);
+						const v128_t p2 = wasm_i8x16_swizzle(plane2, cells);
+						const v128_t p3 = wasm_i8x16_swizzle(plane3, cells);
+
+						// interleave the byte planes into pixels
+						const v128_t lo01 = wasm_i8x16_shuffle(p0, p1, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+						const v128_t hi01 = wasm_i8x16_shuffle(p0, p1, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+						const v128_t lo23 = wasm_i8x16_shuffle(p2, p3, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+						const v128_t hi23 = wasm_i8x16_shuffle(p2, p3, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+
+						c0 = wasm_i8x16_shuffle(lo01, lo23, 0, 1, 16, 17, 2, 3, 18, 19, 4, 5, 20, 21, 6, 7, 22, 23);
+						c1 = wasm_i8x16_shuffle(lo01, lo23, 8, 9, 24, 25, 10, 11, 26, 27, 12, 13, 28, 29, 14, 15, 30, 31);
+						c2 = wasm_i8x16_shuffle(hi01, hi23, 0, 1, 16, 17, 2, 3, 18, 19, 4, 5, 20, 21, 6, 7, 22, 23);
+						c3 = wasm_i8x16_shuffle(hi01, hi23, 8, 9, 24, 25, 10, 11, 26, 27, 12, 13, 28, 29, 14, 15, 30, 31);
+					} else {
+						// lookup each colour from the full palette
+						for (uint32_t i = 0; i < 16; i++) {
+							colours[i] = pixelColours[gridRow[cellOffset + i]];
+						}
+
+						c0 = wasm_v128_load(colours);
+						c1 = wasm_v128_load(colours + 4);
+						c2 = wasm_v128_load(colours + 8);
+						c3 = wasm_v128_load(colours + 12);
+					}
+				} else {
+					// cells wrap around the grid row
+					for (uint32_t i = 0; i < 16; i++) {
+						colours[i] = pixelColours[gridRow[(cellX + i) & widthMask]];
+					}
+
+					c0 = wasm_v128_load(colours);
+					c1 = wasm_v128_load(colours + 4);
+					c2 = wasm_v128_load(colours + 8);
+					c3 = wasm_v128_load(colours + 12);
+				}
+
+				// check for 1x zoom with a full chunk
+				if (zoom == 1 && x + 16 <= displayWidth) {
+					wasm_v128_store(data32 + x, c0);
+					wasm_v128_store(data32 + x + 4, c1);
+					wasm_v128_store(data32 + x + 8, c2);
+					wasm_v128_store(data32 + x + 12, c3);
+					x += 16;
+				} else {
+					wasm_v128_store(colours, c0);
+					wasm_v128_store(colours + 4, c1);
+					wasm_v128_store(colours + 8, c2);
+					wasm_v128_store(colours + 12, c3);
+
+					// expand each cell to zoom pixels
+					for (uint32_t i = 0; i < 16 && x < displayWidth; i++) {
+						const uint32_t colour = colours[i];
+						const v128_t colour4 = wasm_i32x4_splat(colour);
+						uint32_t n = displayWidth - x;
+
+						if (n > run) {
+							n = run;
+						}
+
+						uint32_t *pixel = data32 + x;
+						x += n;
+
+						while (n >= 4) {
+							wasm_v128_store(pixel, colour4);
+							pixel += 4;
+							n -= 4;
+						}
+
+						while (n > 0) {
+							*pixel++ = colour;
+							n--;
+						}
+
+						run = zoom;
+					}
+				}
+
+				// next 16 cells
+				cellX += 16;
+			}
+
+			lastGridY = gridY;
+		}
+
+		// next row
+		data32 += displayWidth;
+		sy += dyx;
+	}
+}
+
+
 EMSCRIPTEN_KEEPALIVE
 // render the grid with clipping but no rotation (single layer)
 void renderGridClipNoRotate(
@@ -1884,3 +2059,663 @@ void renderOverlayClipNoRotate(
 	}
 }
 
+
+
+// get the display state of a hexagon or triangle cell applying any [R]History overlay
+static inline uint32_t getPolygonCellState(
+	const uint8_t *const colourGrid,
+	const uint8_t *const overlayGrid,
+	const uint32_t offset,
+	const uint32_t aliveStart,
+	const uint32_t state3,
+	const uint32_t state4,
+	const uint32_t state5,
+	const uint32_t state6
+) {
+	uint32_t state = colourGrid[offset];
+
+	if (overlayGrid) {
+		const uint32_t overState = overlayGrid[offset];
+
+		if (overState == state4 || overState == state6) {
+			if (state >= aliveStart) {
+				state = state3;
+			} else {
+				state = overState;
+			}
+		} else {
+			if (overState == state3 || overState == state5) {
+				if (state < aliveStart) {
+					state = state4;
+				} else {
+					state = overState;
+				}
+			}
+		}
+	}
+
+	return state;
+}
+
+
+// draw one scanline of a hexagon or triangle with border pixels outside the inner span
+static inline void drawPolygonSpan(
+	uint32_t *const row,
+	int32_t left,
+	int32_t right,
+	const int32_t innerLeft,
+	const int32_t innerRight,
+	const int32_t displayWidth,
+	const uint32_t fill,
+	const uint32_t border,
+	const uint32_t filled,
+	const uint32_t bordered
+) {
+	// clip to the display
+	if (left < 0) {
+		left = 0;
+	}
+	if (right > displayWidth) {
+		right = displayWidth;
+	}
+
+	int32_t x = left;
+
+	// left border
+	while (x < right && x < innerLeft) {
+		if (bordered) {
+			row[x] = border;
+		} else {
+			if (filled) {
+				row[x] = fill;
+			}
+		}
+		x++;
+	}
+
+	// interior
+	const int32_t end = innerRight < right ? innerRight : right;
+
+	if (filled) {
+		const v128_t fill4 = wasm_i32x4_splat(fill);
+
+		// fill 4 pixels at a time
+		while (x + 4 <= end) {
+			wasm_v128_store(row + x, fill4);
+			x += 4;
+		}
+
+		while (x < end) {
+			row[x] = fill;
+			x++;
+		}
+	} else {
+		if (x < end) {
+			x = end;
+		}
+	}
+
+	// right border
+	while (x < right) {
+		if (bordered) {
+			row[x] = border;
+		} else {
+			if (filled) {
+				row[x] = fill;
+			}
+		}
+		x++;
+	}
+}
+
+
+// get the half width of a hexagon at a given vertical distance from its centre
+static inline double getHexHalfWidth(
+	const double dy,
+	const double halfWidth,
+	const double sideHeight,
+	const double topHeight
+) {
+	if (dy <= sideHeight) {
+		return halfWidth;
+	}
+
+	if (dy >= topHeight) {
+		return 0;
+	}
+
+	return halfWidth * (topHeight - dy) / (topHeight - sideHeight);
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// render hexagonal cells directly into the display buffer (borderMode 0 = none, 1 = cell borders, 2 = grid lines)
+void renderHexCells(
+	const uint8_t *const colourGrid,
+	const uint8_t *const overlayGrid,
+	const uint32_t colourGridWidth,
+	const uint32_t *const pixelColours,
+	uint32_t *const data32,
+	const int32_t displayWidth,
+	const int32_t displayHeight,
+	const int32_t leftX,
+	const int32_t bottomY,
+	const int32_t rightX,
+	const int32_t topY,
+	const int32_t xAdj,
+	const int32_t yAdj,
+	const int32_t maxGridSize,
+	const double xBase,
+	const double yBase,
+	const double xZoom,
+	const double yZoom,
+	const uint32_t aliveStart,
+	const uint32_t state3,
+	const uint32_t state4,
+	const uint32_t state5,
+	const uint32_t state6,
+	const uint32_t boundaryColour,
+	const uint32_t borderColour,
+	const uint32_t borderMode
+) {
+	// hexagon dimensions in pixels
+	const double halfWidth = xZoom / 2;
+	const double topHeight = (1.16 / sqrt(3)) * yZoom;
+	const double sideHeight = topHeight / 2;
+
+	// visible cell rows
+	const int32_t firstY = (int32_t)floor((-topHeight - yBase) / yZoom);
+	const int32_t lastY = (int32_t)ceil((displayHeight + topHeight - yBase) / yZoom);
+
+	for (int32_t y = firstY; y <= lastY; y++) {
+		const double cy = yBase + y * yZoom;
+		const double rowX = xBase - y * xZoom / 2;
+		const int32_t firstX = (int32_t)floor((-halfWidth - rowX) / xZoom);
+		const int32_t lastX = (int32_t)ceil((displayWidth + halfWidth - rowX) / xZoom);
+		const uint32_t rowOnGrid = (y + yAdj >= 0 && y + yAdj < maxGridSize);
+		const uint32_t rowInBox = (y >= bottomY && y <= topY);
+
+		// pixel rows covered by this cell row
+		int32_t py0 = (int32_t)ceil(cy - topHeight - 0.5);
+		int32_t py1 = (int32_t)ceil(cy + topHeight - 0.5);
+
+		if (py0 < 0) {
+			py0 = 0;
+		}
+		if (py1 > displayHeight) {
+			py1 = displayHeight;
+		}
+
+		if (py0 >= py1) {
+			continue;
+		}
+
+		for (int32_t x = firstX; x <= lastX; x++) {
+			uint32_t filled = 0;
+			uint32_t fill = 0;
+
+			// check if the cell is on the grid
+			if (!rowOnGrid || x + xAdj < 0 || x + xAdj >= maxGridSize) {
+				filled = 1;
+				fill = boundaryColour;
+			} else {
+				if (rowInBox && x >= leftX && x <= rightX) {
+					const uint32_t state = getPolygonCellState(colourGrid, overlayGrid, y * colourGridWidth + x, aliveStart, state3, state4, state5, state6);
+					if (state > 0) {
+						filled = 1;
+						fill = pixelColours[state];
+					}
+				}
+			}
+
+			// grid lines are drawn around every cell but cell borders only around filled cells
+			const uint32_t bordered = (borderMode == 2) || (borderMode == 1 && filled);
+
+			if (!(filled || bordered)) {
+				continue;
+			}
+
+			// rasterise the hexagon
+			const double cx = rowX + x * xZoom;
+
+			for (int32_t py = py0; py < py1; py++) {
+				const double dy = fabs(py + 0.5 - cy);
+				const double width = getHexHalfWidth(dy, halfWidth, sideHeight, topHeight);
+
+				if (width <= 0) {
+					continue;
+				}
+
+				// the inner span excludes pixels whose neighbours are outside the hexagon
+				const double inner = getHexHalfWidth(dy + 1, halfWidth, sideHeight, topHeight) - 1;
+				const int32_t left = (int32_t)ceil(cx - width - 0.5);
+				const int32_t right = (int32_t)ceil(cx + width - 0.5);
+				int32_t innerLeft = right;
+				int32_t innerRight = right;
+
+				if (inner > 0) {
+					innerLeft = (int32_t)ceil(cx - inner - 0.5);
+					innerRight = (int32_t)ceil(cx + inner - 0.5);
+				}
+
+				drawPolygonSpan(data32 + py * displayWidth, left, right, innerLeft, innerRight, displayWidth, fill, borderColour, filled, bordered);
+			}
+		}
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// render triangular cells directly into the display buffer (borderMode 0 = none, 1 = cell borders, 2 = grid lines)
+void renderTriangleCells(
+	const uint8_t *const colourGrid,
+	const uint8_t *const overlayGrid,
+	const uint32_t colourGridWidth,
+	const uint32_t *const pixelColours,
+	uint32_t *const data32,
+	const int32_t displayWidth,
+	const int32_t displayHeight,
+	const int32_t leftX,
+	const int32_t bottomY,
+	const int32_t rightX,
+	const int32_t topY,
+	const int32_t xAdj,
+	const int32_t yAdj,
+	const int32_t maxGridSize,
+	const double xBase,
+	const double yBase,
+	const double xZoom,
+	const double yZoom,
+	const uint32_t aliveStart,
+	const uint32_t state3,
+	const uint32_t state4,
+	const uint32_t state5,
+	const uint32_t state6,
+	const uint32_t boundaryColour,
+	const uint32_t borderColour,
+	const uint32_t borderMode
+) {
+	// visible cells (each triangle is two cells wide)
+	const int32_t firstY = (int32_t)floor(-yBase / yZoom);
+	const int32_t lastY = (int32_t)ceil((displayHeight - yBase) / yZoom);
+	const int32_t firstX = (int32_t)floor((-xZoom - xBase) / xZoom);
+	const int32_t lastX = (int32_t)ceil((displayWidth + xZoom - xBase) / xZoom);
+
+	for (int32_t y = firstY; y <= lastY; y++) {
+		const double top = yBase + y * yZoom;
+		const uint32_t rowOnGrid = (y + yAdj >= 0 && y + yAdj < maxGridSize);
+		const uint32_t rowInBox = (y >= bottomY && y <= topY);
+
+		// pixel rows covered by this cell row
+		int32_t py0 = (int32_t)ceil(top - 0.5);
+		int32_t py1 = (int32_t)ceil(top + yZoom - 0.5);
+
+		if (py0 < 0) {
+			py0 = 0;
+		}
+		if (py1 > displayHeight) {
+			py1 = displayHeight;
+		}
+
+		if (py0 >= py1) {
+			continue;
+		}
+
+		for (int32_t x = firstX; x <= lastX; x++) {
+			uint32_t filled = 0;
+			uint32_t fill = 0;
+
+			// check if the cell is on the grid
+			if (!rowOnGrid || x + xAdj < 0 || x + xAdj >= maxGridSize) {
+				filled = 1;
+				fill = boundaryColour;
+			} else {
+				if (rowInBox && x >= leftX && x <= rightX) {
+					const uint32_t state = getPolygonCellState(colourGrid, overlayGrid, y * colourGridWidth + x, aliveStart, state3, state4, state5, state6);
+					if (state > 0) {
+						filled = 1;
+						fill = pixelColours[state];
+					}
+				}
+			}
+
+			// grid lines are drawn around every cell but cell borders only around filled cells
+			const uint32_t bordered = (borderMode == 2) || (borderMode == 1 && filled);
+
+			if (!(filled || bordered)) {
+				continue;
+			}
+
+			// triangles alternate between base at the top and base at the bottom
+			const uint32_t baseAtBottom = (x + y) & 1;
+			const double cx = xBase + x * xZoom;
+
+			// rasterise the triangle
+			for (int32_t py = py0; py < py1; py++) {
+				const double v = py + 0.5 - top;
+				const double apex = baseAtBottom ? v : yZoom - v;
+				const double width = xZoom * apex / yZoom;
+
+				if (width <= 0) {
+					continue;
+				}
+
+				// the inner span excludes pixels whose neighbours are outside the triangle
+				const double inner = (yZoom - apex < 1) ? 0 : xZoom * (apex - 1) / yZoom - 1;
+				const int32_t left = (int32_t)ceil(cx - width - 0.5);
+				const int32_t right = (int32_t)ceil(cx + width - 0.5);
+				int32_t innerLeft = right;
+				int32_t innerRight = right;
+
+				if (inner > 0) {
+					innerLeft = (int32_t)ceil(cx - inner - 0.5);
+					innerRight = (int32_t)ceil(cx + inner - 0.5);
+				}
+
+				drawPolygonSpan(data32 + py * displayWidth, left, right, innerLeft, innerRight, displayWidth, fill, borderColour, filled, bordered);
+			}
+		}
+	}
+}
+
+
+// fill a square cell in an icon grid with a solid colour
+static inline void fillIconGridCell(
+	uint32_t *dest,
+	const uint32_t destWidth,
+	const uint32_t cellSize,
+	const uint32_t colour
+) {
+	const v128_t colour4 = wasm_i32x4_splat(colour);
+
+	for (uint32_t y = 0; y < cellSize; y++) {
+		uint32_t x = 0;
+
+		// fill 4 pixels at a time
+		while (x + 4 <= cellSize) {
+			wasm_v128_store(dest + x, colour4);
+			x += 4;
+		}
+
+		while (x < cellSize) {
+			dest[x] = colour;
+			x++;
+		}
+
+		dest += destWidth;
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// render cells into an icon grid with one cellSize square per cell (states without an icon are drawn as solid squares)
+void renderIconGrid(
+	const uint8_t *const grid,
+	const uint32_t gridWidth,
+	const uint32_t gridHeight,
+	const uint32_t *const pixelColours,
+	const uint32_t *const icons,
+	uint32_t *const dest,
+	const uint32_t destWidth,
+	const int32_t leftX,
+	const int32_t bottomY,
+	const uint32_t width,
+	const uint32_t height,
+	const int32_t xAdj,
+	const int32_t yAdj,
+	const int32_t maxGridSize,
+	const uint32_t cellSize,
+	const uint32_t iconSize,
+	const uint32_t firstIconState,
+	const uint32_t numIcons,
+	const uint32_t iconBorderColour,
+	const uint32_t boundaryColour,
+	const uint32_t boundedBorderState
+) {
+	const uint32_t iconPixels = iconSize * iconSize;
+
+	for (uint32_t j = 0; j < height; j++) {
+		const int32_t y = bottomY + (int32_t)j;
+		const uint32_t rowOnMaxGrid = (y + yAdj >= 0 && y + yAdj < maxGridSize);
+		const uint32_t rowOnGrid = (y >= 0 && y < (int32_t)gridHeight);
+		const uint8_t *const gridRow = grid + (rowOnGrid ? y : 0) * gridWidth;
+		uint32_t *destCell = dest + j * cellSize * destWidth;
+
+		for (uint32_t i = 0; i < width; i++) {
+			const int32_t x = leftX + (int32_t)i;
+
+			// check if the cell is on the maximum grid
+			if (!rowOnMaxGrid || x + xAdj < 0 || x + xAdj >= maxGridSize) {
+				fillIconGridCell(destCell, destWidth, cellSize, boundaryColour);
+			} else {
+				// check if the cell is on the current allocated grid
+				if (!rowOnGrid || x < 0 || x >= (int32_t)gridWidth) {
+					fillIconGridCell(destCell, destWidth, cellSize, pixelColours[0]);
+				} else {
+					const uint32_t state = gridRow[x];
+					const uint32_t icon = state - firstIconState;
+
+					// check if there is an icon for the state
+					if (state == boundedBorderState || state < firstIconState || icon >= numIcons) {
+						fillIconGridCell(destCell, destWidth, cellSize, pixelColours[state]);
+					} else {
+						const uint32_t *src = icons + icon * iconPixels;
+						uint32_t *destRow = destCell;
+
+						// copy the icon adding the right hand border
+						for (uint32_t my = 0; my < iconSize; my++) {
+							memcpy(destRow, src, iconSize * sizeof(uint32_t));
+							for (uint32_t mx = iconSize; mx < cellSize; mx++) {
+								destRow[mx] = iconBorderColour;
+							}
+							src += iconSize;
+							destRow += destWidth;
+						}
+
+						// add the bottom border
+						for (uint32_t my = iconSize; my < cellSize; my++) {
+							for (uint32_t mx = 0; mx < cellSize; mx++) {
+								destRow[mx] = iconBorderColour;
+							}
+							destRow += destWidth;
+						}
+					}
+				}
+			}
+
+			// next cell
+			destCell += cellSize;
+		}
+	}
+}
+
+EMSCRIPTEN_KEEPALIVE
+// draw the starfield into the display buffer (only pixels that are the background colour are drawn)
+void renderStars(
+	const float *const starX,
+	const float *const starY,
+	const float *const starZ,
+	const uint32_t numStars,
+	const float *const sinTable,
+	const float *const cosTable,
+	const uint32_t circleDegrees,
+	const uint32_t degreeParts,
+	uint32_t *const data32,
+	const uint32_t displayWidth,
+	const uint32_t displayHeight,
+	const double xOff,
+	const double yOff,
+	const double zOff,
+	const double angle,
+	const uint32_t blackPixel,
+	const uint32_t starColour
+) {
+	const int32_t halfWidth = displayWidth >> 1;
+	const int32_t halfHeight = displayHeight >> 1;
+	const int32_t widthMinus1 = displayWidth - 1;
+	const int32_t heightMinus1 = displayHeight - 1;
+	const double radToDeg = (circleDegrees / 2) / M_PI;
+
+	// r g b components of the background colour
+	const double blackRed = blackPixel & 0xff;
+	const double blackGreen = (blackPixel >> 8) & 0xff;
+	const double blackBlue = (blackPixel >> 16) & 0xff;
+
+	// difference between the star and background components
+	const double starMinusBlackRed = (double)(starColour & 0xff) - blackRed;
+	const double starMinusBlackGreen = (double)((starColour >> 8) & 0xff) - blackGreen;
+	const double starMinusBlackBlue = (double)((starColour >> 16) & 0xff) - blackBlue;
+
+	for (uint32_t i = 0; i < numStars; i++) {
+		// get 2d part of 3d position
+		double x = starX[i] + xOff;
+		double y = starY[i] + yOff;
+
+		// check if angle is non zero
+		if (angle != 0) {
+			// compute radius
+			const double radius = sqrt((x * x) + (y * y));
+
+			// apply current rotation
+			double theta = atan2(y, x) * radToDeg + angle;
+
+			// check it is in range
+			if (theta < 0) {
+				theta += circleDegrees;
+			} else {
+				if (theta >= circleDegrees) {
+					theta -= circleDegrees;
+				}
+			}
+
+			// convert to part degrees and compute rotated position
+			const int32_t part = (int32_t)(theta * degreeParts);
+			x = radius * cosTable[part];
+			y = radius * sinTable[part];
+		}
+
+		// create the 2D position
+		double zDist = (starZ[i] / zOff) * 2;
+		const int32_t px = (int32_t)(halfWidth + (x / zDist));
+		const int32_t py = (int32_t)(halfHeight + (y / zDist));
+
+		// check if on display (including the halo)
+		if (px > 0 && px < widthMinus1 && py > 0 && py < heightMinus1) {
+			uint32_t *const pixel = data32 + px + py * displayWidth;
+
+			// use the z distance for pixel brightness
+			int32_t bright = (int32_t)(1536 / zDist);
+			if (bright > 255) {
+				bright = 255;
+			}
+			double level = bright / 255.0;
+
+			// draw the star center
+			if (*pixel == blackPixel) {
+				*pixel = 0xff000000
+					| ((uint32_t)(int32_t)(blackBlue + starMinusBlackBlue * level) << 16)
+					| ((uint32_t)(int32_t)(blackGreen + starMinusBlackGreen * level) << 8)
+					| (uint32_t)(int32_t)(blackRed + starMinusBlackRed * level);
+			}
+
+			// compute the dimmer colour for the halo
+			level /= 2;
+			const uint32_t haloColour = 0xff000000
+				| ((uint32_t)(int32_t)(blackBlue + starMinusBlackBlue * level) << 16)
+				| ((uint32_t)(int32_t)(blackGreen + starMinusBlackGreen * level) << 8)
+				| (uint32_t)(int32_t)(blackRed + starMinusBlackRed * level);
+
+			// draw left, right, top and bottom halo
+			if (pixel[-1] == blackPixel) {
+				pixel[-1] = haloColour;
+			}
+			if (pixel[1] == blackPixel) {
+				pixel[1] = haloColour;
+			}
+			if (pixel[-(int32_t)displayWidth] == blackPixel) {
+				pixel[-(int32_t)displayWidth] = haloColour;
+			}
+			if (pixel[displayWidth] == blackPixel) {
+				pixel[displayWidth] = haloColour;
+			}
+		}
+	}
+}
+
+EMSCRIPTEN_KEEPALIVE
+// update and draw snowflakes returning the number of flakes added to the revive list
+uint32_t updateSnow(
+	uint16_t *const snowX,
+	float *const snowY,
+	const float *const snowDY,
+	uint32_t *const snowRevive,
+	const uint32_t numFlakes,
+	uint32_t *const data32,
+	const uint32_t displayWidth,
+	const uint32_t displayHeight,
+	const uint32_t bg,
+	const uint32_t snowColour,
+	const double yScale,
+	const uint32_t seed
+) {
+	const int32_t wd = displayWidth;
+	const double htMinus1 = (double)displayHeight - 1;
+	uint32_t state = seed | 1;
+	uint32_t numRevive = 0;
+
+	for (uint32_t i = 0; i < numFlakes; i++) {
+		const int32_t lastX = snowX[i];
+		const double lastY = snowY[i];
+		const double dirY = snowDY[i] * yScale;
+		int32_t newX = lastX;
+		double newY = lastY;
+
+		// check if the flake is on screen
+		if (lastX >= wd) {
+			// flake is outside a narrowed display so let it fall to be revived
+			newY = lastY + dirY;
+		} else if (lastY >= 0 && lastY < htMinus1) {
+			const int32_t lastRow = (int32_t)lastY;
+			const int32_t nextRow = (int32_t)(lastY + dirY);
+
+			// check if the delta moves the flake a pixel down
+			if (lastRow == nextRow) {
+				newY = lastY + dirY;
+			} else {
+				// check if the space below is free
+				if (nextRow < (int32_t)displayHeight && data32[nextRow * wd + lastX] == bg) {
+					newY = lastY + dirY;
+				} else {
+					// space not free so check bottom left or bottom right (5% chance)
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					if (state < 214748365) {
+						const int32_t dx = (state < 107374182) ? -1 : 1;
+						if (lastX + dx >= 0 && lastX + dx < wd && nextRow < (int32_t)displayHeight) {
+							if (data32[nextRow * wd + lastX + dx] == bg && data32[lastRow * wd + lastX + dx] == bg) {
+								newX = lastX + dx;
+								newY = lastY + dirY;
+							}
+						}
+					}
+				}
+			}
+
+			// draw the flake at the new position
+			data32[(int32_t)newY * wd + newX] = snowColour;
+		} else if (lastY < 0) {
+			// flake is above the screen so move it down
+			newY = lastY + dirY;
+		}
+
+		// if the flake is off the bottom then add to revive list
+		if (newY >= htMinus1) {
+			snowRevive[numRevive++] = i;
+		}
+		snowX[i] = (uint16_t)newX;
+		snowY[i] = (float)newY;
+	}
+
+	return numRevive;
+}
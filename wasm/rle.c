@@ -0,0 +1,437 @@
+// LifeViewer WebAssembly functions
+// Faster versions of LifeViewer functions implemented using WebAssembly SIMD Intrinstics
+// See: https://emscripten.org/docs/porting/simd.html#webassembly-simd-intrinsics
+//
+// RLE
+//	scanRLE
+//	decodeRLECells
+//	encodeRLE
+
+/*
+This file is part of LifeViewer
+ Copyright (C) 2015-2025 Chris Rowett
+
+ LifeViewer is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <wasm_simd128.h>
+#include <emscripten.h>
+
+// scan result codes
+#define RLE_OK 0
+#define RLE_INCOMPLETE 1
+#define RLE_LEADING_ZERO 2
+#define RLE_ILLEGAL_WHITESPACE 3
+#define RLE_ILLEGAL_CHARACTER 4
+
+// state returned for characters that are not cells
+#define RLE_NOT_CELL 0xffffffff
+
+// largest run count kept (larger counts just make the pattern too big)
+#define RLE_MAX_RUN 100000000000ULL
+
+
+// decode the cell state at the given position (and whether a second character was used)
+// returns RLE_NOT_CELL if the character is not a cell
+static inline uint32_t rleState(
+	const uint16_t current,
+	const uint16_t next,
+	uint32_t *const used,
+	uint32_t *const niemiec
+) {
+	uint32_t state = RLE_NOT_CELL;
+
+	*used = 1;
+
+	switch (current) {
+	case 'b':
+	case '.':
+		state = 0;
+		break;
+
+	case 'o':
+		state = 1;
+		break;
+
+	case 'z':
+		// Niemiec z cell maps to [R]Super state 19
+		state = 19;
+		*niemiec = 1;
+		break;
+
+	default:
+		if (current >= 'A' && current <= 'X') {
+			// single digit extended state
+			state = current - 'A' + 1;
+		} else if (current >= 'p' && current < 'y') {
+			if (next >= 'A' && next <= 'X') {
+				// dual digit extended state
+				state = (current - 'p' + 1) * 24 + (next - 'A' + 1);
+				*used = 2;
+			} else if (current == 'x') {
+				// Niemiec x cell maps to [R]Super state 15
+				state = 15;
+				*niemiec = 1;
+			}
+		} else if (current == 'y') {
+			if (next >= 'A' && next <= 'O') {
+				// dual digit extended state
+				state = (current - 'p' + 1) * 24 + (next - 'A' + 1);
+				*used = 2;
+			} else {
+				// Niemiec y cell maps to [R]Super state 17
+				state = 17;
+				*niemiec = 1;
+			}
+		}
+		break;
+	}
+
+	return state;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// scan an RLE bitmap to size it, count states and validate it
+// input is the bitmap up to and including the terminating !
+// result is: index after the bitmap, width, height, maximum state read + 1, Niemiec flag, number of new states used, illegal character
+uint32_t scanRLE(
+	const uint16_t *const input,
+	const uint32_t length,
+	uint32_t *const stateCount,
+	uint32_t *const result
+) {
+	uint32_t index = 0;
+	uint32_t code = RLE_INCOMPLETE;
+	uint32_t state = 0;
+	uint32_t used = 0;
+	uint32_t niemiec = 0;
+	uint32_t maxState = 0;
+	uint32_t newStates = 0;
+	uint64_t runCount = 0;
+	uint64_t x = 0;
+	uint64_t y = 0;
+	uint64_t width = 0;
+	uint16_t current = 0;
+	uint16_t next = 0;
+
+	while (index < length && code == RLE_INCOMPLETE) {
+		current = input[index];
+		next = index + 1 < length ? input[index + 1] : 0;
+		state = RLE_NOT_CELL;
+
+		if (current >= '0' && current <= '9') {
+			// check for leading zero
+			if (current == '0' && runCount == 0) {
+				code = RLE_LEADING_ZERO;
+			}
+			if (runCount < RLE_MAX_RUN) {
+				runCount = runCount * 10 + (current - '0');
+			}
+		} else if (current == '#') {
+			// skip comment to end of line
+			while (index < length && input[index] != '\n') {
+				index++;
+			}
+			if (index == length) {
+				// comment ran past the end of the input
+				break;
+			}
+		} else if (current == '$' || current == '!') {
+			// move down the required number of rows
+			y += runCount == 0 ? 1 : runCount;
+			runCount = 0;
+			if (x > width) {
+				width = x;
+			}
+			x = 0;
+			if (current == '!') {
+				code = RLE_OK;
+			}
+		} else if (current == ' ' || current == '\t' || current == '\r' || current == '\n') {
+			// whitespace is allowed unless a count is in progress
+			if (runCount != 0) {
+				code = RLE_ILLEGAL_WHITESPACE;
+			}
+		} else {
+			state = rleState(current, next, &used, &niemiec);
+			if (state == RLE_NOT_CELL) {
+				code = RLE_ILLEGAL_CHARACTER;
+				result[6] = current;
+			} else {
+				index += used - 1;
+			}
+		}
+
+		// check whether a cell was detected
+		if (state != RLE_NOT_CELL) {
+			if (runCount == 0) {
+				runCount = 1;
+			}
+
+			// count the cells in this state
+			if (stateCount[state] == 0) {
+				newStates++;
+			}
+			stateCount[state] += (uint32_t)runCount;
+			if (state + 1 > maxState) {
+				maxState = state + 1;
+			}
+			x += runCount;
+			runCount = 0;
+		}
+
+		index++;
+	}
+
+	// save the results (sizes are clamped since they will be too big anyway)
+	result[0] = index;
+	result[1] = width > 0xffffffff ? 0xffffffff : (uint32_t)width;
+	result[2] = y > 0xffffffff ? 0xffffffff : (uint32_t)y;
+	result[3] = maxState;
+	result[4] = niemiec;
+	result[5] = newStates;
+
+	return code;
+}
+
+
+// set a run of bits in a bit grid row (most significant bit first)
+static inline void setBitRun(
+	uint16_t *const row,
+	uint32_t x,
+	const uint32_t end
+) {
+	// partial first word
+	while (x < end && (x & 15) != 0) {
+		row[x >> 4] |= 1 << (~x & 15);
+		x++;
+	}
+
+	// whole words
+	while (x + 16 <= end) {
+		row[x >> 4] = 0xffff;
+		x += 16;
+	}
+
+	// partial last word
+	while (x < end) {
+		row[x >> 4] |= 1 << (~x & 15);
+		x++;
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// decode a scanned RLE bitmap into a bit grid and a state grid
+// stateMode is 0 to keep states, 1 for 2 state LtL or HROT (state 1 maps to aliveStart), or 2 to map states beyond numStates to 1
+// bits are set for state 1 if oneBit is set and for odd states if oddBits is set
+void decodeRLECells(
+	const uint16_t *const input,
+	const uint32_t length,
+	uint16_t *const lifeMap,
+	const uint32_t lifeMapWidth,
+	uint8_t *const stateMap,
+	const uint32_t width,
+	const uint32_t stateMode,
+	const uint32_t numStates,
+	const uint32_t aliveStart,
+	const uint32_t oneBit,
+	const uint32_t oddBits
+) {
+	uint32_t index = 0;
+	uint32_t state = 0;
+	uint32_t value = 0;
+	uint32_t used = 0;
+	uint32_t niemiec = 0;
+	uint32_t runCount = 0;
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint8_t *stateRow = stateMap;
+	uint16_t *lifeMapRow = lifeMap;
+	uint16_t current = 0;
+	uint16_t next = 0;
+
+	while (index < length) {
+		current = input[index];
+		next = index + 1 < length ? input[index + 1] : 0;
+
+		if (current >= '0' && current <= '9') {
+			runCount = runCount * 10 + (current - '0');
+		} else if (current == '#') {
+			// skip comment to end of line
+			while (index < length && input[index] != '\n') {
+				index++;
+			}
+		} else if (current == '$') {
+			// move down the required number of rows
+			y += runCount == 0 ? 1 : runCount;
+			runCount = 0;
+			x = 0;
+			stateRow = stateMap + y * width;
+			lifeMapRow = lifeMap + y * lifeMapWidth;
+		} else if (current == '!') {
+			break;
+		} else if (!(current == ' ' || current == '\t' || current == '\r' || current == '\n')) {
+			state = rleState(current, next, &used, &niemiec);
+			index += used - 1;
+			if (runCount == 0) {
+				runCount = 1;
+			}
+
+			if (state > 0) {
+				// map the state
+				value = state;
+				if (stateMode == 1) {
+					value = state == 1 ? aliveStart : 0;
+				} else if (stateMode == 2 && state >= numStates) {
+					value = 1;
+				}
+				memset(stateRow + x, value, runCount);
+
+				// update bit grid for state 1 or odd states as required
+				if ((oneBit && state == 1) || (oddBits && (state & 1))) {
+					setBitRun(lifeMapRow, x, x + runCount);
+				}
+			}
+			x += runCount;
+			runCount = 0;
+		}
+
+		index++;
+	}
+}
+
+
+// write a decimal count
+static inline uint32_t writeCount(
+	uint8_t *const output,
+	uint32_t o,
+	uint32_t count
+) {
+	uint8_t digits[10];
+	uint32_t n = 0;
+
+	while (count > 0) {
+		digits[n++] = '0' + (count % 10);
+		count /= 10;
+	}
+	while (n > 0) {
+		output[o++] = digits[--n];
+	}
+
+	return o;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// encode a rectangle of a grid as an RLE bitmap (without header or terminating !)
+// if useColour is set the grid is a colour grid and cells are alive if above deadStart and not the border colour
+// otherwise the grid holds states
+// codes holds the one or two output characters for each state (second in the high byte)
+// output must have room for 2 bytes per cell and row plus newlines
+uint32_t encodeRLE(
+	const uint8_t *const grid,
+	const uint32_t gridWidth,
+	const uint32_t leftX,
+	const uint32_t bottomY,
+	const uint32_t width,
+	const uint32_t height,
+	const uint32_t useColour,
+	const uint32_t deadStart,
+	const uint32_t borderColour,
+	const uint16_t *const codes,
+	const uint32_t blanks,
+	const uint32_t wrap,
+	uint8_t *const output
+) {
+	const uint32_t charsPerRow = 69;
+	uint32_t o = 0;
+	uint32_t lineStart = 0;
+	uint32_t rowCount = 0;
+	uint32_t count = 0;
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t cell = 0;
+	uint32_t code = 0;
+	int32_t state = 0;
+	int32_t last = 0;
+	const uint8_t *row = NULL;
+
+	for (y = 0; y < height; y++) {
+		row = grid + (bottomY + y) * gridWidth + leftX;
+		cell = row[0];
+		if (useColour) {
+			last = (cell <= deadStart || cell == borderColour) ? 0 : 1;
+		} else {
+			last = cell;
+		}
+		count = 1;
+
+		for (x = 1; x <= width; x++) {
+			if (x == width) {
+				state = -1;
+			} else {
+				cell = row[x];
+				if (useColour) {
+					state = (cell <= deadStart || cell == borderColour) ? 0 : 1;
+				} else {
+					state = cell;
+				}
+			}
+
+			if (state != last) {
+				// output end of previous row(s)
+				if ((!(state == -1 && last == 0) || blanks) && rowCount > 0) {
+					if (rowCount > 1) {
+						o = writeCount(output, o, rowCount);
+					}
+					output[o++] = '$';
+					if (wrap && o - lineStart >= charsPerRow) {
+						output[o++] = '\n';
+						lineStart = o;
+					}
+					rowCount = 0;
+				}
+
+				// output the run unless it is trailing dead cells
+				if (last > 0 || blanks || x < width) {
+					if (count > 1) {
+						o = writeCount(output, o, count);
+					}
+					code = codes[last];
+					output[o++] = code & 255;
+					if (code >> 8) {
+						output[o++] = code >> 8;
+					}
+				}
+				if (wrap && o - lineStart >= charsPerRow) {
+					output[o++] = '\n';
+					lineStart = o;
+				}
+				count = 1;
+				last = state;
+			} else {
+				count++;
+			}
+		}
+
+		// end of row
+		rowCount++;
+	}
+
+	return o;
+}
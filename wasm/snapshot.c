@@ -0,0 +1,362 @@
+// LifeViewer WebAssembly functions
+// Faster versions of LifeViewer functions implemented using WebAssembly SIMD Intrinstics
+// See: https://emscripten.org/docs/porting/simd.html#webassembly-simd-intrinsics
+//
+// Snapshot
+//	packSnapshotData
+//	unpackSnapshotData
+//	saveGridTiles
+//	restoreGridTiles
+//	saveColourGridTiles
+//	restoreColourGridTiles
+
+/*
+This file is part of LifeViewer
+ Copyright (C) 2015-2025 Chris Rowett
+
+ LifeViewer is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <wasm_simd128.h>
+#include <emscripten.h>
+
+
+// xor data with a base buffer
+static inline void xorWithBase(
+	uint32_t *const data,
+	const uint32_t *const base,
+	const uint32_t length
+) {
+	uint32_t i = 0;
+
+	// 4 words at a time
+	while (i + 4 <= length) {
+		wasm_v128_store(data + i, wasm_v128_xor(wasm_v128_load(data + i), wasm_v128_load(base + i)));
+		i += 4;
+	}
+
+	// remaining words
+	while (i < length) {
+		data[i] ^= base[i];
+		i++;
+	}
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// xor snapshot data with an optional base and then zero run length encode it
+// output is a list of records: zero run length, literal count, literals
+// (output must have room for length + 2 words, input is overwritten)
+uint32_t packSnapshotData(
+	uint32_t *const input,
+	const uint32_t length,
+	const uint32_t *const base,
+	const uint32_t useBase,
+	uint32_t *const output
+) {
+	uint32_t i = 0;
+	uint32_t o = 0;
+	uint32_t start = 0;
+	uint32_t literals = 0;
+
+	// delta against the base if specified
+	if (useBase) {
+		xorWithBase(input, base, length);
+	}
+
+	while (i < length) {
+		// skip zeros 4 at a time
+		start = i;
+		while (i + 4 <= length && !wasm_v128_any_true(wasm_v128_load(input + i))) {
+			i += 4;
+		}
+		while (i < length && input[i] == 0) {
+			i++;
+		}
+		output[o++] = i - start;
+
+		// literals continue until a run of at least 3 zeros
+		start = i;
+		while (i < length && !(input[i] == 0 && i + 2 < length && input[i + 1] == 0 && input[i + 2] == 0)) {
+			i++;
+		}
+		literals = i - start;
+		output[o++] = literals;
+		memcpy(output + o, input + start, literals << 2);
+		o += literals;
+	}
+
+	// return the packed length
+	return o;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// decode zero run length encoded snapshot data and xor with an optional base
+uint32_t unpackSnapshotData(
+	const uint32_t *const input,
+	const uint32_t inputLength,
+	const uint32_t *const base,
+	const uint32_t useBase,
+	uint32_t *const output,
+	const uint32_t length
+) {
+	uint32_t i = 0;
+	uint32_t o = 0;
+	uint32_t zeros = 0;
+	uint32_t literals = 0;
+
+	while (i < inputLength && o < length) {
+		zeros = input[i++];
+		literals = input[i++];
+
+		// expand the zero run
+		memset(output + o, 0, zeros << 2);
+		o += zeros;
+
+		// copy the literals
+		memcpy(output + o, input + i, literals << 2);
+		i += literals;
+		o += literals;
+	}
+
+	// undo the delta against the base if specified
+	if (useBase) {
+		xorWithBase(output, base, length);
+	}
+
+	// return the unpacked length
+	return o;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// gather the occupied 16x16 tiles of the bit grid into the rows of a snapshot buffer (2 rows per word)
+uint32_t saveGridTiles(
+	const uint16_t *const grid16,
+	const uint32_t grid16Width,
+	const uint16_t *const tileGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileRows,
+	uint32_t *const *const bufferRows,
+	const uint32_t rowWords
+) {
+	uint32_t total = 0;
+	uint32_t o = 0;
+	uint32_t rowIndex = 0;
+	uint32_t *buffer = bufferRows[0];
+	uint32_t th = 0;
+	uint32_t tx = 0;
+	uint32_t tiles = 0;
+	uint32_t b = 0;
+	uint32_t r = 0;
+	const uint16_t *tileRow = tileGrid;
+	const uint16_t *src = NULL;
+
+	for (th = 0; th < tileRows; th++) {
+		for (tx = 0; tx < tileGridWidth; tx++) {
+			tiles = tileRow[tx];
+
+			// process tiles from the most significant bit (leftmost tile)
+			while (tiles) {
+				b = 31 - __builtin_clz(tiles);
+				tiles &= ~(1 << b);
+				src = grid16 + (th << 4) * grid16Width + (tx << 4) + (15 - b);
+
+				// tiles never straddle buffer rows so move to the next row when this one is full
+				if (o == rowWords) {
+					rowIndex++;
+					buffer = bufferRows[rowIndex];
+					o = 0;
+				}
+				for (r = 0; r < 16; r += 2) {
+					buffer[o++] = ((uint32_t)src[r * grid16Width] << 16) | src[(r + 1) * grid16Width];
+				}
+				total += 8;
+			}
+		}
+		tileRow += tileGridWidth;
+	}
+
+	// return the number of words written
+	return total;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// scatter the occupied 16x16 tiles of the bit grid from the rows of a snapshot buffer
+uint32_t restoreGridTiles(
+	uint16_t *const grid16,
+	const uint32_t grid16Width,
+	const uint16_t *const tileGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileRows,
+	const uint32_t *const *const bufferRows,
+	const uint32_t rowWords
+) {
+	uint32_t total = 0;
+	uint32_t i = 0;
+	uint32_t rowIndex = 0;
+	const uint32_t *buffer = bufferRows[0];
+	uint32_t th = 0;
+	uint32_t tx = 0;
+	uint32_t tiles = 0;
+	uint32_t b = 0;
+	uint32_t r = 0;
+	uint32_t value = 0;
+	const uint16_t *tileRow = tileGrid;
+	uint16_t *dest = NULL;
+
+	for (th = 0; th < tileRows; th++) {
+		for (tx = 0; tx < tileGridWidth; tx++) {
+			tiles = tileRow[tx];
+
+			// process tiles from the most significant bit (leftmost tile)
+			while (tiles) {
+				b = 31 - __builtin_clz(tiles);
+				tiles &= ~(1 << b);
+				dest = grid16 + (th << 4) * grid16Width + (tx << 4) + (15 - b);
+
+				// tiles never straddle buffer rows so move to the next row when this one is used
+				if (i == rowWords) {
+					rowIndex++;
+					buffer = bufferRows[rowIndex];
+					i = 0;
+				}
+				for (r = 0; r < 16; r += 2) {
+					value = buffer[i++];
+					dest[r * grid16Width] = value >> 16;
+					dest[(r + 1) * grid16Width] = value & 65535;
+				}
+				total += 8;
+			}
+		}
+		tileRow += tileGridWidth;
+	}
+
+	// return the number of words read
+	return total;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// gather the occupied 16x16 tiles of a colour grid into the rows of a snapshot buffer (one v128 per tile row)
+uint32_t saveColourGridTiles(
+	const uint8_t *const colourGrid,
+	const uint32_t colourGridWidth,
+	const uint16_t *const tileGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileRows,
+	uint32_t *const *const bufferRows,
+	const uint32_t rowWords
+) {
+	uint32_t total = 0;
+	uint32_t o = 0;
+	uint32_t rowIndex = 0;
+	uint32_t *buffer = bufferRows[0];
+	uint32_t th = 0;
+	uint32_t tx = 0;
+	uint32_t tiles = 0;
+	uint32_t b = 0;
+	uint32_t r = 0;
+	const uint16_t *tileRow = tileGrid;
+	const uint8_t *src = NULL;
+
+	for (th = 0; th < tileRows; th++) {
+		for (tx = 0; tx < tileGridWidth; tx++) {
+			tiles = tileRow[tx];
+
+			// process tiles from the most significant bit (leftmost tile)
+			while (tiles) {
+				b = 31 - __builtin_clz(tiles);
+				tiles &= ~(1 << b);
+				src = colourGrid + (th << 4) * colourGridWidth + (((tx << 4) + (15 - b)) << 4);
+
+				// tiles never straddle buffer rows so move to the next row when this one is full
+				if (o == rowWords) {
+					rowIndex++;
+					buffer = bufferRows[rowIndex];
+					o = 0;
+				}
+				for (r = 0; r < 16; r++) {
+					wasm_v128_store(buffer + o, wasm_v128_load(src));
+					src += colourGridWidth;
+					o += 4;
+				}
+				total += 64;
+			}
+		}
+		tileRow += tileGridWidth;
+	}
+
+	// return the number of words written
+	return total;
+}
+
+
+EMSCRIPTEN_KEEPALIVE
+// scatter the occupied 16x16 tiles of a colour grid from the rows of a snapshot buffer (one v128 per tile row)
+uint32_t restoreColourGridTiles(
+	uint8_t *const colourGrid,
+	const uint32_t colourGridWidth,
+	const uint16_t *const tileGrid,
+	const uint32_t tileGridWidth,
+	const uint32_t tileRows,
+	const uint32_t *const *const bufferRows,
+	const uint32_t rowWords
+) {
+	uint32_t total = 0;
+	uint32_t i = 0;
+	uint32_t rowIndex = 0;
+	const uint32_t *buffer = bufferRows[0];
+	uint32_t th = 0;
+	uint32_t tx = 0;
+	uint32_t tiles = 0;
+	uint32_t b = 0;
+	uint32_t r = 0;
+	const uint16_t *tileRow = tileGrid;
+	uint8_t *dest = NULL;
+
+	for (th = 0; th < tileRows; th++) {
+		for (tx = 0; tx < tileGridWidth; tx++) {
+			tiles = tileRow[tx];
+
+			// process tiles from the most significant bit (leftmost tile)
+			while (tiles) {
+				b = 31 - __builtin_clz(tiles);
+				tiles &= ~(1 << b);
+				dest = colourGrid + (th << 4) * colourGridWidth + (((tx << 4) + (15 - b)) << 4);
+
+				// tiles never straddle buffer rows so move to the next row when this one is used
+				if (i == rowWords) {
+					rowIndex++;
+					buffer = bufferRows[rowIndex];
+					i = 0;
+				}
+				for (r = 0; r < 16; r++) {
+					wasm_v128_store(dest, wasm_v128_load(buffer + i));
+					dest += colourGridWidth;
+					i += 4;
+				}
+				total += 64;
+			}
+		}
+		tileRow += tileGridWidth;
+	}
+
+	// return the number of words read
+	return total;
+}